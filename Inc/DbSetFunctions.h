@@ -27,6 +27,30 @@ void setStage3Parameters(uint8_t* data);
 void setBmsParameters(uint8_t* data);
 void setResParameters(uint8_t* data);
 
+/* ==========================  Routing Table =============================== */
+/*
+ * One X(id, handler) entry per database message. Expanded by hash_SetTable()
+ * and by the const static routing table in hashtable.c - edit here only.
+ * Each handler may appear once; IDs must be unique 11-bit standard IDs.
+ */
+#define DB_CAN_ROUTE_TABLE(X)                   \
+    X(INV1_AV1_ID, setInv1Av1Parameters)        \
+    X(INV1_AV2_ID, setInv1Av2Parameters)        \
+    X(INV2_AV1_ID, setInv2Av1Parameters)        \
+    X(INV2_AV2_ID, setInv2Av2Parameters)        \
+    X(INV3_AV1_ID, setInv3Av1Parameters)        \
+    X(INV3_AV2_ID, setInv3Av2Parameters)        \
+    X(INV4_AV1_ID, setInv4Av1Parameters)        \
+    X(INV4_AV2_ID, setInv4Av2Parameters)        \
+    X(STAGE_0_ID,  setStage0Parameters)         \
+    X(STAGE_1_ID,  setStage1Parameters)         \
+    X(STAGE_2_ID,  setStage2Parameters)         \
+    X(STAGE_3_ID,  setStage3Parameters)         \
+    X(BMS_ID,      setBmsParameters)            \
+    X(RES_ID,      setResParameters)            \
+    X(PEDAL_ID,    setPedalParameters)          \
+    X(DB_ID,       setDBParameters)
+
 /* ==========================  Defines =============================== */
 #define MAX_VALUE_APPS 100
 #define MIN_VALUE_APPS  0
@@ -0,0 +1,65 @@
+/*
+ * Generated by scripts/dbc_to_db.py from scripts/vcu.dbc - do not edit.
+ * Signal tables for db_DecodeFrame(); included by DbSetFunctions.c only.
+ */
+
+#ifndef DBSIGNALS_H
+#define DBSIGNALS_H
+
+#include "database.h"
+
+static const db_signal_t db_sig_DASHBOARD[] = {
+    DB_SIG(dashboard_node_t, R2D, 16, 8, DB_SIG_LATCH, DB_UNIT_MESSAGE, 0, 0),
+};
+
+static const db_signal_t db_sig_INV1_AV1[] = {
+    DB_SIG(inverter_t, AMK_Status.AMK_bReserve, 0, 8, DB_SIG_CONST, DB_UNIT_MESSAGE, 0xBB, 0),
+    DB_SIG(inverter_t, AMK_Status.AMK_bits, 8, 8, 0, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, actual_speed, 16, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, torque_current, 32, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, magnetizing_current, 48, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+};
+
+static const db_signal_t db_sig_INV1_AV2[] = {
+    DB_SIG(inverter_t, motor_temperature, 0, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, plate_temperature, 16, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(vcu_node_t, error_group.inv1_error, 32, 16, 0, DB_NODE_VCU, 0, 0),
+};
+
+static const db_signal_t db_sig_INV2_AV2[] = {
+    DB_SIG(inverter_t, motor_temperature, 0, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, plate_temperature, 16, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(vcu_node_t, error_group.inv2_error, 32, 16, 0, DB_NODE_VCU, 0, 0),
+};
+
+static const db_signal_t db_sig_INV3_AV2[] = {
+    DB_SIG(inverter_t, motor_temperature, 0, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, plate_temperature, 16, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(vcu_node_t, error_group.inv3_error, 32, 16, 0, DB_NODE_VCU, 0, 0),
+};
+
+static const db_signal_t db_sig_INV4_AV2[] = {
+    DB_SIG(inverter_t, motor_temperature, 0, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(inverter_t, plate_temperature, 16, 16, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+    DB_SIG(vcu_node_t, error_group.inv4_error, 32, 16, 0, DB_NODE_VCU, 0, 0),
+};
+
+static const db_signal_t db_sig_PEDAL[] = {
+    DB_SIG(pedal_node_t, gas_value, 0, 16, DB_SIG_CLAMP, DB_UNIT_MESSAGE, 0, 100),
+    DB_SIG(pedal_node_t, brake_value, 16, 16, DB_SIG_CLAMP, DB_UNIT_MESSAGE, 0, 100),
+    DB_SIG(pedal_node_t, steering_wheel_angle, 32, 16, DB_SIG_SIGNED | DB_SIG_CLAMP, DB_UNIT_MESSAGE, -100, 100),
+    DB_SIG(pedal_node_t, BIOPS, 48, 16, DB_SIG_CLAMP, DB_UNIT_MESSAGE, 0, 100),
+};
+
+static const db_message_t db_msg_DASHBOARD = {db_sig_DASHBOARD, 1, DB_NODE_DASHBOARD, DBNODE}; // 0x194
+static const db_message_t db_msg_INV1_AV1 = {db_sig_INV1_AV1, 5, DB_NODE_INV1, INV1}; // 0x283
+static const db_message_t db_msg_INV1_AV2 = {db_sig_INV1_AV2, 3, DB_NODE_INV1, INV1}; // 0x285
+static const db_message_t db_msg_INV2_AV1 = {db_sig_INV1_AV1, 5, DB_NODE_INV2, INV2}; // 0x284
+static const db_message_t db_msg_INV2_AV2 = {db_sig_INV2_AV2, 3, DB_NODE_INV2, INV2}; // 0x286
+static const db_message_t db_msg_INV3_AV1 = {db_sig_INV1_AV1, 5, DB_NODE_INV3, INV3}; // 0x287
+static const db_message_t db_msg_INV3_AV2 = {db_sig_INV3_AV2, 3, DB_NODE_INV3, INV3}; // 0x289
+static const db_message_t db_msg_INV4_AV1 = {db_sig_INV1_AV1, 5, DB_NODE_INV4, INV4}; // 0x288
+static const db_message_t db_msg_INV4_AV2 = {db_sig_INV4_AV2, 3, DB_NODE_INV4, INV4}; // 0x290
+static const db_message_t db_msg_PEDAL = {db_sig_PEDAL, 4, DB_NODE_PEDAL, PEDALNODE}; // 0x193
+
+#endif // DBSIGNALS_H
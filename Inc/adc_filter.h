@@ -0,0 +1,95 @@
+/**
+ * @file adc_filter.h
+ * @brief Fixed-point streaming filters for ADC samples
+ *
+ * Three integer kernels, chosen per channel:
+ *
+ * - Moving average over 2^shift samples (running sum, no divide)
+ * - CIC decimator: order integrator/comb stages, one output every 2^shift
+ *   samples, normalised back to input scale
+ * - First-order IIR low-pass y += (x - y) / 2^shift, state in Q16
+ *
+ * Samples are consumed a block at a time with a stride, so one call filters
+ * one channel of an interleaved scan buffer. The module is pure (no HAL
+ * access); P_ADC.attachFilter() runs a filter on every DMA half-buffer.
+ */
+
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include "platform_status.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==================== Configuration ==================== */
+
+#ifndef ADCFILTER_MAX_WINDOW_SHIFT
+#define ADCFILTER_MAX_WINDOW_SHIFT  5   ///< Longest moving average: 32 samples
+#endif
+#define ADCFILTER_MAX_WINDOW        (1u << ADCFILTER_MAX_WINDOW_SHIFT)
+#define ADCFILTER_MAX_CIC_ORDER     3   ///< CIC integrator/comb stages
+#define ADCFILTER_CIC_GROWTH_BITS   16  ///< order * shift limit (16-bit input in 32-bit registers)
+#define ADCFILTER_MAX_IIR_SHIFT     15  ///< Smallest IIR coefficient: 1/32768
+
+/* ==================== Types ==================== */
+
+/**
+ * @brief Filter kernel
+ */
+typedef enum {
+    ADCFILTER_NONE = 0,     ///< Pass through the newest sample
+    ADCFILTER_MOVING_AVERAGE,
+    ADCFILTER_CIC,
+    ADCFILTER_IIR
+} ADCFilterType_t;
+
+/**
+ * @brief Filter state for one channel (caller owned)
+ */
+typedef struct {
+    uint8_t  type;          ///< ADCFilterType_t
+    uint8_t  shift;         ///< log2 of window, decimation or 1/alpha
+    uint8_t  order;         ///< CIC stages
+    bool     primed;        ///< First sample seen
+    uint16_t count;         ///< Moving average: ring position, CIC: samples since the last output
+    uint16_t output;        ///< Latest filtered value
+    uint32_t acc;           ///< Moving average sum or IIR state (Q16)
+    uint32_t integ[ADCFILTER_MAX_CIC_ORDER];    ///< CIC integrators (wrap by design)
+    uint32_t comb[ADCFILTER_MAX_CIC_ORDER];     ///< CIC comb delays
+    uint16_t window[ADCFILTER_MAX_WINDOW];      ///< Moving average history
+} ADCFilter_t;
+
+/* ==================== API ==================== */
+
+/**
+ * @brief Configure and reset a filter
+ * @param filter Filter state
+ * @param type Kernel
+ * @param shift Moving average: log2 window (1 to ADCFILTER_MAX_WINDOW_SHIFT),
+ *              CIC: log2 decimation (order * shift <= ADCFILTER_CIC_GROWTH_BITS),
+ *              IIR: coefficient 2^-shift (1 to ADCFILTER_MAX_IIR_SHIFT); ignored for NONE
+ * @param order CIC stages (1 to ADCFILTER_MAX_CIC_ORDER); ignored otherwise
+ * @return PLT_OK, PLT_NULL_POINTER, PLT_INVALID_PARAM
+ */
+plt_status_t ADCFilter_Init(ADCFilter_t* filter, ADCFilterType_t type, uint8_t shift, uint8_t order);
+
+/**
+ * @brief Clear the filter history, keeping its configuration
+ * @param filter Filter state
+ */
+void ADCFilter_Reset(ADCFilter_t* filter);
+
+/**
+ * @brief Feed a block of samples
+ * @param filter Filter state
+ * @param samples First sample of this channel
+ * @param count Samples to consume
+ * @param stride Distance between consecutive samples (channels in the scan)
+ * @return Latest output (also in filter->output)
+ * @note Moving average and IIR seed their history from the first sample, so
+ *       they start at the input level; a CIC settles after order outputs.
+ */
+uint16_t ADCFilter_Process(ADCFilter_t* filter, const volatile uint16_t* samples, uint16_t count, uint16_t stride);
+
+#endif // ADC_FILTER_H
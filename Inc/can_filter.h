@@ -0,0 +1,115 @@
+/**
+ * @file can_filter.h
+ * @brief bxCAN acceptance-filter planner
+ *
+ * Packs a set of routed 11-bit standard IDs into as few hardware filter banks
+ * as possible. Exact IDs go four to a bank in 16-bit list mode; when they do
+ * not fit, neighbouring IDs are merged into 16-bit id/mask pairs (two per
+ * bank), choosing the merges that let the fewest unrouted IDs through.
+ *
+ * CANFilter_PlanFifo() additionally plans a set of high-priority IDs into
+ * their own banks assigned to RX FIFO1, so they never queue behind bulk
+ * traffic in FIFO0.
+ *
+ * The planner is pure (no HAL access). P_CAN.applyRouteFilters() feeds it
+ * the routes of one instance and programs the resulting banks.
+ */
+
+#ifndef CAN_FILTER_H
+#define CAN_FILTER_H
+
+#include "platform_status.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==================== Configuration ==================== */
+
+#define CANFILTER_ID_SPACE      2048                        ///< 11-bit standard IDs
+#define CANFILTER_BITMAP_BYTES  (CANFILTER_ID_SPACE / 8)    ///< One bit per standard ID
+#define CANFILTER_MAX_BANKS     14                          ///< Banks per bxCAN controller
+#define CANFILTER_EXACT_MASK    0x7FF                       ///< Mask that matches one ID
+
+#ifndef CANFILTER_MAX_CUBES
+#define CANFILTER_MAX_CUBES     64                          ///< Planner working set (id/mask groups)
+#endif
+
+/* ==================== Types ==================== */
+
+/**
+ * @brief Filter bank layout
+ */
+typedef enum {
+    CANFILTER_LIST16 = 0,   ///< Four exact IDs
+    CANFILTER_MASK16        ///< Two id/mask pairs
+} CANFilterMode_t;
+
+/**
+ * @brief One planned filter bank (16-bit scale, standard IDs)
+ */
+typedef struct {
+    CANFilterMode_t mode;   ///< Bank layout
+    uint16_t id[4];         ///< LIST16: four IDs, MASK16: id[0] and id[1]
+    uint16_t mask[2];       ///< MASK16 only: mask for id[0] and id[1] (1 = must match)
+    uint8_t fifo;           ///< RX FIFO the bank feeds (0 or 1)
+} CANFilterBank_t;
+
+/**
+ * @brief Complete filter plan for one controller
+ */
+typedef struct {
+    CANFilterBank_t banks[CANFILTER_MAX_BANKS];
+    uint8_t  bank_count;    ///< Banks in use
+    uint16_t routed_ids;    ///< IDs set in the input bitmap
+    uint16_t extra_ids;     ///< Unrouted IDs that still pass the plan
+} CANFilterPlan_t;
+
+/* ==================== API ==================== */
+
+/**
+ * @brief Mark an ID in a route bitmap
+ * @param bitmap Bitmap of CANFILTER_BITMAP_BYTES bytes
+ * @param id Standard ID (ignored if above 0x7FF)
+ */
+void CANFilter_BitmapSet(uint8_t* bitmap, uint16_t id);
+
+/**
+ * @brief Check an ID in a route bitmap
+ * @param bitmap Bitmap of CANFILTER_BITMAP_BYTES bytes
+ * @param id Standard ID
+ * @return true if the ID is marked
+ */
+bool CANFilter_BitmapTest(const uint8_t* bitmap, uint16_t id);
+
+/**
+ * @brief Pack the IDs in a bitmap into at most max_banks filter banks
+ * @param bitmap Route bitmap (CANFILTER_BITMAP_BYTES bytes)
+ * @param max_banks Banks available to the controller (1 to CANFILTER_MAX_BANKS)
+ * @param plan Output plan
+ * @return PLT_OK, PLT_NULL_POINTER, PLT_INVALID_PARAM (bad bank count or empty bitmap)
+ */
+plt_status_t CANFilter_Plan(const uint8_t* bitmap, uint8_t max_banks, CANFilterPlan_t* plan);
+
+/**
+ * @brief Plan like CANFilter_Plan(), sending the IDs in fast to RX FIFO1
+ * @param bitmap Route bitmap (CANFILTER_BITMAP_BYTES bytes)
+ * @param fast IDs to receive through FIFO1 (NULL = none); only routed IDs count
+ * @param max_banks Banks available to the controller (1 to CANFILTER_MAX_BANKS)
+ * @param plan Output plan, FIFO1 banks first
+ * @return PLT_OK, PLT_NULL_POINTER, PLT_INVALID_PARAM (bad bank count or empty bitmap)
+ * @note FIFO1 leaves at least one bank for FIFO0 whenever other routes exist.
+ *       Its banks take the lowest numbers, and FIFO0 list entries never hold a
+ *       fast ID, so bxCAN's match priority sends fast IDs to FIFO1 even when a
+ *       merged FIFO0 mask also covers them.
+ */
+plt_status_t CANFilter_PlanFifo(const uint8_t* bitmap, const uint8_t* fast, uint8_t max_banks, CANFilterPlan_t* plan);
+
+/**
+ * @brief Check whether a plan accepts an ID, as the hardware would
+ * @param plan Filter plan
+ * @param id Standard ID
+ * @return true if some bank matches the ID
+ */
+bool CANFilter_Accepts(const CANFilterPlan_t* plan, uint16_t id);
+
+#endif // CAN_FILTER_H
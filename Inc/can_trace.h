@@ -0,0 +1,91 @@
+/**
+ * @file can_trace.h
+ * @brief Compact binary CAN trace format (capture and replay)
+ *
+ * A trace is a header followed by one variable-length entry per frame, in
+ * reception order across all instances:
+ *
+ *     header:  'C' 'T' 'R' 'C' | version | 0 | 0 | 0
+ *     entry:   dlc | instance << 4 | id_lo | id_hi | delta_us (LEB128) | data[dlc]
+ *
+ * delta_us is the time since the previous entry (0 for the first), so an
+ * 8-byte frame on a 1 kHz schedule takes 13 bytes instead of the 16 of a
+ * CANMessage_t. The module is pure (no HAL access): the CAN driver fills
+ * a RAM ring from the RX interrupt and encodes it here in the main loop
+ * (P_CAN.startCapture), and decodes traces back into its RX queues
+ * (P_CAN.startReplay). scripts/can_trace.py converts to and from candump logs.
+ */
+
+#ifndef CAN_TRACE_H
+#define CAN_TRACE_H
+
+#include "platform_status.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==================== Configuration ==================== */
+
+// Capture ring and replay in the CAN driver; off by default (ring RAM, one ISR branch)
+#ifndef PLT_ENABLE_CAN_TRACE
+#define PLT_ENABLE_CAN_TRACE    0
+#endif
+
+#define CAN_TRACE_VERSION       1
+#define CAN_TRACE_HEADER_SIZE   8       ///< Magic, version, 3 reserved bytes
+#define CAN_TRACE_ENTRY_MAX     16      ///< 3 header bytes + 5 varint bytes + 8 data bytes
+#define CAN_TRACE_MAX_INSTANCE  3       ///< Instance field is 2 bits wide
+
+/* ==================== Types ==================== */
+
+/**
+ * @brief One trace entry
+ */
+typedef struct {
+    uint32_t delta_us;  ///< Microseconds since the previous entry
+    uint16_t id;        ///< 11-bit standard identifier
+    uint8_t instance;   ///< CAN instance index the frame was received on (0-3)
+    uint8_t length;     ///< Data length (0-8)
+    uint8_t data[8];    ///< Payload
+} CANTraceFrame_t;
+
+/* ==================== API ==================== */
+
+/**
+ * @brief Write the trace header
+ * @param out Output buffer
+ * @param size Size of out
+ * @return CAN_TRACE_HEADER_SIZE, or 0 if out is NULL or too small
+ */
+size_t CANTrace_WriteHeader(uint8_t* out, size_t size);
+
+/**
+ * @brief Check a trace header
+ * @param in Trace bytes
+ * @param length Number of bytes in in
+ * @return PLT_OK, PLT_NULL_POINTER, PLT_INVALID_PARAM (short or wrong magic),
+ *         PLT_NOT_SUPPORTED (newer version)
+ */
+plt_status_t CANTrace_CheckHeader(const uint8_t* in, size_t length);
+
+/**
+ * @brief Encode one entry
+ * @param frame Entry to encode
+ * @param out Output buffer, CAN_TRACE_ENTRY_MAX bytes is always enough
+ * @param size Size of out
+ * @return Encoded bytes, or 0 if the entry is invalid (id above 0x7FF, length
+ *         above 8, instance above CAN_TRACE_MAX_INSTANCE) or does not fit
+ */
+size_t CANTrace_Encode(const CANTraceFrame_t* frame, uint8_t* out, size_t size);
+
+/**
+ * @brief Decode the entry at the start of a buffer
+ * @param in Trace bytes, positioned after the header or a previous entry
+ * @param length Number of bytes in in
+ * @param frame Output entry
+ * @param consumed Receives the entry size on PLT_OK
+ * @return PLT_OK, PLT_NULL_POINTER, PLT_UNDERFLOW (entry continues past length),
+ *         PLT_INVALID_PARAM (reserved bits set, length above 8, varint too long)
+ */
+plt_status_t CANTrace_Decode(const uint8_t* in, size_t length, CANTraceFrame_t* frame, size_t* consumed);
+
+#endif // CAN_TRACE_H
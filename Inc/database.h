@@ -6,46 +6,49 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <math.h>
 
 /* =============================== Structs ======================================= */
+/**
+ * @brief AMK status word, one bit per flag.
+ * @note AMK_bits is the raw status byte of Actual values 1 (bit 0 = SystemReady),
+ *       so a whole status update is a single byte store.
+ */
 typedef struct {
 uint8_t AMK_bReserve;
-uint8_t AMK_bSystemReady;
-uint8_t AMK_bError;
-uint8_t AMK_bWarn;
-uint8_t AMK_bQuitDCon;
-uint8_t AMK_bDcOn;
-uint8_t AMK_bQuitInverterOn;
-uint8_t AMK_bInverterOn;
-uint8_t AMK_bDerating;
+union {
+    uint8_t AMK_bits;
+    struct {
+        _Bool AMK_bSystemReady : 1;
+        _Bool AMK_bError : 1;
+        _Bool AMK_bWarn : 1;
+        _Bool AMK_bQuitDCon : 1;
+        _Bool AMK_bDcOn : 1;
+        _Bool AMK_bQuitInverterOn : 1;
+        _Bool AMK_bInverterOn : 1;
+        _Bool AMK_bDerating : 1;
+    };
+};
 
 } AMK_Status_t;
 /**
  * @brief Inverter struct.
  * @note This struct is used to store the inverter paramets for the database layer
+ * @note Fields are grouped by update rate: Actual values 1 (every cycle) first,
+ *       then the setpoints the control loop writes, then the slow values.
  */
 
  typedef struct{
+    /// Viarables from Actual values 1
     AMK_Status_t AMK_Status;
-    int16_t torque; //0.1% Mn change to meaningful value
-
-    int16_t dc_bus_voltage; //not sure about the unit
-    int16_t dc_bus_voltage_monitoring; //not sure about the unit
-    int32_t actual_power; //not sure about the unit
-    int16_t actual_magnetizing_current; //not sure about the unit
-
     int16_t actual_speed;   //rpm
     int16_t torque_current; //Raw data to calculate 'actual torque current'
     int16_t magnetizing_current; //Raw data to calculate 'actual magnetizing current'
-    /// Viarables from Actual values  2
+    int16_t torque; //0.1% Mn change to meaningful value
 
-    int16_t motor_temperature; //0.1 degree C change to meaningful value
-    int16_t plate_temperature; //0.1 degree C change to meaningful value
-    int16_t igbt_temperature; //0.1 degree C change to meaningful value
-  
-    
     struct {
         uint16_t control_word;
         int16_t target_velocity; //rpm
@@ -53,6 +56,16 @@ uint8_t AMK_bDerating;
         int16_t negative_torque_limit; //0.1% Mn change to meaningful value
 
     }setpoints;
+
+    /// Viarables from Actual values  2
+    int16_t motor_temperature; //0.1 degree C change to meaningful value
+    int16_t plate_temperature; //0.1 degree C change to meaningful value
+    int16_t igbt_temperature; //0.1 degree C change to meaningful value
+
+    int16_t dc_bus_voltage; //not sure about the unit
+    int16_t dc_bus_voltage_monitoring; //not sure about the unit
+    int16_t actual_magnetizing_current; //not sure about the unit
+    int32_t actual_power; //not sure about the unit
 } inverter_t;
 
 typedef enum{
@@ -154,14 +167,14 @@ typedef struct{
  */
 
 typedef struct{
-    inverter_t inverters[4];
-    uint8_t SDC_state; // 0 - open circuit, 1 - closed circuit
+    inverter_t inverters[4]; // Must stay first: db_ReadVcu() copies the rest as one unit
     float rear_oil_pressure;
-    uint8_t ASMS;
+    Stage_t fsm_stage ;
     error_group_t error_group;
     uint8_t keep_alive[6];
     counters_t counters;
-    Stage_t fsm_stage ;
+    uint8_t SDC_state; // 0 - open circuit, 1 - closed circuit
+    uint8_t ASMS;
     uint8_t error_reset_flag;
 
 }vcu_node_t;
@@ -177,21 +190,137 @@ typedef struct{
 }dashboard_node_t;
 
 
+/**
+ * @brief Snapshot units of the DB, each guarded by its own sequence counter.
+ * @note DB_NODE_VCU covers the vcu_node fields other than inverters[],
+ *       each inverter is its own unit so one inverter message never
+ *       invalidates a reader of another.
+ */
+
+typedef enum{
+    DB_NODE_PEDAL = 0,
+    DB_NODE_SUB,
+    DB_NODE_VCU,
+    DB_NODE_DASHBOARD,
+    DB_NODE_INV1,
+    DB_NODE_INV2,
+    DB_NODE_INV3,
+    DB_NODE_INV4,
+    DB_NODE_COUNT
+}db_node_t;
+
+
+/**
+ * @brief Change flags, one bit per snapshot unit plus keep_alive.
+ * @note Set when a write changes a unit and cleared by the consumer with
+ *       db_TakeDirty(), so the control loop only re-evaluates what moved.
+ *       The decoder sets a bit only if a stored value differs; a direct
+ *       db_WriteBegin()/db_WriteEnd() update always sets it.
+ *       DB_DIRTY_ALIVE is set when a keep_alive flag goes from 0 to 1.
+ */
+
+#define DB_DIRTY(node)      (1u << (node))
+#define DB_DIRTY_INVERTERS  (DB_DIRTY(DB_NODE_INV1) | DB_DIRTY(DB_NODE_INV2) | \
+                             DB_DIRTY(DB_NODE_INV3) | DB_DIRTY(DB_NODE_INV4))
+#define DB_DIRTY_ALIVE      (1u << DB_NODE_COUNT)
+#define DB_DIRTY_ALL        ((DB_DIRTY_ALIVE << 1) - 1u)
+
+#ifndef DB_MAX_SUBSCRIBERS
+#define DB_MAX_SUBSCRIBERS 4 // Change callbacks per database
+#endif
+
+struct database_s;
+
+/* Change callback: changed holds the subscribed DB_DIRTY_* bits that were set */
+typedef void (*db_callback_t)(struct database_s* db, uint32_t changed);
+
+typedef struct{
+    uint32_t mask;    // DB_DIRTY_* bits of interest
+    db_callback_t callback;
+}db_subscriber_t;
+
+
 /**
  * @brief DB struct.
  * @note This struct is used to store the pointers to all nodes in the DB
  */
 
-typedef struct {
+typedef struct database_s {
 
     pedal_node_t* pedal_node;
     sub_node_t* sub_node;
     vcu_node_t*	vcu_node;
     dashboard_node_t* dashboard_node;
 
+    volatile uint32_t seq[DB_NODE_COUNT]; // Seqlock per node: odd while a writer is inside
+    volatile uint32_t dirty; // DB_DIRTY_* bits not yet taken by the consumer
+    db_subscriber_t subscribers[DB_MAX_SUBSCRIBERS];
+    uint8_t subscriber_count;
+    uint8_t heap; // 1 if db_AllocateMemory() owns the block
+
 } database_t;
 
 
+/**
+ * @brief The whole database in one block: header and every node.
+ * @note db_Init() uses a static instance, db_InitInRegion() carves one out
+ *       of a caller region (e.g. CCM/DTCM RAM), db_AllocateMemory() takes one
+ *       heap allocation. The node pointers always point inside the block.
+ */
+
+#ifndef DB_ALIGN
+#define DB_ALIGN 8 // Block alignment - use 32 for the Cortex-M7 cache line
+#endif
+
+typedef struct {
+    _Alignas(DB_ALIGN) database_t db;
+    pedal_node_t pedal_node;
+    dashboard_node_t dashboard_node;
+    sub_node_t sub_node;
+    vcu_node_t vcu_node;
+} database_block_t;
+
+#define DB_REGION_SIZE sizeof(database_block_t) // Bytes db_InitInRegion() needs
+
+
+/**
+ * @brief One signal of a CAN frame and where it lands in the DB.
+ * @note Little-endian (Intel) bit numbering: bit 0 is the LSB of data[0].
+ *       offset is relative to the unit: the node struct, or inverter_t for
+ *       DB_NODE_INV1..4, so one signal list serves all four inverters.
+ */
+
+#define DB_SIG_SIGNED 0x01 // Sign-extend the raw bits
+#define DB_SIG_CLAMP  0x02 // Limit to [min, max]
+#define DB_SIG_CONST  0x04 // Ignore the frame, store min
+#define DB_SIG_LATCH  0x08 // Only write while the destination is still zero
+
+#define DB_UNIT_MESSAGE 0xFF // db_signal_t.unit: use the message's unit
+#define DB_NO_ALIVE     0xFF // db_message_t.alive: no keep_alive flag
+
+typedef struct{
+    uint16_t offset;  // Destination byte offset inside the unit
+    uint8_t start;    // First bit (0-63)
+    uint8_t length;   // Bits (1-32)
+    uint8_t width;    // Destination size: 1, 2 or 4 bytes
+    uint8_t flags;    // DB_SIG_*
+    uint8_t unit;     // db_node_t, or DB_UNIT_MESSAGE
+    int16_t min;      // DB_SIG_CLAMP lower bound, DB_SIG_CONST value
+    int16_t max;      // DB_SIG_CLAMP upper bound
+}db_signal_t;
+
+typedef struct{
+    const db_signal_t* signals; // Grouped by unit: each unit is published once
+    uint8_t count;
+    uint8_t unit;     // db_node_t the signals default to
+    uint8_t alive;    // keep_alive_t index set on every frame, or DB_NO_ALIVE
+}db_message_t;
+
+/* Descriptor row: destination field named by its struct and member path */
+#define DB_SIG(type, field, start, length, flags, unit, min, max) \
+    {offsetof(type, field), (start), (length), sizeof(((type*)0)->field), (flags), (unit), (min), (max)}
+
+
 /* ========================== Messages ID's =============================== */
 
 #define INV1_AV1_ID 0x283
@@ -259,12 +388,35 @@ typedef struct {
 #define SHORT_TO_GND_VALUE 0xFF10
 #define SHORT_TO_VCC_VALUE 0xFF11
 
+#ifndef DB_SNAPSHOT_RETRIES
+#define DB_SNAPSHOT_RETRIES 8 // Reads overlapped by a write before db_Read* gives up
+#endif
+
 /* ========================== Function Declarations =============================== */
 
 database_t* db_AllocateMemory();
 void db_FreeMemory(database_t* db_ptr);
 database_t* db_Init();
 database_t* db_GetDBPointer();
+database_t* db_InitInRegion(void* region, size_t size);
+
+/* Writers (CAN handlers): bracket every multi-field update of one node */
+void db_WriteBegin(database_t* db, db_node_t node);
+void db_WriteEnd(database_t* db, db_node_t node);
+
+/* Readers (control loop): consistent copies without masking interrupts */
+bool db_ReadPedal(const database_t* db, pedal_node_t* out);
+bool db_ReadSub(const database_t* db, sub_node_t* out);
+bool db_ReadDashboard(const database_t* db, dashboard_node_t* out);
+bool db_ReadInverter(const database_t* db, uint8_t index, inverter_t* out);
+bool db_ReadVcu(const database_t* db, vcu_node_t* out);
+
+/* Table-driven decoder behind the set*Parameters handlers */
+void db_DecodeFrame(database_t* db, const db_message_t* msg, const uint8_t* data);
+
+/* Change detection: poll with db_TakeDirty() or subscribe per field group */
+uint32_t db_TakeDirty(database_t* db, uint32_t mask);
+bool db_Subscribe(database_t* db, uint32_t mask, db_callback_t callback);
 #endif // DATABASE_H
 
 
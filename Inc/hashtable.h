@@ -7,6 +7,12 @@
 #define TABLE_SIZE     128
 #define HASH_EMPTY_ID  0xFFFFFFFF   /* sentinel that marks a free slot     */
 
+/* direct-indexed backend: one byte per 11-bit standard ID -> handler slot */
+#define DIRECT_ID_SPACE       2048
+#ifndef DIRECT_MAX_HANDLERS
+#define DIRECT_MAX_HANDLERS   32     /* distinct handlers, slot 0 = no route */
+#endif
+
 /* ---- types ------------------------------------------------------------ */
 typedef void (*Set_Function_t)(uint8_t *arg);
 
@@ -15,6 +21,32 @@ typedef struct {
     Set_Function_t Set_Function;
 } hash_member_t;
 
+/* open-addressed table; size is a power of two, storage owned by caller */
+typedef struct {
+    hash_member_t *slots;
+    uint16_t       size;
+    uint16_t       mask;
+} hash_table_t;
+
+/* direct-indexed table: index[id] selects handlers[], handlers[0] = NULL */
+typedef struct {
+    uint8_t        index[DIRECT_ID_SPACE];
+    Set_Function_t handlers[DIRECT_MAX_HANDLERS];
+} direct_table_t;
+
+/* interval route [start, end]; tables keep them sorted and non-overlapping */
+typedef struct {
+    uint16_t       start;
+    uint16_t       end;
+    Set_Function_t Set_Function;
+} hash_range_t;
+
+typedef struct {
+    hash_range_t *ranges;
+    uint16_t      capacity;
+    uint16_t      count;
+} range_table_t;
+
 typedef enum {
     HASH_OK,
     HASH_FULL,
@@ -29,4 +61,32 @@ void         hash_DeleteMember(uint32_t id);
 HashStatus_t hash_SetTable(void);
 HashStatus_t hash_Init(void);
 
+/* ---- table objects (hash_* above operate on a default TABLE_SIZE table) */
+HashStatus_t   hash_TableInit(hash_table_t *table, hash_member_t *storage, uint16_t size);
+HashStatus_t   hash_TableInsert(hash_table_t *table, const hash_member_t *member);
+Set_Function_t hash_TableLookup(const hash_table_t *table, uint32_t id);
+void           hash_TableDelete(hash_table_t *table, uint32_t id);
+
+/* ---- direct-indexed backend (O(1), branch-free hit and miss) ---------- */
+HashStatus_t   direct_Init(void);
+HashStatus_t   direct_InsertMember(const hash_member_t *member);
+Set_Function_t direct_Lookup(uint32_t id);
+void           direct_DeleteMember(uint32_t id);
+
+HashStatus_t   direct_TableInit(direct_table_t *table);
+HashStatus_t   direct_TableInsert(direct_table_t *table, const hash_member_t *member);
+Set_Function_t direct_TableLookup(const direct_table_t *table, uint32_t id);
+void           direct_TableDelete(direct_table_t *table, uint32_t id);
+
+/* ---- range routes (one entry per interval, O(log n) lookup) ----------- */
+HashStatus_t   range_TableInit(range_table_t *table, hash_range_t *storage, uint16_t capacity);
+HashStatus_t   range_TableInsert(range_table_t *table, uint16_t start, uint16_t end, Set_Function_t fn);
+Set_Function_t range_TableLookup(const range_table_t *table, uint32_t id);
+void           range_TableDelete(range_table_t *table, uint16_t start);
+
+/* ---- static backend: const table generated from DB_CAN_ROUTE_TABLE ---- */
+HashStatus_t   static_Init(void);
+HashStatus_t   static_InsertMember(const hash_member_t *member);
+Set_Function_t static_Lookup(uint32_t id);
+
 #endif
\ No newline at end of file
@@ -37,6 +37,7 @@ typedef enum {
     PLT_NOT_SUPPORTED       = -12,  ///< Feature not supported
     PLT_OVERFLOW            = -13,  ///< Buffer overflow detected
     PLT_UNDERFLOW           = -14,  ///< Buffer underflow detected
+    PLT_CRC_ERROR           = -15,  ///< Checksum mismatch
 } plt_status_t;
 
 /**
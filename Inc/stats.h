@@ -0,0 +1,146 @@
+/**
+ * @file stats.h
+ * @brief Opt-in hot-path timing on the DWT cycle counter
+ *
+ * Build with -DPLT_ENABLE_STATS=1 to time the CAN RX interrupt, each routed
+ * CAN handler, Queue_Push/Queue_Pop and UART/SPI transfers, and to track the
+ * receive-to-dispatch latency of CAN frames. Queues also keep a high-water
+ * mark and a drop counter. Platform.getStats() collects everything in one
+ * snapshot.
+ *
+ * With PLT_ENABLE_STATS at 0 (the default) the STATS_* macros expand to
+ * nothing and no counter storage is linked in, so the hot paths are exactly
+ * what they are without this module.
+ *
+ * Cycles come from DWT->CYCCNT on ARMv7-M and ARMv8-M Mainline cores. Other
+ * cores (Cortex-M0/M0+) and host builds read 0, so only counts and latencies
+ * are meaningful there. Counters are updated without masking interrupts; a
+ * sample recorded concurrently from an ISR and the main loop can be lost,
+ * which is fine for diagnostics.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ==================== Configuration ==================== */
+
+#ifndef PLT_ENABLE_STATS
+#define PLT_ENABLE_STATS    0
+#endif
+
+#ifndef STATS_MAX_ROUTES
+#define STATS_MAX_ROUTES    16  ///< CAN IDs timed individually, first come first served
+#endif
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define STATS_HAVE_CYCCNT   1
+#define STATS_DWT_CYCCNT    (*(volatile uint32_t*)0xE0001004u)
+#else
+#define STATS_HAVE_CYCCNT   0
+#endif
+
+/* ==================== Types ==================== */
+
+/**
+ * @brief Running min/max/total of one measurement
+ */
+typedef struct {
+    uint32_t count;         ///< Samples recorded
+    uint32_t min;           ///< Smallest sample (valid once count > 0)
+    uint32_t max;           ///< Largest sample
+    uint64_t total;         ///< Sum of all samples, for the average
+} StatsCounter_t;
+
+/**
+ * @brief Instrumented code paths
+ */
+typedef enum {
+    STATS_CAN_RX_ISR = 0,   ///< HAL_CAN_RxFifo0/1MsgPendingCallback, cycles
+    STATS_CAN_DISPATCH,     ///< One CAN handler call from handleRxMessages, cycles
+    STATS_CAN_LATENCY,      ///< Reception to dispatch, in CANMessage_t.timestamp units
+    STATS_QUEUE_PUSH,       ///< Queue_Push, cycles
+    STATS_QUEUE_POP,        ///< Queue_Pop, cycles
+    STATS_UART_TX,          ///< One UART write (queue or blocking send), cycles
+    STATS_SPI_TRANSFER,     ///< One SPI transfer, start to completion, cycles
+    STATS_POINT_COUNT
+} StatsPoint_t;
+
+/**
+ * @brief Handler timing of one routed CAN ID
+ */
+typedef struct {
+    uint16_t id;
+    StatsCounter_t cycles;
+} StatsRoute_t;
+
+/**
+ * @brief All timing counters
+ */
+typedef struct {
+    StatsCounter_t point[STATS_POINT_COUNT];
+    StatsRoute_t route[STATS_MAX_ROUTES];
+    uint8_t route_count;        ///< Entries used in route[]
+    uint32_t route_overflow;    ///< Dispatches of IDs that found route[] full
+} StatsTimings_t;
+
+/* ==================== API ==================== */
+
+/**
+ * @brief Add one sample to a counter
+ */
+void Stats_Record(StatsCounter_t* counter, uint32_t value);
+
+/**
+ * @brief Add one handler timing to the entry of its CAN ID
+ * @note Claims a free entry for a new ID; counts an overflow once all
+ *       STATS_MAX_ROUTES are taken
+ */
+void Stats_RecordRoute(StatsTimings_t* timings, uint16_t id, uint32_t cycles);
+
+/**
+ * @brief Mean of a counter, 0 before the first sample
+ */
+uint32_t Stats_Average(const StatsCounter_t* counter);
+
+/**
+ * @brief Clear every counter
+ */
+void Stats_Reset(StatsTimings_t* timings);
+
+/**
+ * @brief Start DWT->CYCCNT (no-op without a cycle counter)
+ * @note Called by Platform.begin() when PLT_ENABLE_STATS is set
+ */
+void Stats_EnableCycleCounter(void);
+
+/**
+ * @brief Current cycle count (0 without a cycle counter)
+ */
+static inline uint32_t Stats_Now(void) {
+#if STATS_HAVE_CYCCNT
+    return STATS_DWT_CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+/* ==================== Instrumentation ==================== */
+
+#if PLT_ENABLE_STATS
+extern StatsTimings_t Stats_timings;
+
+#define STATS_START(t)              uint32_t t = Stats_Now()
+#define STATS_STOP(which, t)        Stats_Record(&Stats_timings.point[(which)], Stats_Now() - (t))
+#define STATS_STOP_ROUTE(id, t)     Stats_RecordRoute(&Stats_timings, (id), Stats_Now() - (t))
+#define STATS_SAMPLE(which, value)  Stats_Record(&Stats_timings.point[(which)], (value))
+#else
+#define STATS_START(t)              do {} while (0)
+#define STATS_STOP(which, t)        do {} while (0)
+#define STATS_STOP_ROUTE(id, t)     do {} while (0)
+#define STATS_SAMPLE(which, value)  do {} while (0)
+#endif
+
+#endif // STATS_H
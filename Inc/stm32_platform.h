@@ -120,6 +120,9 @@
 #endif
 
 #include "platform_status.h"
+#include "adc_filter.h"
+#include "stats.h"
+#include "can_trace.h"
 
 /* ==================== HAL Type Declarations ==================== */
 /**
@@ -144,9 +147,19 @@ typedef struct {
     uint16_t id;           /*!< CAN identifier (11-bit standard) */
     uint8_t data[8];       /*!< Message data (up to 8 bytes) */
     uint8_t length;        /*!< Actual data length (0-8) */
-    uint32_t timestamp;    /*!< Reception timestamp (HAL_GetTick) */
+    uint32_t timestamp;    /*!< Reception timestamp in P_CAN.setTimestampSource() units (default HAL_GetTick ms) */
 } CANMessage_t;
 
+/**
+ * @brief Clock that stamps received and transmitted CAN frames
+ */
+typedef enum {
+    CAN_TIMESTAMP_TICK = 0,     /*!< HAL_GetTick, 1 ms (default) */
+    CAN_TIMESTAMP_DWT,          /*!< DWT cycle counter, 1 / SystemCoreClock (Cortex-M3 and up) */
+    CAN_TIMESTAMP_TIMER,        /*!< Free-running 32-bit timer (TIM2/TIM5, ARR = 0xFFFFFFFF) */
+    CAN_TIMESTAMP_HARDWARE      /*!< bxCAN time-triggered mode counter, 1 bit time, 16 bits wide */
+} CANTimestampSource_t;
+
 /**
  * @brief UART message structure
  */
@@ -164,6 +177,54 @@ typedef struct {
     uint16_t length;       /*!< Actual data length */
 } SPIMessage_t;
 
+typedef struct SPITransaction_t SPITransaction_t;
+
+/**
+ * @brief One queued SPI transaction (caller-owned, must stay valid until completed)
+ */
+struct SPITransaction_t {
+    GPIO_TypeDef* cs_port;      /*!< Chip-select port, driven low for the transfer (NULL = none) */
+    uint16_t cs_pin;            /*!< Chip-select pin */
+    const uint8_t* tx;          /*!< Bytes to send (NULL = receive only) */
+    uint8_t* rx;                /*!< Receive buffer (NULL = transmit only) */
+    uint16_t length;            /*!< Bytes to transfer */
+    uint32_t clock_hz;          /*!< Device SCK limit, applied before the transfer (0 = leave bus as is) */
+    uint8_t mode;               /*!< Device SPI mode 0-3, applied together with clock_hz */
+    void (*onComplete)(SPITransaction_t* txn);  /*!< Called from P_SPI.handleRxData() (optional) */
+    void* context;              /*!< User data for onComplete */
+    volatile plt_status_t status;   /*!< PLT_BUSY while queued/on the wire, then PLT_OK or PLT_HAL_ERROR */
+};
+
+/**
+ * @brief What a DMA-backed UART write does when the TX ring is full
+ */
+typedef enum {
+    UART_TX_BLOCK = 0,      /*!< Wait for ring space, up to the UART timeout (default) */
+    UART_TX_DROP,           /*!< Discard the whole write and return false */
+    UART_TX_OVERWRITE       /*!< Discard the oldest queued bytes to make room */
+} UARTTxPolicy_t;
+
+/**
+ * @brief One buffer of a scatter-gather UART write
+ */
+typedef struct {
+    const void* data;       /*!< Bytes to send */
+    uint16_t length;        /*!< Number of bytes */
+} UARTSegment_t;
+
+/**
+ * @brief ADC scan sequence for P_ADC.startScan()
+ * 
+ * Channels are converted in array order on every trigger and streamed into
+ * a double-buffered circular DMA buffer.
+ */
+typedef struct {
+    const uint8_t* channels;    /*!< Channel numbers in conversion order (e.g. ADC_CHANNEL_1) */
+    uint8_t count;              /*!< Channels in the sequence (1 to ADC_MAX_SCAN_CHANNELS) */
+    uint32_t sampling_time;     /*!< HAL sampling time for every channel (e.g. ADC_SAMPLETIME_56CYCLES) */
+    uint8_t trigger_timer;      /*!< Timer instance whose update event starts each sequence, or ADC_TRIGGER_NONE */
+} ADCScanConfig_t;
+
 /* ==================== Configuration Limits ==================== */
 
 #define PLT_MAX_CAN_INSTANCES   4   /*!< Maximum number of CAN peripherals */
@@ -172,6 +233,60 @@ typedef struct {
 #define PLT_MAX_ADC_INSTANCES   4   /*!< Maximum number of ADC peripherals */
 #define PLT_MAX_TIM_INSTANCES   20  /*!< Maximum number of timer peripherals */
 
+#ifndef ADC_MAX_SCAN_CHANNELS
+#define ADC_MAX_SCAN_CHANNELS   16  /*!< Longest ADC scan sequence (regular group limit) */
+#endif
+#ifndef ADC_SCAN_BLOCK
+#define ADC_SCAN_BLOCK          4   /*!< Scan sequences per DMA half-buffer */
+#endif
+#define ADC_TRIGGER_NONE        0xFF    /*!< ADCScanConfig_t.trigger_timer: convert continuously */
+
+#define PWM_CH1                 0x01    /*!< setDutyCycles/setCompares channel mask bits */
+#define PWM_CH2                 0x02
+#define PWM_CH3                 0x04
+#define PWM_CH4                 0x08
+
+/* ==================== Statistics ==================== */
+
+/**
+ * @brief Fill statistics of one queue
+ */
+typedef struct {
+    uint16_t high_water;    /*!< Deepest fill seen */
+    uint32_t drops;         /*!< Items lost because the queue was full */
+} PlatformQueueStats_t;
+
+/**
+ * @brief Snapshot returned by Platform.getStats() (PLT_ENABLE_STATS builds)
+ */
+typedef struct {
+    StatsTimings_t timings;                             /*!< Cycle counters and CAN latency (see stats.h) */
+    struct {
+        PlatformQueueStats_t rx;                        /*!< FIFO0 receive queue */
+        PlatformQueueStats_t rx_fast;                   /*!< FIFO1 (prioritized) receive queue */
+        PlatformQueueStats_t tx;                        /*!< Frames waiting for a mailbox */
+    } can[PLT_MAX_CAN_INSTANCES];
+    struct {
+        PlatformQueueStats_t rx;                        /*!< Receive queue, or DMA ring overruns */
+        PlatformQueueStats_t tx;                        /*!< DMA TX ring */
+    } uart[PLT_MAX_UART_INSTANCES];
+    uint32_t core_hz;                                   /*!< SystemCoreClock, to turn cycles into time */
+} PlatformStats_t;
+
+/**
+ * @brief Capture and replay counters returned by P_CAN.getTraceStatus() (PLT_ENABLE_CAN_TRACE builds)
+ */
+typedef struct {
+    uint32_t captured;          /*!< Frames recorded into the capture ring */
+    uint32_t capture_drops;     /*!< Frames lost because the capture ring was full */
+    uint32_t replayed;          /*!< Frames injected into the RX queues */
+    uint32_t replay_drops;      /*!< Frames due while their RX queue was full (bus overrun) */
+    bool capturing;             /*!< startCapture() is active */
+    bool replaying;             /*!< A trace is being replayed */
+} CANTraceStatus_t;
+
+#define CAN_CAPTURE_NO_UART     0xFF    /*!< startCapture(): keep the trace for readCapture() */
+
 /* ==================== Peripheral Handles Structure ==================== */
 
 /**
@@ -233,6 +348,10 @@ struct CAN_t {
      * @param data Pointer to data buffer
      * @param length Data length (0-8 bytes)
      * @return true if message queued successfully
+     * @note Never blocks. With all three mailboxes busy the frame joins a
+     *       software queue ordered by ID (lowest first, FIFO for equal IDs)
+     *       that the TX mailbox-empty interrupt drains. Returns false with
+     *       PLT_QUEUE_FULL once CAN_TX_QUEUE_SIZE frames are waiting.
      */
     bool (*send)(uint8_t instance, uint16_t id, const uint8_t* data, uint8_t length);
     
@@ -253,6 +372,18 @@ struct CAN_t {
      */
     void (*handleRxMessages)(uint8_t instance);
     
+    /**
+     * @brief Handle a burst of received CAN messages in place
+     * 
+     * Takes the pending messages as at most two contiguous spans of the RX
+     * ring, dispatches them without copying, then releases all of them with
+     * a single tail update. Preferred for high-rate buses.
+     * @param instance CAN instance index (0 to can_count-1)
+     * @param maxMessages Upper bound on messages handled (0 = all pending)
+     * @return Number of messages dispatched
+     */
+    uint16_t (*handleRxMessagesBatch)(uint8_t instance, uint16_t maxMessages);
+    
     /**
      * @brief Get number of messages waiting in queue
      * @param instance CAN instance index (0 to can_count-1)
@@ -260,6 +391,13 @@ struct CAN_t {
      */
     uint16_t (*availableMessages)(uint8_t instance);
     
+    /**
+     * @brief Get number of frames waiting for a TX mailbox
+     * @param instance CAN instance index (0 to can_count-1)
+     * @return Frames in the software TX queue (not counting mailboxes)
+     */
+    uint16_t (*pendingTxMessages)(uint8_t instance);
+    
     /**
      * @brief Register handler for specific CAN ID
      * @param instance CAN instance index (0 to can_count-1)
@@ -270,6 +408,10 @@ struct CAN_t {
     
     /**
      * @brief Register handler for range of CAN IDs
+     * 
+     * Stored as a single interval entry (CAN_ROUTE_RANGES per instance) and
+     * found by binary search after an exact-match miss, so large blocks do
+     * not consume routing table slots. Overlapping ranges are rejected.
      * @param instance CAN instance index (0 to can_count-1)
      * @param idStart Start of ID range (inclusive)
      * @param idEnd End of ID range (inclusive)
@@ -285,10 +427,92 @@ struct CAN_t {
      */
     void (*setFilter)(uint8_t instance, uint16_t id, uint16_t mask);
     
+    /**
+     * @brief Compile the registered routes into hardware acceptance filters
+     * 
+     * Packs every ID routed on this instance into the controller's 14 filter
+     * banks (CAN1: 0-13, CAN2: 14-27), using 16-bit list mode for exact IDs
+     * and merged id/mask pairs when they do not fit. Unrouted traffic is then
+     * dropped in hardware, so the default handler only sees the few unrouted
+     * IDs a merged mask lets through. Call after all route()/routeRange().
+     * @param instance CAN instance index (0 to can_count-1)
+     * @return true if the filters were programmed (false if nothing is routed)
+     */
+    bool (*applyRouteFilters)(uint8_t instance);
+    
+    /**
+     * @brief Receive a block of IDs through RX FIFO1
+     * 
+     * The next applyRouteFilters() gives the routed IDs in [idStart, idEnd]
+     * their own filter banks feeding FIFO1. FIFO1 frames land in a separate
+     * queue that handleRxMessages() dispatches first, so they never wait
+     * behind bulk traffic or get dropped when FIFO0 overruns.
+     * @param instance CAN instance index (0 to can_count-1)
+     * @param idStart First ID (inclusive)
+     * @param idEnd Last ID (inclusive, up to 0x7FF)
+     * @return true if recorded (false: PLT_INVALID_PARAM, or PLT_NO_MEMORY after CAN_FAST_RANGES calls)
+     */
+    bool (*prioritize)(uint8_t instance, uint16_t idStart, uint16_t idEnd);
+    
+    /**
+     * @brief Choose the clock that stamps CAN frames (all instances)
+     * 
+     * Stamps are taken in the RX FIFO interrupt (CANMessage_t.timestamp) and in
+     * the TX mailbox-complete interrupt (getTxTimestamp). TIMER starts the timer
+     * if it is not running. HARDWARE needs Time Triggered Communication Mode
+     * enabled in CubeMX; the controller then latches its bit-time counter at
+     * the start of frame of every frame, with no interrupt latency.
+     * @param source Clock to use
+     * @param timer Timer instance index for CAN_TIMESTAMP_TIMER (ignored otherwise)
+     * @return true if applied; false with PLT_INVALID_PARAM (timer not 32-bit,
+     *         TTCM off) or PLT_NOT_SUPPORTED (no DWT cycle counter)
+     */
+    bool (*setTimestampSource)(CANTimestampSource_t source, uint8_t timer);
+    
+    /**
+     * @brief Convert a duration in timestamp units to microseconds
+     * @param instance CAN instance index (HARDWARE stamps count in its bit time)
+     * @param ticks Difference of two timestamps
+     * @return Microseconds, 0 if the clock rate is unknown
+     */
+    uint32_t (*toMicros)(uint8_t instance, uint32_t ticks);
+    
+    /**
+     * @brief Microseconds from one timestamp to a later one
+     * @param instance CAN instance index the stamps came from
+     * @param start Earlier timestamp (e.g. from getTxTimestamp)
+     * @param end Later timestamp (e.g. CANMessage_t.timestamp of the reply)
+     * @return end - start in microseconds, wrap-safe for the source's counter width
+     */
+    uint32_t (*elapsedMicros)(uint8_t instance, uint32_t start, uint32_t end);
+    
+    /**
+     * @brief Completion time of the last transmission of an ID
+     * @param instance CAN instance index (0 to can_count-1)
+     * @param id CAN identifier that was sent
+     * @param timestamp Receives the stamp, in setTimestampSource() units
+     * @return true if a completed transmission of id is on record
+     * @note CAN_TX_STAMP_SLOTS recent IDs are kept; IDs sharing a slot evict each other
+     * 
+     * @example
+     * P_CAN.send(0, 0x184, setpoint, 8);
+     * // ... in the Platform.onCAN() handler, which receives the whole message:
+     * uint32_t sent;
+     * if (P_CAN.getTxTimestamp(0, 0x184, &sent)) {
+     *     uint32_t us = P_CAN.elapsedMicros(0, sent, msg->timestamp);
+     * }
+     */
+    bool (*getTxTimestamp)(uint8_t instance, uint16_t id, uint32_t* timestamp);
+    
     /**
      * @brief Set CAN baudrate
+     * 
+     * Computes bit timing from the APB1 clock (sample point near 87.5 %)
+     * and rewrites BTR in initialization mode; filters and notifications
+     * are kept. Repeating the current rate costs nothing.
      * @param instance CAN instance index (0 to can_count-1)
      * @param baudrate Baudrate in bps (e.g., 500000 for 500 kbit/s)
+     * @note PLT_NOT_SUPPORTED if the clock cannot produce the rate exactly
      */
     void (*setBaudrate)(uint8_t instance, uint32_t baudrate);
     
@@ -319,6 +543,76 @@ struct CAN_t {
      * @return Number of errors detected
      */
     uint32_t (*getErrorCount)(uint8_t instance);
+    
+    /**
+     * @brief Record every received frame, all instances, into a trace
+     * 
+     * The RX interrupt copies each frame into a RAM ring (CAN_CAPTURE_QUEUE_SIZE
+     * frames, including frames the RX queues had to drop); handleCapture()
+     * encodes them in the compact can_trace.h format. With a UART the trace
+     * goes out as TELEMETRY_TYPE_CAN_TRACE records of whole entries (use a TX
+     * DMA UART fast enough for the bus: ~13 bytes per frame); with
+     * CAN_CAPTURE_NO_UART the application pulls it with readCapture(), e.g.
+     * to write it to an SD card. Either way the stream starts with the header.
+     * @param uart UART instance index to stream on, or CAN_CAPTURE_NO_UART
+     * @return true if started; false with PLT_INVALID_PARAM (bad UART),
+     *         PLT_BUSY (replaying), PLT_NOT_SUPPORTED (CAN_TIMESTAMP_HARDWARE
+     *         source, or built without PLT_ENABLE_CAN_TRACE)
+     */
+    bool (*startCapture)(uint8_t uart);
+    
+    /**
+     * @brief Stop recording; frames already in the ring can still be read
+     */
+    void (*stopCapture)(void);
+    
+    /**
+     * @brief Stream captured frames to the capture UART
+     * 
+     * Call from the main loop. A record is sent once the next entry would not
+     * fit, or CAN_CAPTURE_FLUSH_MS after its first entry.
+     */
+    void (*handleCapture)(void);
+    
+    /**
+     * @brief Take encoded trace bytes (CAN_CAPTURE_NO_UART captures)
+     * @param buffer Output buffer
+     * @param size Size of buffer (at least CAN_TRACE_ENTRY_MAX)
+     * @return Bytes written, whole entries only (0 when the ring is empty)
+     */
+    uint16_t (*readCapture)(uint8_t* buffer, uint16_t size);
+    
+    /**
+     * @brief Inject a recorded trace into the RX queues
+     * 
+     * handleRxMessages()/handleRxMessagesBatch() move every entry that has
+     * come due into the RX queue of its instance (rx_fast for prioritized
+     * IDs), stamped with the current time, before dispatching; call them
+     * from one context only. Live frames are discarded while a replay runs.
+     * A timed replay drops frames whose queue is full, like a real overrun,
+     * and counts them in replay_drops; speedPercent 0 injects as fast as the
+     * queues empty, which measures the saturation rate of the dispatch path.
+     * @param trace Header and entries (caller-owned, must stay valid until the replay ends)
+     * @param length Bytes in trace
+     * @param speedPercent 100 = recorded timing, 250 = 2.5x bus load, 0 = flat out
+     * @return true if started; false with PLT_INVALID_PARAM (bad header),
+     *         PLT_BUSY (capturing), PLT_NOT_SUPPORTED (timed replay with the
+     *         HARDWARE source, or built without PLT_ENABLE_CAN_TRACE)
+     * @note Use the DWT or TIMER source for microsecond spacing; TICK releases frames per millisecond
+     */
+    bool (*startReplay)(const uint8_t* trace, uint32_t length, uint16_t speedPercent);
+    
+    /**
+     * @brief Abandon a replay; frames already queued are still dispatched
+     */
+    void (*stopReplay)(void);
+    
+    /**
+     * @brief Capture and replay counters
+     * @param out Receives the counters
+     * @return true if filled; false with PLT_NULL_POINTER or PLT_NOT_SUPPORTED
+     */
+    bool (*getTraceStatus)(CANTraceStatus_t* out);
 };
 
 /* ==================== UART Interface ==================== */
@@ -329,6 +623,11 @@ struct CAN_t {
 struct UART_t {
     /**
      * @brief Print string without newline
+     * 
+     * If the UART handle has a TX DMA channel, all output functions copy into
+     * a per-instance TX ring and return immediately; DMA drains the ring in
+     * the background, chained from the TX-complete interrupt. Without TX DMA
+     * they fall back to blocking HAL_UART_Transmit.
      * @param instance UART instance index (0 to uart_count-1)
      * @param str Null-terminated string
      */
@@ -338,6 +637,7 @@ struct UART_t {
      * @brief Print string with newline
      * @param instance UART instance index (0 to uart_count-1)
      * @param str Null-terminated string
+     * @note String and "\r\n" go out as one writev()
      */
     void (*println)(uint8_t instance, const char* str);
     
@@ -346,6 +646,9 @@ struct UART_t {
      * @param instance UART instance index (0 to uart_count-1)
      * @param fmt Format string
      * @param ... Variable arguments
+     * @note Formatted by plt_vformat() and streamed straight into the TX ring
+     *       (or HAL in small blocks), so output has no length limit.
+     *       See plt_vformat() for supported conversions.
      */
     void (*printf)(uint8_t instance, const char* fmt, ...);
     
@@ -358,6 +661,35 @@ struct UART_t {
      */
     bool (*write)(uint8_t instance, const uint8_t* data, uint16_t length);
     
+    /**
+     * @brief Write several buffers as one message
+     * 
+     * With TX DMA every segment is queued before the ring is kicked, so the
+     * buffers leave in as few DMA transfers as possible. Under UART_TX_DROP
+     * the message is all-or-nothing. Without TX DMA the segments are sent
+     * back to back with blocking HAL calls.
+     * @param instance UART instance index (0 to uart_count-1)
+     * @param segments Array of buffers (zero-length entries are skipped)
+     * @param count Number of entries in segments
+     * @return true if every segment was sent or queued
+     */
+    bool (*writev)(uint8_t instance, const UARTSegment_t* segments, uint8_t count);
+    
+    /**
+     * @brief Send one binary telemetry record (COBS frame with CRC-16)
+     * 
+     * Far cheaper than printf for periodic status: the payload (for example
+     * a database node struct) is copied as-is and decoded on the host with
+     * scripts/telemetry_decode.py. See telemetry.h for the frame format.
+     * @param instance UART instance index (0 to uart_count-1)
+     * @param type Record type tag (TelemetryType_t or TELEMETRY_TYPE_USER and up)
+     * @param data Record bytes
+     * @param length Record bytes (at most TELEMETRY_MAX_PAYLOAD)
+     * @return true if the frame was sent or queued
+     * @note Main-loop only: frames are built in one shared scratch buffer
+     */
+    bool (*sendRecord)(uint8_t instance, uint8_t type, const void* data, uint16_t length);
+    
     /**
      * @brief Handle received UART data from queue
      * 
@@ -369,6 +701,10 @@ struct UART_t {
     
     /**
      * @brief Get number of bytes waiting in RX queue
+     * 
+     * If the UART handle has a circular RX DMA channel, reception runs from
+     * a 256-byte DMA ring with IDLE/half/full events (one interrupt per
+     * packet, not per byte) and this reports the bytes held in that ring.
      * @param instance UART instance index (0 to uart_count-1)
      * @return Number of unread bytes
      */
@@ -392,6 +728,10 @@ struct UART_t {
     
     /**
      * @brief Set UART baudrate
+     * 
+     * Flushes queued TX output, then rewrites BRR directly (reception keeps
+     * running). Families whose USART needs UE cleared fall back to
+     * HAL_UART_Init(). Repeating the current rate costs nothing.
      * @param instance UART instance index (0 to uart_count-1)
      * @param baudrate Baudrate in bps (e.g., 115200)
      */
@@ -410,6 +750,20 @@ struct UART_t {
      * @return true if ready for transmission
      */
     bool (*isReady)(uint8_t instance);
+    
+    /**
+     * @brief Choose what happens when the DMA TX ring is full
+     * @param instance UART instance index (0 to uart_count-1)
+     * @param policy UART_TX_BLOCK, UART_TX_DROP or UART_TX_OVERWRITE
+     */
+    void (*setTxPolicy)(uint8_t instance, UARTTxPolicy_t policy);
+    
+    /**
+     * @brief Wait until all queued TX bytes have been sent
+     * @param instance UART instance index (0 to uart_count-1)
+     * @return true if drained, false on timeout (see setTimeout)
+     */
+    bool (*flush)(uint8_t instance);
 };
 
 /* ==================== SPI Interface ==================== */
@@ -419,11 +773,12 @@ struct UART_t {
  */
 struct SPI_t {
     /**
-     * @brief Full-duplex SPI transfer
+     * @brief Full-duplex SPI transfer (blocking)
      * @param instance SPI instance index (0 to spi_count-1)
      * @param txData Pointer to transmit buffer
      * @param rxData Pointer to receive buffer
      * @param length Number of bytes to transfer
+     * @note Waits for queued transactions to finish first; times out after SPI_TIMEOUT_MS
      */
     void (*transfer)(uint8_t instance, uint8_t* txData, uint8_t* rxData, uint16_t length);
     
@@ -436,25 +791,52 @@ struct SPI_t {
     uint8_t (*transferByte)(uint8_t instance, uint8_t data);
     
     /**
-     * @brief Handle received SPI data from queue
+     * @brief Queue an asynchronous transaction
      * 
-     * Dequeues all pending data and calls registered handler.
+     * Transactions run back to back in submission order, started from the
+     * completion interrupt of the previous one, so devices on different chip
+     * selects share the bus without the CPU waiting. Chip select is driven
+     * low before and high after each transfer. Uses DMA when the handle has
+     * hdmatx and hdmarx linked, interrupt mode otherwise.
+     * @param instance SPI instance index (0 to spi_count-1)
+     * @param txn Transaction; tx, rx and txn itself must stay valid until completion
+     * @return true if queued; false with PLT_QUEUE_FULL or PLT_INVALID_PARAM in getLastError()
+     * @note With tx NULL the HAL clocks out the current rx buffer contents
+     */
+    bool (*submit)(uint8_t instance, SPITransaction_t* txn);
+    
+    /**
+     * @brief Check whether transactions are queued or on the wire
+     * @param instance SPI instance index (0 to spi_count-1)
+     * @return true while the instance has unfinished transactions
+     */
+    bool (*isBusy)(uint8_t instance);
+    
+    /**
+     * @brief Deliver completed transactions
+     * 
+     * Calls onComplete for every transaction finished since the last call.
      * Call this in your main loop.
      * @param instance SPI instance index (0 to spi_count-1)
      */
     void (*handleRxData)(uint8_t instance);
     
     /**
-     * @brief Get number of bytes waiting in RX queue
+     * @brief Get number of received bytes waiting for handleRxData()
      * @param instance SPI instance index (0 to spi_count-1)
-     * @return Number of unprocessed bytes
+     * @return Bytes received by completed, undelivered transactions
      */
     uint16_t (*availableBytes)(uint8_t instance);
     
     /**
      * @brief Set SPI clock speed
+     * 
+     * Picks the fastest prescaler not above hz and writes CR1.BR directly.
+     * Unchanged settings are skipped. For a shared bus, set clock_hz/mode in
+     * each SPITransaction_t instead: they are applied between transactions.
      * @param instance SPI instance index (0 to spi_count-1)
-     * @param hz Clock frequency in Hz
+     * @param hz Clock frequency in Hz (upper limit)
+     * @note PLT_BUSY while a transfer is in flight
      */
     void (*setClockSpeed)(uint8_t instance, uint32_t hz);
     
@@ -462,6 +844,7 @@ struct SPI_t {
      * @brief Set SPI mode (0-3)
      * @param instance SPI instance index (0 to spi_count-1)
      * @param mode SPI mode (CPOL/CPHA combination)
+     * @note Direct CR1 update like setClockSpeed(); PLT_BUSY while a transfer is in flight
      */
     void (*setMode)(uint8_t instance, uint8_t mode);
     
@@ -488,20 +871,51 @@ struct SPI_t {
 struct ADC_t {
     /**
      * @brief Read raw ADC value
+     * 
+     * While a scan runs this returns the channel's latest DMA sample without
+     * touching the HAL; otherwise it performs one blocking conversion.
      * @param instance ADC instance index (0 to adc_count-1)
      * @param channel ADC channel number
      * @return Raw ADC value (12-bit: 0-4095)
+     * @note Channels outside a running scan return 0 with PLT_INVALID_PARAM
      */
     uint16_t (*readRaw)(uint8_t instance, uint8_t channel);
     
     /**
      * @brief Read ADC value converted to voltage
+     * 
+     * One multiply by a volts-per-LSB factor precomputed from the current
+     * resolution and reference.
      * @param instance ADC instance index (0 to adc_count-1)
      * @param channel ADC channel number
      * @return Voltage in volts
      */
     float (*readVoltage)(uint8_t instance, uint8_t channel);
     
+    /**
+     * @brief Read ADC value as fixed-point voltage
+     * 
+     * Integer-only counterpart of readVoltage() for cores without an FPU.
+     * @param instance ADC instance index (0 to adc_count-1)
+     * @param channel ADC channel number
+     * @return Voltage in Q16.16 (65536 = 1 V)
+     */
+    uint32_t (*readVoltageQ16)(uint8_t instance, uint8_t channel);
+    
+    /**
+     * @brief Convert the latest scan half-buffer to volts
+     * 
+     * Writes ADC_SCAN_BLOCK sequences, interleaved in scan order
+     * (volts[s * count + rank]). Build with -DPLT_USE_CMSIS_DSP=1 to run the
+     * conversion through CMSIS-DSP on M4/M7.
+     * @param instance ADC instance index (0 to adc_count-1)
+     * @param volts Output array
+     * @param capacity Entries available in volts (at least count * ADC_SCAN_BLOCK)
+     * @return Samples written, 0 if no scan is running or capacity is too small
+     * @note Call within one half-period of getScanCount() advancing; after that DMA overwrites the block
+     */
+    uint16_t (*readVoltageBlock)(uint8_t instance, float* volts, uint16_t capacity);
+    
     /**
      * @brief Handle completed ADC conversions
      * 
@@ -530,6 +944,55 @@ struct ADC_t {
      * @param instance ADC instance index (0 to adc_count-1)
      */
     void (*calibrate)(uint8_t instance);
+    
+    /**
+     * @brief Start a timer-triggered DMA scan
+     * 
+     * Programs the regular sequence and starts circular DMA into a buffer of
+     * two halves. Each half holds ADC_SCAN_BLOCK sequences; when one fills,
+     * its last sequence becomes what readRaw()/readVoltage() return while
+     * the DMA moves on to the other half.
+     * 
+     * With a trigger timer its update event is routed to TRGO, so the timer
+     * frequency (P_PWM.setFrequency()) is the sample rate. The ADC's external
+     * trigger must select that timer's TRGO in CubeMX. ADC_TRIGGER_NONE runs
+     * the sequence back to back (continuous mode).
+     * @param instance ADC instance index (0 to adc_count-1)
+     * @param config Scan sequence (copied; the channel array may be temporary)
+     * @return true if the scan is running
+     * @note Restarts a scan already in progress
+     */
+    bool (*startScan)(uint8_t instance, const ADCScanConfig_t* config);
+    
+    /**
+     * @brief Stop a running scan and return to single conversions
+     * @param instance ADC instance index (0 to adc_count-1)
+     */
+    void (*stopScan)(uint8_t instance);
+    
+    /**
+     * @brief Filter a scanned channel on every DMA half-buffer
+     * 
+     * The filter kernel runs in the half/full transfer interrupt over the
+     * ADC_SCAN_BLOCK new samples of the channel; readRaw()/readVoltage()
+     * then return its output instead of the newest raw sample.
+     * @param instance ADC instance index (0 to adc_count-1)
+     * @param channel Channel in the running scan
+     * @param filter State set up with ADCFilter_Init() (caller owned, reset here), or NULL to detach
+     * @return true if attached
+     * @note startScan() detaches all filters; attach after starting the scan
+     */
+    bool (*attachFilter)(uint8_t instance, uint8_t channel, ADCFilter_t* filter);
+    
+    /**
+     * @brief Completed half-buffers since startScan()
+     * 
+     * Increments at the DMA half and full transfer interrupts, so a change
+     * means fresh samples.
+     * @param instance ADC instance index (0 to adc_count-1)
+     * @return Block count (wraps)
+     */
+    uint32_t (*getScanCount)(uint8_t instance);
 };
 
 /* ==================== PWM Interface ==================== */
@@ -554,8 +1017,15 @@ struct PWM_t {
     
     /**
      * @brief Set PWM frequency
+     * 
+     * Solves prescaler and period in one step from the timer's real clock
+     * (APB clock, doubled when the APB prescaler is above 1), using the
+     * smallest prescaler for the finest duty resolution; 32-bit timers
+     * keep prescaler 1. Compare values are rescaled so duty cycles hold.
+     * Repeating the current frequency returns immediately.
      * @param instance Timer instance index (0 to tim_count-1)
      * @param hz Frequency in Hz
+     * @note PLT_INVALID_PARAM if hz is above the timer clock or too low for a 16-bit prescaler
      */
     void (*setFrequency)(uint8_t instance, uint32_t hz);
     
@@ -574,6 +1044,48 @@ struct PWM_t {
      * @param us Pulse width in microseconds
      */
     void (*setPulseWidth)(uint8_t instance, uint32_t channel, uint32_t us);
+    
+    /**
+     * @brief Update several channels together at the next update event
+     * 
+     * Enables compare preload on the selected channels and writes their
+     * compare registers with update events held off (CR1.UDIS), so all new
+     * values take effect in the same PWM period.
+     * @param instance Timer instance index (0 to tim_count-1)
+     * @param percent Duty cycles for CH1-CH4 (0.0 - 100.0), indexed by channel - 1
+     * @param mask Channels to update: bit 0 = CH1 ... bit 3 = CH4 (PWM_CH1 | PWM_CH3)
+     */
+    void (*setDutyCycles)(uint8_t instance, const float percent[4], uint8_t mask);
+    
+    /**
+     * @brief Like setDutyCycles() with raw compare values in timer ticks
+     * @param instance Timer instance index (0 to tim_count-1)
+     * @param compare Compare values for CH1-CH4, indexed by channel - 1
+     * @param mask Channels to update: bit 0 = CH1 ... bit 3 = CH4
+     */
+    void (*setCompares)(uint8_t instance, const uint32_t compare[4], uint8_t mask);
+    
+    /**
+     * @brief Stream a compare-value table by DMA burst, one row per update event
+     * 
+     * Each update event the timer's DMA writes the next row into CCR1..CCRn
+     * through DMAR, with no CPU involvement. With the update DMA channel in
+     * circular mode (CubeMX, word width) the table repeats until
+     * stopStream().
+     * @param instance Timer instance index (0 to tim_count-1)
+     * @param table Rows of `channels` words: {CCR1, ..., CCRn} (must stay valid while streaming)
+     * @param rows Number of rows
+     * @param channels Compare registers per row, starting at CH1 (1-4)
+     * @return true if the stream started
+     * @note Requires a DMA channel linked to the timer update request
+     */
+    bool (*streamCompares)(uint8_t instance, const uint32_t* table, uint16_t rows, uint8_t channels);
+    
+    /**
+     * @brief Stop a compare stream started by streamCompares()
+     * @param instance Timer instance index (0 to tim_count-1)
+     */
+    void (*stopStream)(uint8_t instance);
 };
 
 /* ==================== Platform Interface ==================== */
@@ -644,6 +1156,22 @@ struct Platform_t {
      * @return true if all peripherals healthy
      */
     bool (*isHealthy)(void);
+    
+    /**
+     * @brief Copy the hot-path statistics
+     * @param out Snapshot to fill
+     * @return true on success; false with PLT_NOT_SUPPORTED when built
+     *         without PLT_ENABLE_STATS, or PLT_NULL_POINTER
+     * @note Min/max/average cycles of the CAN RX interrupt, each routed
+     *       handler, Queue_Push/Pop and UART/SPI transfers, CAN receive to
+     *       dispatch latency, and queue high-water marks and drops
+     */
+    bool (*getStats)(PlatformStats_t* out);
+    
+    /**
+     * @brief Clear all statistics (no-op without PLT_ENABLE_STATS)
+     */
+    void (*resetStats)(void);
 };
 
 /* ==================== Global Singleton Objects ==================== */
@@ -0,0 +1,102 @@
+/**
+ * @file telemetry.h
+ * @brief Binary telemetry framing (COBS + CRC-16)
+ *
+ * A record is a type tag, a sequence number and up to TELEMETRY_MAX_PAYLOAD
+ * raw bytes (typically a database node struct copied as-is). The encoder
+ * appends a CRC-16/CCITT-FALSE and COBS-encodes the lot, so the only 0x00 on
+ * the wire is the frame delimiter:
+ *
+ *     COBS( type | seq | payload... | crc_lo | crc_hi ) 0x00
+ *
+ * The target only copies and frames bytes; scaling and formatting happen on
+ * the host (scripts/telemetry_decode.py). The module is pure (no HAL
+ * access); P_UART.sendRecord() encodes and sends one record.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "platform_status.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ==================== Configuration ==================== */
+
+#ifndef TELEMETRY_MAX_PAYLOAD
+#define TELEMETRY_MAX_PAYLOAD   250     ///< Largest record payload (250 keeps a frame in 256 bytes)
+#endif
+
+#define TELEMETRY_HEADER_SIZE   2       ///< Type + sequence
+#define TELEMETRY_CRC_SIZE      2       ///< CRC-16, little endian
+#define TELEMETRY_OVERHEAD      (TELEMETRY_HEADER_SIZE + TELEMETRY_CRC_SIZE)
+#define TELEMETRY_DELIMITER     0x00    ///< Frame terminator
+
+/**
+ * @brief Worst-case encoded frame size for a payload of n bytes
+ * @note One COBS code byte per 254 data bytes, plus the first code byte and the delimiter
+ */
+#define TELEMETRY_FRAME_SIZE(n) ((n) + TELEMETRY_OVERHEAD + ((n) + TELEMETRY_OVERHEAD) / 254 + 2)
+
+/* ==================== Types ==================== */
+
+/**
+ * @brief Record type tags
+ * @note Database node records carry the node struct in target memory layout
+ */
+typedef enum {
+    TELEMETRY_TYPE_TEXT           = 0x01,   ///< Log text (no terminator)
+    TELEMETRY_TYPE_CAN_TRACE      = 0x02,   ///< Whole CAN trace entries (see can_trace.h)
+    TELEMETRY_TYPE_PEDAL_NODE     = 0x10,   ///< pedal_node_t
+    TELEMETRY_TYPE_SUB_NODE       = 0x11,   ///< sub_node_t
+    TELEMETRY_TYPE_VCU_NODE       = 0x12,   ///< vcu_node_t
+    TELEMETRY_TYPE_DASHBOARD_NODE = 0x13,   ///< dashboard_node_t
+    TELEMETRY_TYPE_USER           = 0x80    ///< First tag free for application records
+} TelemetryType_t;
+
+/**
+ * @brief One decoded record
+ */
+typedef struct {
+    uint8_t  type;      ///< Record type tag
+    uint8_t  seq;       ///< Sender sequence number (wraps at 256)
+    uint16_t length;    ///< Payload bytes in data
+    uint8_t  data[TELEMETRY_MAX_PAYLOAD + TELEMETRY_OVERHEAD];  ///< Payload (decode scratch included)
+} TelemetryRecord_t;
+
+/* ==================== API ==================== */
+
+/**
+ * @brief CRC-16/CCITT-FALSE (poly 0x1021), table driven
+ * @param data Bytes to checksum
+ * @param length Number of bytes
+ * @param crc Running value; start with 0xFFFF
+ * @return Updated CRC
+ */
+uint16_t Telemetry_Crc16(const uint8_t* data, size_t length, uint16_t crc);
+
+/**
+ * @brief Encode one record into a delimited frame
+ * @param type Record type tag
+ * @param seq Sequence number
+ * @param payload Record bytes (may be NULL when length is 0)
+ * @param length Payload bytes (at most TELEMETRY_MAX_PAYLOAD)
+ * @param frame Output buffer, TELEMETRY_FRAME_SIZE(length) bytes is always enough
+ * @param frame_size Size of frame
+ * @return Encoded bytes including the delimiter, or 0 if arguments are invalid or frame is too small
+ */
+size_t Telemetry_Encode(uint8_t type, uint8_t seq, const void* payload, size_t length,
+                        uint8_t* frame, size_t frame_size);
+
+/**
+ * @brief Decode one frame back into a record
+ * @param frame Encoded bytes, with or without the trailing delimiter
+ * @param length Number of bytes in frame
+ * @param record Output record
+ * @return PLT_OK, PLT_NULL_POINTER, PLT_INVALID_PARAM (malformed COBS, short or oversized frame),
+ *         PLT_CRC_ERROR (checksum mismatch)
+ */
+plt_status_t Telemetry_Decode(const uint8_t* frame, size_t length, TelemetryRecord_t* record);
+
+#endif // TELEMETRY_H
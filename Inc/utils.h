@@ -4,30 +4,127 @@
 /* =============================== Includes ======================================= */
 #include "hashtable.h"
 #include "platform_status.h"
+#include "stats.h"
+#include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Include CMSIS core for ARM intrinsics on target platform
 #if defined(__ARM_ARCH) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARMCC_VERSION)
 #include "cmsis_gcc.h"
 #endif
 
+/*========================= Critical sections =========================*/
+
+/**
+ * @brief Enter critical section (disable interrupts)
+ * @note For ARM Cortex-M: disables interrupts and returns PRIMASK state
+ *       For testing: no-op stub that returns 0
+ */
+static inline uint32_t Queue_EnterCritical(void) {
+#if defined(__ARM_ARCH) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARMCC_VERSION)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+#else
+    // Stub for unit testing on x86/x64
+    return 0;
+#endif
+}
+
+/**
+ * @brief Exit critical section (restore interrupts)
+ * @note For ARM Cortex-M: restores PRIMASK state
+ *       For testing: no-op stub
+ */
+static inline void Queue_ExitCritical(uint32_t primask) {
+#if defined(__ARM_ARCH) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARMCC_VERSION)
+    __set_PRIMASK(primask);
+#else
+    // Stub for unit testing on x86/x64
+    (void)primask; // Suppress unused parameter warning
+#endif
+}
+
 /*========================= Queue related definitions =========================*/
 
+/**
+ * @brief Queue concurrency mode
+ */
+typedef enum {
+    QUEUE_MODE_LOCKED = 0,  ///< Any producer/consumer mix, guarded by interrupt masking
+    QUEUE_MODE_SPSC         ///< One producer and one consumer, lock-free (no IRQ masking)
+} QueueMode_t;
+
 /**
  * @brief Thread-safe circular queue for ISR-safe message passing
  * 
- * This queue uses atomic operations (interrupt disable/enable) to ensure
- * thread safety between ISRs and main loop.
+ * In QUEUE_MODE_LOCKED the queue uses atomic operations (interrupt
+ * disable/enable) to ensure thread safety between ISRs and main loop.
+ * 
+ * In QUEUE_MODE_SPSC exactly one context pushes (typically an ISR) and exactly
+ * one context pops (typically the main loop). Head is written only by the
+ * producer and tail only by the consumer, ordered with memory barriers, so no
+ * interrupts are ever masked. Capacity must be a power of two; head and tail
+ * are free-running and wrapped with a mask instead of a modulo.
  */
 typedef struct{
     void* buffer;           ///< Contiguous buffer for all items
     size_t item_size;       ///< Size of each item in bytes
-    volatile size_t head;   ///< Write index (producer)
-    volatile size_t tail;   ///< Read index (consumer)
+    volatile size_t head;   ///< Write index (producer), free-running in SPSC mode
+    volatile size_t tail;   ///< Read index (consumer), free-running in SPSC mode
     size_t capacity;        ///< Maximum number of items
-    volatile size_t count;  ///< Current number of items
+    volatile size_t count;  ///< Current number of items (LOCKED mode only)
+    size_t mask;            ///< capacity - 1 (SPSC mode only)
+    QueueMode_t mode;       ///< Concurrency mode selected at init
+    bool owns_buffer;       ///< true if buffer was heap-allocated by Queue_Init
+    #if PLT_ENABLE_STATS
+    size_t high_water;      ///< Deepest fill seen
+    volatile uint32_t drops;    ///< Pushes and reservations refused because the queue was full
+    #endif
 } Queue_t;
 
+/**
+ * @brief Contiguous run of queue slots returned by Queue_PeekBatch()
+ */
+typedef struct {
+    void* data;             ///< First item of the run
+    size_t count;           ///< Number of items in the run
+} Queue_Span_t;
+
+/**
+ * @brief Compile-time initializer for a queue over caller-provided storage
+ * @param storage Array of items backing the queue
+ * @param type Item type
+ * @param cap Number of items in storage
+ * @param qmode QUEUE_MODE_LOCKED or QUEUE_MODE_SPSC
+ */
+#define QUEUE_INITIALIZER(storage, type, cap, qmode) { \
+    .buffer = (storage), .item_size = sizeof(type), .head = 0, .tail = 0, \
+    .capacity = (cap), .count = 0, .mask = (cap) - 1, .mode = (qmode), \
+    .owns_buffer = false }
+
+/**
+ * @brief Define a file-scope queue with storage in .bss (no heap)
+ * 
+ * @example
+ * QUEUE_DEFINE(can_log, CANMessage_t, 64);
+ * Queue_Push(&can_log, &msg);
+ */
+#define QUEUE_DEFINE(name, type, cap) \
+    _Static_assert((cap) > 0 && (cap) <= 1024, #name ": capacity out of range"); \
+    static type name##_storage[(cap)]; \
+    static Queue_t name = QUEUE_INITIALIZER(name##_storage, type, (cap), QUEUE_MODE_LOCKED)
+
+/**
+ * @brief Define a file-scope lock-free SPSC queue with storage in .bss
+ */
+#define QUEUE_DEFINE_SPSC(name, type, cap) \
+    _Static_assert((cap) > 0 && (cap) <= 1024, #name ": capacity out of range"); \
+    _Static_assert(((cap) & ((cap) - 1)) == 0, #name ": SPSC capacity must be a power of two"); \
+    static type name##_storage[(cap)]; \
+    static Queue_t name = QUEUE_INITIALIZER(name##_storage, type, (cap), QUEUE_MODE_SPSC)
+
 
 /*========================= Queue related function prototypes =========================*/
 
@@ -40,6 +137,28 @@ typedef struct{
  */
 plt_status_t Queue_Init(Queue_t* queue, size_t item_size, size_t capacity);
 
+/**
+ * @brief Initialize a lock-free single-producer/single-consumer queue
+ * @param queue Pointer to queue structure
+ * @param item_size Size of each item in bytes
+ * @param capacity Maximum number of items (must be a power of two)
+ * @return PLT_OK on success, PLT_INVALID_PARAM if capacity is not a power of two
+ * @note Only one context may push and only one context may pop
+ */
+plt_status_t Queue_InitSPSC(Queue_t* queue, size_t item_size, size_t capacity);
+
+/**
+ * @brief Initialize a queue over caller-provided storage (no heap allocation)
+ * @param queue Pointer to queue structure
+ * @param buffer Storage of at least item_size * capacity bytes
+ * @param item_size Size of each item in bytes
+ * @param capacity Maximum number of items
+ * @param mode QUEUE_MODE_LOCKED or QUEUE_MODE_SPSC (power-of-two capacity)
+ * @return PLT_OK on success, error code otherwise
+ * @note Re-initializing only resets indices; the storage is never freed
+ */
+plt_status_t Queue_InitStatic(Queue_t* queue, void* buffer, size_t item_size, size_t capacity, QueueMode_t mode);
+
 /**
  * @brief Push an item into the queue (thread-safe)
  * @param queue Pointer to queue structure
@@ -64,6 +183,69 @@ plt_status_t Queue_Pop(Queue_t* queue, void* data);
  */
 plt_status_t Queue_Peek(Queue_t* queue, void* data);
 
+/**
+ * @brief Push up to n items with a single lock/index update
+ * @param queue Pointer to queue structure
+ * @param items Pointer to n contiguous items
+ * @param n Number of items to push
+ * @return Number of items actually pushed (less than n if the queue fills)
+ */
+size_t Queue_PushBatch(Queue_t* queue, const void* items, size_t n);
+
+/**
+ * @brief Pop up to max items with a single lock/index update
+ * @param queue Pointer to queue structure
+ * @param items Destination for up to max contiguous items
+ * @param max Maximum number of items to pop
+ * @return Number of items actually popped
+ */
+size_t Queue_PopBatch(Queue_t* queue, void* items, size_t max);
+
+/**
+ * @brief Expose pending items in place as at most two contiguous spans
+ * 
+ * Items stay owned by the queue until Queue_Release() is called, so the
+ * producer cannot overwrite them while they are being processed.
+ * 
+ * @param queue Pointer to queue structure
+ * @param spans Receives up to two spans (second span is used when the run wraps)
+ * @param max Maximum number of items to expose (0 = all pending)
+ * @return Total number of items across both spans
+ * @note Consumer-side only; must be paired with Queue_Release()
+ */
+size_t Queue_PeekBatch(Queue_t* queue, Queue_Span_t spans[2], size_t max);
+
+/**
+ * @brief Release items previously exposed by Queue_PeekBatch()
+ * @param queue Pointer to queue structure
+ * @param n Number of items to release (single tail update)
+ * @return PLT_OK on success, PLT_UNDERFLOW if n exceeds the pending count
+ */
+plt_status_t Queue_Release(Queue_t* queue, size_t n);
+
+/**
+ * @brief Reserve the next free slot for in-place writing (zero-copy produce)
+ * @param queue Pointer to queue structure
+ * @return Pointer to the slot, or NULL if the queue is full
+ * @note Producer-side only. The slot becomes visible to the consumer on Queue_Commit()
+ */
+void* Queue_Reserve(Queue_t* queue);
+
+/**
+ * @brief Publish the slot obtained from Queue_Reserve()
+ * @param queue Pointer to queue structure
+ * @return PLT_OK on success, PLT_QUEUE_FULL if no slot was reservable
+ */
+plt_status_t Queue_Commit(Queue_t* queue);
+
+/**
+ * @brief Access the oldest item in place (zero-copy consume)
+ * @param queue Pointer to queue structure
+ * @return Pointer to the item, or NULL if the queue is empty
+ * @note Consumer-side only. Free the slot with Queue_Release(queue, 1)
+ */
+void* Queue_PeekSlot(Queue_t* queue);
+
 /**
  * @brief Get current number of items in queue
  * @param queue Pointer to queue structure
@@ -84,9 +266,42 @@ bool Queue_IsFull(Queue_t* queue);
 /**
  * @brief Free queue memory
  * @param queue Pointer to queue structure
+ * @note Storage provided via Queue_InitStatic()/QUEUE_DEFINE() is only detached
  */
 void Queue_Free(Queue_t* queue);
 
+/*========================= Formatting =========================*/
+
+/**
+ * @brief Output callback for plt_vformat()
+ * @param context Caller context passed through unchanged
+ * @param data Next piece of output (not NUL-terminated)
+ * @param length Bytes in data (never 0)
+ */
+typedef void (*plt_format_sink_t)(void* context, const char* data, size_t length);
+
+/**
+ * @brief printf-style formatter that streams its output to a sink
+ * @param sink Output callback, called once per literal run, field or padding block
+ * @param context Passed to every sink call
+ * @param fmt Format string
+ * @param args Arguments
+ * @return Number of characters produced, or -1 on NULL sink/fmt
+ * @note No output buffer and no length limit; stack use is a few dozen bytes.
+ *       Supports flags "-+ 0#", width and precision (including '*'), length
+ *       modifiers hh/h/l/ll/z/j/t and conversions d i u x X o c s p f F e E g G %
+ *       (a/A print as e/E). %f, %e and the fixed form of %g print at most
+ *       9 fraction digits; %f needs magnitudes below 2^64; exact halfway
+ *       values round away from zero. An unsupported conversion (%n, %Lf, ...) is
+ *       printed as written and ends the output.
+ */
+int plt_vformat(plt_format_sink_t sink, void* context, const char* fmt, va_list args);
+
+/**
+ * @brief Variadic form of plt_vformat()
+ */
+int plt_format(plt_format_sink_t sink, void* context, const char* fmt, ...);
+
 
 
 
@@ -0,0 +1,153 @@
+/**
+ * @file adc_filter.c
+ * @brief Fixed-point ADC filter kernels
+ *
+ * Each kernel has its own loop so the per-sample work is a handful of adds
+ * and shifts with no branch on the filter type. CIC registers are unsigned
+ * and allowed to wrap: the comb differences come out right as long as the
+ * true result fits in 32 bits, which the order * shift limit guarantees.
+ */
+
+#include "adc_filter.h"
+#include <string.h>
+
+plt_status_t ADCFilter_Init(ADCFilter_t* filter, ADCFilterType_t type, uint8_t shift, uint8_t order) {
+    if (filter == NULL) {
+        return PLT_NULL_POINTER;
+    }
+
+    switch (type) {
+        case ADCFILTER_NONE:
+            shift = 0;
+            break;
+        case ADCFILTER_MOVING_AVERAGE:
+            if (shift < 1 || shift > ADCFILTER_MAX_WINDOW_SHIFT) return PLT_INVALID_PARAM;
+            break;
+        case ADCFILTER_CIC:
+            if (shift < 1 || order < 1 || order > ADCFILTER_MAX_CIC_ORDER ||
+                order * shift > ADCFILTER_CIC_GROWTH_BITS) {
+                return PLT_INVALID_PARAM;
+            }
+            break;
+        case ADCFILTER_IIR:
+            if (shift < 1 || shift > ADCFILTER_MAX_IIR_SHIFT) return PLT_INVALID_PARAM;
+            break;
+        default:
+            return PLT_INVALID_PARAM;
+    }
+
+    filter->type = (uint8_t)type;
+    filter->shift = shift;
+    filter->order = (type == ADCFILTER_CIC) ? order : 0;
+    ADCFilter_Reset(filter);
+    return PLT_OK;
+}
+
+void ADCFilter_Reset(ADCFilter_t* filter) {
+    if (filter == NULL) return;
+
+    filter->primed = false;
+    filter->count = 0;
+    filter->output = 0;
+    filter->acc = 0;
+    memset(filter->integ, 0, sizeof(filter->integ));
+    memset(filter->comb, 0, sizeof(filter->comb));
+}
+
+/* ==================== Kernels ==================== */
+
+static void Filter_MovingAverage(ADCFilter_t* f, const volatile uint16_t* x, uint16_t count, uint16_t stride) {
+    uint16_t mask = (uint16_t)((1u << f->shift) - 1u);
+    uint32_t sum = f->acc;
+    uint16_t pos = f->count;
+
+    for (uint16_t i = 0; i < count; i++, x += stride) {
+        uint16_t sample = *x;
+        sum += (uint32_t)sample - f->window[pos];
+        f->window[pos] = sample;
+        pos = (uint16_t)((pos + 1u) & mask);
+    }
+
+    f->acc = sum;
+    f->count = pos;
+    f->output = (uint16_t)((sum + (mask + 1u) / 2u) >> f->shift);
+}
+
+static void Filter_Cic(ADCFilter_t* f, const volatile uint16_t* x, uint16_t count, uint16_t stride) {
+    uint16_t decimation = (uint16_t)(1u << f->shift);
+    uint8_t order = f->order;
+
+    for (uint16_t i = 0; i < count; i++, x += stride) {
+        uint32_t v = *x;
+        for (uint8_t s = 0; s < order; s++) {
+            f->integ[s] += v;
+            v = f->integ[s];
+        }
+
+        if (++f->count < decimation) continue;
+        f->count = 0;
+
+        for (uint8_t s = 0; s < order; s++) {
+            uint32_t delayed = f->comb[s];
+            f->comb[s] = v;
+            v -= delayed;
+        }
+        f->output = (uint16_t)(v >> (order * f->shift));
+    }
+}
+
+static void Filter_Iir(ADCFilter_t* f, const volatile uint16_t* x, uint16_t count, uint16_t stride) {
+    uint32_t y = f->acc;
+    uint8_t shift = f->shift;
+
+    // Unsigned Q16 covers the full 16-bit input range; step toward the sample
+    for (uint16_t i = 0; i < count; i++, x += stride) {
+        uint32_t target = (uint32_t)*x << 16;
+        if (target >= y) {
+            y += (target - y) >> shift;
+        } else {
+            y -= (y - target) >> shift;
+        }
+    }
+
+    f->acc = y;
+    uint32_t rounded = (y >> 16) + ((y >> 15) & 1u);
+    f->output = (uint16_t)((rounded > 0xFFFFu) ? 0xFFFFu : rounded);
+}
+
+uint16_t ADCFilter_Process(ADCFilter_t* filter, const volatile uint16_t* samples, uint16_t count, uint16_t stride) {
+    if (filter == NULL || samples == NULL || count == 0) {
+        return (filter != NULL) ? filter->output : 0;
+    }
+    if (stride == 0) stride = 1;
+
+    // Start from the input level instead of ramping up from zero
+    if (!filter->primed) {
+        filter->primed = true;
+        uint16_t first = samples[0];
+        if (filter->type == ADCFILTER_MOVING_AVERAGE) {
+            for (uint16_t i = 0; i < (1u << filter->shift); i++) {
+                filter->window[i] = first;
+            }
+            filter->acc = (uint32_t)first << filter->shift;
+        } else if (filter->type == ADCFILTER_IIR) {
+            filter->acc = (uint32_t)first << 16;
+        }
+    }
+
+    switch (filter->type) {
+        case ADCFILTER_MOVING_AVERAGE:
+            Filter_MovingAverage(filter, samples, count, stride);
+            break;
+        case ADCFILTER_CIC:
+            Filter_Cic(filter, samples, count, stride);
+            break;
+        case ADCFILTER_IIR:
+            Filter_Iir(filter, samples, count, stride);
+            break;
+        default:
+            filter->output = samples[(size_t)(count - 1u) * stride];
+            break;
+    }
+    return filter->output;
+}
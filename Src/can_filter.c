@@ -0,0 +1,275 @@
+/**
+ * @file can_filter.c
+ * @brief bxCAN acceptance-filter planner implementation
+ *
+ * Works on "cubes": an id/mask pair where mask bits set to 1 must match.
+ * Routed IDs are first split into aligned power-of-two blocks (a contiguous
+ * routeRange collapses to a handful of cubes), then adjacent cubes are merged
+ * greedily, cheapest first, until the plan fits the available banks.
+ */
+
+#include "can_filter.h"
+#include <string.h>
+
+typedef struct {
+    uint16_t id;    ///< Base ID (id & mask == id)
+    uint16_t mask;  ///< 1 = bit must match
+} CANFilterCube_t;
+
+static CANFilterCube_t cubes[CANFILTER_MAX_CUBES];
+static size_t cube_count;
+
+/* ==================== Bitmap ==================== */
+
+void CANFilter_BitmapSet(uint8_t* bitmap, uint16_t id) {
+    if (bitmap == NULL || id >= CANFILTER_ID_SPACE) return;
+    bitmap[id >> 3] |= (uint8_t)(1u << (id & 7));
+}
+
+bool CANFilter_BitmapTest(const uint8_t* bitmap, uint16_t id) {
+    if (bitmap == NULL || id >= CANFILTER_ID_SPACE) return false;
+    return (bitmap[id >> 3] & (1u << (id & 7))) != 0;
+}
+
+/* ==================== Cube helpers ==================== */
+
+static uint32_t Cube_Size(uint16_t mask) {
+    uint32_t free_bits = 0;
+    for (uint16_t m = (uint16_t)(~mask & CANFILTER_EXACT_MASK); m != 0; m &= (uint16_t)(m - 1)) {
+        free_bits++;
+    }
+    return 1u << free_bits;
+}
+
+static CANFilterCube_t Cube_Merge(CANFilterCube_t a, CANFilterCube_t b) {
+    CANFilterCube_t merged;
+    merged.mask = (uint16_t)(a.mask & b.mask & ~(a.id ^ b.id) & CANFILTER_EXACT_MASK);
+    merged.id = (uint16_t)(a.id & merged.mask);
+    return merged;
+}
+
+static bool Cube_Contains(CANFilterCube_t outer, CANFilterCube_t inner) {
+    return (inner.mask & outer.mask) == outer.mask && (inner.id & outer.mask) == outer.id;
+}
+
+static void Cube_Remove(size_t index) {
+    memmove(&cubes[index], &cubes[index + 1], (cube_count - index - 1) * sizeof(CANFilterCube_t));
+    cube_count--;
+}
+
+/**
+ * @brief Merge the adjacent pair that admits the fewest extra IDs
+ */
+static void Cube_MergeBest(void) {
+    size_t best = 0;
+    int32_t best_cost = INT32_MAX;
+
+    for (size_t i = 0; i + 1 < cube_count; i++) {
+        CANFilterCube_t merged = Cube_Merge(cubes[i], cubes[i + 1]);
+        int32_t cost = (int32_t)Cube_Size(merged.mask) -
+                       (int32_t)Cube_Size(cubes[i].mask) - (int32_t)Cube_Size(cubes[i + 1].mask);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = i;
+        }
+    }
+
+    cubes[best] = Cube_Merge(cubes[best], cubes[best + 1]);
+    Cube_Remove(best + 1);
+
+    // Drop cubes the wider group now covers
+    CANFilterCube_t merged = cubes[best];
+    for (size_t j = cube_count; j-- > 0;) {
+        if (j != best && Cube_Contains(merged, cubes[j])) {
+            Cube_Remove(j);
+            if (j < best) best--;
+        }
+    }
+
+    // Keep cubes ordered by base ID so "adjacent" stays meaningful
+    while (best > 0 && cubes[best - 1].id > cubes[best].id) {
+        CANFilterCube_t tmp = cubes[best - 1];
+        cubes[best - 1] = cubes[best];
+        cubes[best] = tmp;
+        best--;
+    }
+}
+
+static void Cube_Add(uint16_t id, uint16_t mask) {
+    if (cube_count == CANFILTER_MAX_CUBES) {
+        Cube_MergeBest();
+    }
+    cubes[cube_count].id = id;
+    cubes[cube_count].mask = mask;
+    cube_count++;
+}
+
+/**
+ * @brief Banks needed: masked cubes pair up, exact IDs go four per list bank
+ */
+static uint8_t Cube_BanksNeeded(void) {
+    size_t exact = 0;
+    for (size_t i = 0; i < cube_count; i++) {
+        if (cubes[i].mask == CANFILTER_EXACT_MASK) exact++;
+    }
+    size_t masked = cube_count - exact;
+    size_t spare = masked & 1;  // second slot of the last mask bank
+    size_t list = (exact > spare) ? (exact - spare + 3) / 4 : 0;
+    return (uint8_t)((masked + 1) / 2 + list);
+}
+
+/* ==================== Planner ==================== */
+
+/**
+ * @brief Append banks covering a bitmap to a plan, using at most budget of them
+ * @return PLT_OK, or PLT_INVALID_PARAM if the bitmap is empty
+ */
+static plt_status_t Plan_Append(const uint8_t* bitmap, uint8_t budget, uint8_t fifo, CANFilterPlan_t* plan) {
+    cube_count = 0;
+
+    // Split every run of routed IDs into aligned power-of-two blocks
+    uint16_t id = 0;
+    while (id < CANFILTER_ID_SPACE) {
+        if (!CANFilter_BitmapTest(bitmap, id)) {
+            id++;
+            continue;
+        }
+        uint16_t end = id;
+        while (end + 1 < CANFILTER_ID_SPACE && CANFilter_BitmapTest(bitmap, (uint16_t)(end + 1))) {
+            end++;
+        }
+        plan->routed_ids = (uint16_t)(plan->routed_ids + (end - id + 1));
+
+        while (id <= end) {
+            uint16_t size = 1;
+            while ((id & (2 * size - 1)) == 0 && id + 2 * size - 1 <= end && 2 * size <= CANFILTER_ID_SPACE) {
+                size *= 2;
+            }
+            Cube_Add(id, (uint16_t)(CANFILTER_EXACT_MASK & ~(size - 1)));
+            id = (uint16_t)(id + size);
+        }
+    }
+
+    if (cube_count == 0) {
+        return PLT_INVALID_PARAM;
+    }
+
+    while (Cube_BanksNeeded() > budget) {
+        Cube_MergeBest();
+    }
+
+    // Emit mask banks first; an odd one out takes an exact ID in its spare slot
+    uint16_t exact_ids[CANFILTER_MAX_CUBES];
+    size_t exact = 0;
+    CANFilterBank_t* bank = NULL;
+    uint8_t slot = 0;
+
+    for (size_t i = 0; i < cube_count; i++) {
+        if (cubes[i].mask == CANFILTER_EXACT_MASK) {
+            exact_ids[exact++] = cubes[i].id;
+            continue;
+        }
+        if (slot == 0) {
+            bank = &plan->banks[plan->bank_count++];
+            bank->mode = CANFILTER_MASK16;
+            bank->fifo = fifo;
+        }
+        bank->id[slot] = cubes[i].id;
+        bank->mask[slot] = cubes[i].mask;
+        slot ^= 1;
+    }
+
+    size_t next = 0;
+    if (slot == 1) {
+        // Fill the spare pair with an exact ID, or repeat the first pair
+        if (exact > 0) {
+            bank->id[1] = exact_ids[next++];
+            bank->mask[1] = CANFILTER_EXACT_MASK;
+        } else {
+            bank->id[1] = bank->id[0];
+            bank->mask[1] = bank->mask[0];
+        }
+    }
+
+    while (next < exact) {
+        bank = &plan->banks[plan->bank_count++];
+        bank->mode = CANFILTER_LIST16;
+        bank->fifo = fifo;
+        for (uint8_t k = 0; k < 4; k++) {
+            // Unused list entries repeat the last ID
+            bank->id[k] = exact_ids[(next < exact) ? next++ : exact - 1];
+        }
+    }
+
+    return PLT_OK;
+}
+
+plt_status_t CANFilter_PlanFifo(const uint8_t* bitmap, const uint8_t* fast, uint8_t max_banks, CANFilterPlan_t* plan) {
+    if (bitmap == NULL || plan == NULL) {
+        return PLT_NULL_POINTER;
+    }
+
+    if (max_banks == 0 || max_banks > CANFILTER_MAX_BANKS) {
+        return PLT_INVALID_PARAM;
+    }
+
+    memset(plan, 0, sizeof(*plan));
+
+    // Split the routes into the FIFO1 set and everything else
+    static uint8_t fifo1[CANFILTER_BITMAP_BYTES];
+    static uint8_t fifo0[CANFILTER_BITMAP_BYTES];
+    bool any_fast = false;
+    bool any_slow = false;
+    for (size_t i = 0; i < CANFILTER_BITMAP_BYTES; i++) {
+        uint8_t f = (fast != NULL) ? fast[i] : 0;
+        fifo1[i] = (uint8_t)(bitmap[i] & f);
+        fifo0[i] = (uint8_t)(bitmap[i] & ~f);
+        any_fast |= (fifo1[i] != 0);
+        any_slow |= (fifo0[i] != 0);
+    }
+
+    if (!any_fast && !any_slow) {
+        return PLT_INVALID_PARAM;
+    }
+
+    if (any_fast) {
+        uint8_t budget = (uint8_t)(any_slow ? max_banks - 1 : max_banks);
+        if (budget == 0) {
+            return PLT_INVALID_PARAM;   // One bank cannot serve two FIFOs
+        }
+        Plan_Append(fifo1, budget, 1, plan);
+    }
+    if (any_slow) {
+        Plan_Append(fifo0, (uint8_t)(max_banks - plan->bank_count), 0, plan);
+    }
+
+    for (uint16_t check = 0; check < CANFILTER_ID_SPACE; check++) {
+        if (!CANFilter_BitmapTest(bitmap, check) && CANFilter_Accepts(plan, check)) {
+            plan->extra_ids++;
+        }
+    }
+
+    return PLT_OK;
+}
+
+plt_status_t CANFilter_Plan(const uint8_t* bitmap, uint8_t max_banks, CANFilterPlan_t* plan) {
+    return CANFilter_PlanFifo(bitmap, NULL, max_banks, plan);
+}
+
+bool CANFilter_Accepts(const CANFilterPlan_t* plan, uint16_t id) {
+    if (plan == NULL) return false;
+
+    for (uint8_t b = 0; b < plan->bank_count; b++) {
+        const CANFilterBank_t* bank = &plan->banks[b];
+        if (bank->mode == CANFILTER_LIST16) {
+            for (uint8_t k = 0; k < 4; k++) {
+                if (bank->id[k] == id) return true;
+            }
+        } else {
+            for (uint8_t k = 0; k < 2; k++) {
+                if (((id ^ bank->id[k]) & bank->mask[k]) == 0) return true;
+            }
+        }
+    }
+    return false;
+}
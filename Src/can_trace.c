@@ -0,0 +1,126 @@
+/**
+ * @file can_trace.c
+ * @brief Compact binary CAN trace format implementation
+ *
+ * Times are deltas in LEB128 (7 bits per byte, low group first, high bit set
+ * on every byte but the last), so frames less than 16 ms apart spend two
+ * bytes on their timestamp and a trace never needs an absolute clock.
+ */
+
+#include "can_trace.h"
+#include <string.h>
+
+static const uint8_t trace_magic[4] = {'C', 'T', 'R', 'C'};
+
+#define TRACE_DLC_MASK      0x0Fu
+#define TRACE_INSTANCE_POS  4
+#define TRACE_RESERVED_MASK 0xC0u
+#define TRACE_VARINT_MAX    5       // 32 bits in 7-bit groups
+
+/* ==================== Header ==================== */
+
+size_t CANTrace_WriteHeader(uint8_t* out, size_t size) {
+    if (out == NULL || size < CAN_TRACE_HEADER_SIZE) {
+        return 0;
+    }
+
+    memcpy(out, trace_magic, sizeof(trace_magic));
+    out[4] = CAN_TRACE_VERSION;
+    out[5] = out[6] = out[7] = 0;
+    return CAN_TRACE_HEADER_SIZE;
+}
+
+plt_status_t CANTrace_CheckHeader(const uint8_t* in, size_t length) {
+    if (in == NULL) {
+        return PLT_NULL_POINTER;
+    }
+    if (length < CAN_TRACE_HEADER_SIZE || memcmp(in, trace_magic, sizeof(trace_magic)) != 0) {
+        return PLT_INVALID_PARAM;
+    }
+    if (in[4] > CAN_TRACE_VERSION) {
+        return PLT_NOT_SUPPORTED;
+    }
+    return PLT_OK;
+}
+
+/* ==================== Entries ==================== */
+
+size_t CANTrace_Encode(const CANTraceFrame_t* frame, uint8_t* out, size_t size) {
+    if (frame == NULL || out == NULL || frame->id > 0x7FF || frame->length > 8 ||
+        frame->instance > CAN_TRACE_MAX_INSTANCE) {
+        return 0;
+    }
+
+    // Size first, so a short buffer is left untouched
+    size_t varint = 1;
+    for (uint32_t v = frame->delta_us >> 7; v != 0; v >>= 7) {
+        varint++;
+    }
+    size_t total = 3 + varint + frame->length;
+    if (total > size) {
+        return 0;
+    }
+
+    size_t pos = 0;
+    out[pos++] = (uint8_t)(frame->length | (frame->instance << TRACE_INSTANCE_POS));
+    out[pos++] = (uint8_t)frame->id;
+    out[pos++] = (uint8_t)(frame->id >> 8);
+
+    uint32_t v = frame->delta_us;
+    while (v >= 0x80) {
+        out[pos++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[pos++] = (uint8_t)v;
+
+    memcpy(&out[pos], frame->data, frame->length);
+    return total;
+}
+
+plt_status_t CANTrace_Decode(const uint8_t* in, size_t length, CANTraceFrame_t* frame, size_t* consumed) {
+    if (in == NULL || frame == NULL || consumed == NULL) {
+        return PLT_NULL_POINTER;
+    }
+    if (length < 4) {
+        return PLT_UNDERFLOW;
+    }
+
+    uint8_t flags = in[0];
+    uint16_t id = (uint16_t)(in[1] | (in[2] << 8));
+    if ((flags & TRACE_RESERVED_MASK) != 0 || (flags & TRACE_DLC_MASK) > 8 || id > 0x7FF) {
+        return PLT_INVALID_PARAM;
+    }
+
+    size_t pos = 3;
+    uint32_t delta = 0;
+    for (uint8_t shift = 0; ; shift += 7) {
+        if (pos >= length) {
+            return PLT_UNDERFLOW;
+        }
+        if (pos - 3 >= TRACE_VARINT_MAX) {
+            return PLT_INVALID_PARAM;
+        }
+        uint8_t byte = in[pos++];
+        if (shift == 28 && (byte & 0x70) != 0) {
+            return PLT_INVALID_PARAM;   // Bits above 32
+        }
+        delta |= (uint32_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+
+    uint8_t dlc = flags & TRACE_DLC_MASK;
+    if (pos + dlc > length) {
+        return PLT_UNDERFLOW;
+    }
+
+    frame->delta_us = delta;
+    frame->id = id;
+    frame->instance = (uint8_t)(flags >> TRACE_INSTANCE_POS) & CAN_TRACE_MAX_INSTANCE;
+    frame->length = dlc;
+    memset(frame->data, 0, sizeof(frame->data));
+    memcpy(frame->data, &in[pos], dlc);
+    *consumed = pos + dlc;
+    return PLT_OK;
+}
@@ -1,55 +1,93 @@
 
 #include "database.h"
 #include "DbSetFunctions.h"
+#include "utils.h"
+#include <stddef.h>
 
 
 /* =============================== Global Variables =============================== */
 static database_t* pMainDB = NULL;
 
+#ifdef DB_SECTION
+#define DB_STORAGE_ATTR __attribute__((section(DB_SECTION))) // e.g. -DDB_SECTION=\".ccmram\"
+#else
+#define DB_STORAGE_ATTR
+#endif
+
+static database_block_t db_storage DB_STORAGE_ATTR;
+
+_Static_assert(offsetof(vcu_node_t, inverters) == 0, "db_ReadVcu expects inverters[] first in vcu_node_t");
+
 /* ========================== Function Definitions ============================ */
+/**
+ * @brief Point the database header at the nodes of its block
+ * @retval Pointer to the database header inside the block
+ */
+static database_t* db_Layout(database_block_t* block, uint8_t heap)
+{
+    memset(block, 0, sizeof(database_block_t));
+    block->db.pedal_node = &block->pedal_node;
+    block->db.sub_node = &block->sub_node;
+    block->db.vcu_node = &block->vcu_node;
+    block->db.dashboard_node = &block->dashboard_node;
+    block->db.heap = heap;
+    return &block->db;
+}
+
 /**
  * @brief Initialize the database
  * @retval Pointer to the initialized database
  * @note This function is used to initialize the database
+ * @note Uses one static block (no heap); placed in DB_SECTION when defined.
+ *       Calling it again clears the database.
  */
 database_t* db_Init()
 {
-   pMainDB = db_AllocateMemory();
+   pMainDB = db_Layout(&db_storage, 0);
    DbSetFunctionsInit();
    return pMainDB;
 }
 
+/**
+ * @brief Initialize the database inside a caller-provided region
+ * @param region Start of the region, aligned to _Alignof(database_block_t)
+ * @param size Region size in bytes, at least DB_REGION_SIZE
+ * @retval Pointer to the initialized database, NULL if the region does not fit
+ * @note The region is cleared here, so it may live in RAM the startup code
+ *       does not zero (CCM, DTCM).
+ */
+database_t* db_InitInRegion(void* region, size_t size)
+{
+    if (region == NULL || size < sizeof(database_block_t) ||
+        ((uintptr_t)region % _Alignof(database_block_t)) != 0) {
+        return NULL;
+    }
+
+    pMainDB = db_Layout((database_block_t*)region, 0);
+    DbSetFunctionsInit();
+    return pMainDB;
+}
+
 /**
  * @brief Allocate memory for the database
  * @retval Pointer to the allocated database
+ * @note One heap allocation for the header and all nodes, aligned to
+ *       _Alignof(database_block_t) (calloc only guarantees max_align_t,
+ *       which is less than a DB_ALIGN of 32)
  */
 database_t* db_AllocateMemory() 
 {
-database_t* db = (database_t*)calloc(1, sizeof(database_t));
-if (db == NULL) {return NULL;}  // Handle allocation failure
+// sizeof is a multiple of the alignment, as aligned_alloc requires; db_Layout clears the block
+database_block_t* block = (database_block_t*)aligned_alloc(_Alignof(database_block_t), sizeof(database_block_t));
+if (block == NULL) {return NULL;}  // Handle allocation failure
 
-//Initialize Pedal node
-db->pedal_node = (pedal_node_t*)calloc(1, sizeof(pedal_node_t));
-if (db->pedal_node == NULL) {free(db);return NULL;} // Handle allocation failure
-
-//Initialize Sub node
-db->sub_node = (sub_node_t*)calloc(1, sizeof(sub_node_t));
-if (db->sub_node == NULL) {free(db->pedal_node);free(db);return NULL;}  // Handle allocation failure
-
-//Initialize VCU node
-db->vcu_node = (vcu_node_t*)calloc(1, sizeof(vcu_node_t));
-if (db->vcu_node == NULL) {free(db->sub_node);free(db->pedal_node);free(db);return NULL;} // Handle allocation failure
-
-//Initialize Dashboard node
-db->dashboard_node = (dashboard_node_t*)calloc(1, sizeof(dashboard_node_t));
-if (db->dashboard_node == NULL) {free(db->vcu_node);free(db->sub_node);free(db->pedal_node);free(db);return NULL;} // Handle allocation failure
-
-return db;
+return db_Layout(block, 1);
 }
 
 /**
  * @brief Free memory allocated for the database
  * @param db_ptr Pointer to the database to be freed
+ * @note Static and region databases are left alone
  */
 void db_FreeMemory(database_t* db_ptr){
     
@@ -57,14 +95,10 @@ void db_FreeMemory(database_t* db_ptr){
         return; // NULL pointer protection
     }
     
-    //free memory of db members from the heap
-    free(db_ptr->pedal_node);
-    free(db_ptr->dashboard_node);
-    free(db_ptr->sub_node);
-    free(db_ptr->vcu_node);
-
-    //free db
-    free(db_ptr);
+    // The header is the first member of its block
+    if (db_ptr->heap) {
+        free(db_ptr);
+    }
 }
 
 /**
@@ -75,3 +109,289 @@ void db_FreeMemory(database_t* db_ptr){
 database_t* db_GetDBPointer(){
     return pMainDB;
 }
+
+/* ========================== Snapshots ============================ */
+/*
+ * Each node has a sequence counter that a writer makes odd on entry and even
+ * again on exit. A reader copies the node between two reads of the counter
+ * and retries if a write overlapped the copy. Writers never wait, so the CAN
+ * handlers stay interrupt-safe, and readers never mask interrupts. One writer
+ * per node at a time (the CAN RX path) is assumed.
+ */
+
+/**
+ * @brief Order the counter updates against the node data
+ */
+static inline void db_Barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief Make a node update visible to readers (counter even again)
+ */
+static inline void db_Publish(database_t* db, uint8_t node)
+{
+    db_Barrier();
+    db->seq[node]++;
+}
+
+/**
+ * @brief Set change flags and run the subscribers that asked for them
+ * @note Runs in the writer's context (CAN dispatch)
+ */
+static void db_MarkDirty(database_t* db, uint32_t bits)
+{
+    uint32_t primask = Queue_EnterCritical();
+    db->dirty |= bits;
+    Queue_ExitCritical(primask);
+
+    for (uint8_t i = 0; i < db->subscriber_count; i++) {
+        uint32_t hit = db->subscribers[i].mask & bits;
+        if (hit) {db->subscribers[i].callback(db, hit);}
+    }
+}
+
+/**
+ * @brief Mark the start of a node update
+ * @param db Database
+ * @param node Node about to be written
+ */
+void db_WriteBegin(database_t* db, db_node_t node)
+{
+    if (db == NULL || node >= DB_NODE_COUNT) {return;}
+    db->seq[node]++;
+    db_Barrier();
+}
+
+/**
+ * @brief Publish a node update started with db_WriteBegin
+ * @param db Database
+ * @param node Node that was written
+ */
+void db_WriteEnd(database_t* db, db_node_t node)
+{
+    if (db == NULL || node >= DB_NODE_COUNT) {return;}
+    db_Publish(db, node);
+    db_MarkDirty(db, DB_DIRTY(node));
+}
+
+/**
+ * @brief Copy a node region while no write to it is in progress
+ * @retval true if the copy is consistent, false if writes kept overlapping it
+ */
+static bool db_SeqCopy(const database_t* db, db_node_t node, void* out, const void* src, size_t size)
+{
+    if (db == NULL || out == NULL || src == NULL) {return false;}
+
+    for (uint8_t attempt = 0; attempt < DB_SNAPSHOT_RETRIES; attempt++) {
+        uint32_t start = db->seq[node];
+        if (start & 1u) {continue;} // Writer inside (reader preempted an update)
+        db_Barrier();
+        memcpy(out, src, size);
+        db_Barrier();
+        if (db->seq[node] == start) {return true;}
+    }
+    return false;
+}
+
+/**
+ * @brief Consistent copy of the pedal node
+ * @retval true on success, false if a write kept overlapping the copy
+ */
+bool db_ReadPedal(const database_t* db, pedal_node_t* out)
+{
+    if (db == NULL) {return false;}
+    return db_SeqCopy(db, DB_NODE_PEDAL, out, db->pedal_node, sizeof(pedal_node_t));
+}
+
+/**
+ * @brief Consistent copy of the sub node
+ * @retval true on success, false if a write kept overlapping the copy
+ */
+bool db_ReadSub(const database_t* db, sub_node_t* out)
+{
+    if (db == NULL) {return false;}
+    return db_SeqCopy(db, DB_NODE_SUB, out, db->sub_node, sizeof(sub_node_t));
+}
+
+/**
+ * @brief Consistent copy of the dashboard node
+ * @retval true on success, false if a write kept overlapping the copy
+ */
+bool db_ReadDashboard(const database_t* db, dashboard_node_t* out)
+{
+    if (db == NULL) {return false;}
+    return db_SeqCopy(db, DB_NODE_DASHBOARD, out, db->dashboard_node, sizeof(dashboard_node_t));
+}
+
+/**
+ * @brief Consistent copy of one inverter
+ * @param index Inverter 0-3
+ * @retval true on success, false on a bad index or if a write kept overlapping the copy
+ */
+bool db_ReadInverter(const database_t* db, uint8_t index, inverter_t* out)
+{
+    if (db == NULL || db->vcu_node == NULL || index >= 4) {return false;}
+    return db_SeqCopy(db, (db_node_t)(DB_NODE_INV1 + index), out,
+                      &db->vcu_node->inverters[index], sizeof(inverter_t));
+}
+
+/**
+ * @brief Copy of the VCU node
+ * @retval true on success, false if a write kept overlapping one of the parts
+ * @note The VCU fields and each inverter are consistent on their own; the
+ *       parts are not taken at one instant.
+ */
+bool db_ReadVcu(const database_t* db, vcu_node_t* out)
+{
+    if (db == NULL || db->vcu_node == NULL || out == NULL) {return false;}
+
+    // Everything after inverters[] is the VCU unit
+    const size_t head = sizeof(out->inverters);
+    bool ok = db_SeqCopy(db, DB_NODE_VCU, (uint8_t*)out + head,
+                         (const uint8_t*)db->vcu_node + head, sizeof(vcu_node_t) - head);
+    for (uint8_t i = 0; i < 4; i++) {
+        ok = db_ReadInverter(db, i, &out->inverters[i]) && ok;
+    }
+    return ok;
+}
+
+/* ========================== Signal decoder ============================ */
+
+/**
+ * @brief Base address of a snapshot unit
+ */
+static uint8_t* db_UnitBase(database_t* db, uint8_t unit)
+{
+    switch (unit) {
+        case DB_NODE_PEDAL:     return (uint8_t*)db->pedal_node;
+        case DB_NODE_SUB:       return (uint8_t*)db->sub_node;
+        case DB_NODE_VCU:       return (uint8_t*)db->vcu_node;
+        case DB_NODE_DASHBOARD: return (uint8_t*)db->dashboard_node;
+        case DB_NODE_INV1:
+        case DB_NODE_INV2:
+        case DB_NODE_INV3:
+        case DB_NODE_INV4:      return (uint8_t*)&db->vcu_node->inverters[unit - DB_NODE_INV1];
+        default:                return NULL;
+    }
+}
+
+/**
+ * @brief Decode one CAN frame into the DB from its signal table
+ * @param db Database
+ * @param msg Message descriptor
+ * @param data 8 payload bytes
+ * @note One pass over the descriptors; each unit the signals touch is
+ *       published through its seqlock once.
+ */
+void db_DecodeFrame(database_t* db, const db_message_t* msg, const uint8_t* data)
+{
+    if (db == NULL || msg == NULL || data == NULL) {return;}
+
+    uint32_t changed = 0;
+    if (msg->alive != DB_NO_ALIVE && db->vcu_node->keep_alive[msg->alive] == 0) {
+        db->vcu_node->keep_alive[msg->alive] = 1;
+        changed |= DB_DIRTY_ALIVE;
+    }
+
+    uint64_t raw = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        raw |= (uint64_t)data[i] << (8u * i);
+    }
+
+    uint8_t open = DB_NODE_COUNT;
+    uint8_t* base = NULL;
+
+    for (uint8_t i = 0; i < msg->count; i++) {
+        const db_signal_t* sig = &msg->signals[i];
+        uint8_t unit = (sig->unit == DB_UNIT_MESSAGE) ? msg->unit : sig->unit;
+        if (unit != open) {
+            if (open != DB_NODE_COUNT) {db_Publish(db, open);}
+            base = db_UnitBase(db, unit);
+            if (base == NULL) {open = DB_NODE_COUNT; continue;}
+            db_WriteBegin(db, (db_node_t)unit);
+            open = unit;
+        }
+
+        int32_t value;
+        if (sig->flags & DB_SIG_CONST) {
+            value = sig->min;
+        } else {
+            uint32_t mask = (sig->length >= 32) ? 0xFFFFFFFFu : ((1u << sig->length) - 1u);
+            uint32_t bits = (uint32_t)(raw >> sig->start) & mask;
+            if ((sig->flags & DB_SIG_SIGNED) && (bits >> (sig->length - 1u)) & 1u) {
+                bits |= ~mask;
+            }
+            value = (int32_t)bits;
+        }
+
+        if (sig->flags & DB_SIG_CLAMP) {
+            value = (value < sig->min) ? sig->min : (value > sig->max) ? sig->max : value;
+        }
+
+        // Unchanged values and set latches leave the dirty bit alone
+        uint8_t* dst = base + sig->offset;
+        if (sig->width == 1) {
+            uint8_t v8 = (uint8_t)value;
+            if (*dst == v8 || ((sig->flags & DB_SIG_LATCH) && *dst != 0)) {continue;}
+            *dst = v8;
+        } else if (sig->width == 2) {
+            uint16_t v16 = (uint16_t)value, cur;
+            memcpy(&cur, dst, sizeof(cur));
+            if (cur == v16 || ((sig->flags & DB_SIG_LATCH) && cur != 0)) {continue;}
+            memcpy(dst, &v16, sizeof(v16));
+        } else {
+            uint32_t v32 = (uint32_t)value, cur;
+            memcpy(&cur, dst, sizeof(cur));
+            if (cur == v32 || ((sig->flags & DB_SIG_LATCH) && cur != 0)) {continue;}
+            memcpy(dst, &v32, sizeof(v32));
+        }
+        changed |= DB_DIRTY(unit);
+    }
+
+    if (open != DB_NODE_COUNT) {db_Publish(db, open);}
+    if (changed) {db_MarkDirty(db, changed);}
+}
+
+/* ========================== Change detection ============================ */
+
+/**
+ * @brief Take and clear change flags
+ * @param db Database
+ * @param mask DB_DIRTY_* bits to take (DB_DIRTY_ALL for every unit)
+ * @retval The bits of mask that were set since the last take
+ * @note Bits outside mask stay set for another consumer
+ */
+uint32_t db_TakeDirty(database_t* db, uint32_t mask)
+{
+    if (db == NULL) {return 0;}
+
+    uint32_t primask = Queue_EnterCritical();
+    uint32_t bits = db->dirty & mask;
+    db->dirty &= ~bits;
+    Queue_ExitCritical(primask);
+    return bits;
+}
+
+/**
+ * @brief Call a function whenever one of a field group changes
+ * @param db Database
+ * @param mask DB_DIRTY_* bits of the group, e.g. DB_DIRTY_INVERTERS
+ * @param callback Called with the changed bits of mask after each publishing write
+ * @retval true on success, false on bad arguments or when DB_MAX_SUBSCRIBERS are registered
+ * @note Callbacks run in the writer's context (CAN dispatch) after the node is
+ *       published, and do not clear the bits db_TakeDirty() returns.
+ */
+bool db_Subscribe(database_t* db, uint32_t mask, db_callback_t callback)
+{
+    if (db == NULL || callback == NULL || (mask & DB_DIRTY_ALL) == 0 ||
+        db->subscriber_count >= DB_MAX_SUBSCRIBERS) {
+        return false;
+    }
+
+    db->subscribers[db->subscriber_count].mask = mask & DB_DIRTY_ALL;
+    db->subscribers[db->subscriber_count].callback = callback;
+    db->subscriber_count++;
+    return true;
+}
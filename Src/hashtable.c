@@ -1,17 +1,23 @@
 #include "hashtable.h"
 
+_Static_assert((TABLE_SIZE & (TABLE_SIZE - 1)) == 0, "TABLE_SIZE must be a power of two");
+
 hash_member_t HashTable[TABLE_SIZE];
 
-static void clear_table(void)
+/* default tables behind the global hash_* / direct_* API */
+static hash_table_t   DefaultTable = { HashTable, TABLE_SIZE, TABLE_SIZE - 1 };
+static direct_table_t DefaultDirect;
+
+static void clear_table(hash_table_t *table)
 {
-	for (int i = 0; i < TABLE_SIZE; ++i) {
-		HashTable[i].id          = HASH_EMPTY_ID;
-		HashTable[i].Set_Function = NULL;
+	for (unsigned i = 0; i < table->size; ++i) {
+		table->slots[i].id          = HASH_EMPTY_ID;
+		table->slots[i].Set_Function = NULL;
 	}
 }
 
 /* hashtable.c ----------------------------------------------------------- */
-uint8_t hash_MapFunction(uint32_t id)
+static uint32_t hash_Index(uint32_t id, uint32_t mask)
 {
 	// Input validation - check for reserved IDs
 	if (id == HASH_EMPTY_ID) {
@@ -20,66 +26,105 @@ uint8_t hash_MapFunction(uint32_t id)
 	
 	/* ---- perfect hash for the two blocks we care about --------------- */
 	if (id >= 0x180 && id <= 0x19E)                 /* 0x180-0x19E → 0-30 */
-		return (uint8_t)(id - 0x180);
+		return (id - 0x180) & mask;
 
 	if (id >= 0x280 && id <= 0x29E)                 /* 0x280-0x29E → 31-61 */
-		return (uint8_t)(31 + (id - 0x280));
+		return (31 + (id - 0x280)) & mask;
 
 	/* ---- fallback for everything else -------------------------------- */
 	id ^= id >> 16;  id *= 0x45d9f3b;  id ^= id >> 16;
 	id *= 0x45d9f3b; id ^= id >> 16;
-	return id % TABLE_SIZE;
+	return id & mask;
 }
 
-HashStatus_t hash_InsertMember(const hash_member_t *member)
+uint8_t hash_MapFunction(uint32_t id)
 {
-	if (!member) return HASH_ERROR;
+	return (uint8_t)hash_Index(id, TABLE_SIZE - 1);
+}
+
+HashStatus_t hash_TableInit(hash_table_t *table, hash_member_t *storage, uint16_t size)
+{
+	if (!table || !storage) return HASH_ERROR;
+
+	/* power-of-two sizes let probing wrap with a mask instead of modulo */
+	if (size == 0 || (size & (size - 1)) != 0) return HASH_ERROR;
+
+	table->slots = storage;
+	table->size  = size;
+	table->mask  = (uint16_t)(size - 1);
+	clear_table(table);
+	return HASH_OK;
+}
+
+HashStatus_t hash_TableInsert(hash_table_t *table, const hash_member_t *member)
+{
+	if (!table || !table->slots || !member) return HASH_ERROR;
 	
 	// Validate member data
 	if (member->id == HASH_EMPTY_ID || member->Set_Function == NULL) {
 		return HASH_ERROR;
 	}
 
-	int start = hash_MapFunction(member->id);
-	for (int i = 0; i < TABLE_SIZE; ++i) {
-		int idx = (start + i) % TABLE_SIZE;
+	uint32_t start = hash_Index(member->id, table->mask);
+	for (unsigned i = 0; i < table->size; ++i) {
+		uint32_t idx = (start + i) & table->mask;
 
 		// Check for duplicate ID
-		if (HashTable[idx].id == member->id) {
+		if (table->slots[idx].id == member->id) {
 			return HASH_ERROR;  // Duplicate found
 		}
 
-		if (HashTable[idx].id == HASH_EMPTY_ID) {   /* free slot */
-			HashTable[idx] = *member;               /* structure copy */
+		if (table->slots[idx].id == HASH_EMPTY_ID) {   /* free slot */
+			table->slots[idx] = *member;               /* structure copy */
 			return HASH_OK;
 		}
 	}
 	return HASH_FULL;
 }
-Set_Function_t hash_Lookup(uint32_t id)
+
+Set_Function_t hash_TableLookup(const hash_table_t *table, uint32_t id)
 {
-	int start = hash_MapFunction(id);
-	for (int i = 0; i < TABLE_SIZE; ++i) {
-		int idx = (start + i) % TABLE_SIZE;
-		if (HashTable[idx].id == id)
-			return HashTable[idx].Set_Function;
+	if (!table || !table->slots) return NULL;
+
+	uint32_t start = hash_Index(id, table->mask);
+	for (unsigned i = 0; i < table->size; ++i) {
+		uint32_t idx = (start + i) & table->mask;
+		if (table->slots[idx].id == id)
+			return table->slots[idx].Set_Function;
 	}
 	return NULL;
 }
 
-void hash_DeleteMember(uint32_t id)
+void hash_TableDelete(hash_table_t *table, uint32_t id)
 {
-	int start = hash_MapFunction(id);
-	for (int i = 0; i < TABLE_SIZE; ++i) {
-		int idx = (start + i) % TABLE_SIZE;
-		if (HashTable[idx].id == id) {
-			HashTable[idx].id = HASH_EMPTY_ID;
-			HashTable[idx].Set_Function = NULL;
+	if (!table || !table->slots) return;
+
+	uint32_t start = hash_Index(id, table->mask);
+	for (unsigned i = 0; i < table->size; ++i) {
+		uint32_t idx = (start + i) & table->mask;
+		if (table->slots[idx].id == id) {
+			table->slots[idx].id = HASH_EMPTY_ID;
+			table->slots[idx].Set_Function = NULL;
 			return;
 		}
 	}
 }
 
+HashStatus_t hash_InsertMember(const hash_member_t *member)
+{
+	return hash_TableInsert(&DefaultTable, member);
+}
+
+Set_Function_t hash_Lookup(uint32_t id)
+{
+	return hash_TableLookup(&DefaultTable, id);
+}
+
+void hash_DeleteMember(uint32_t id)
+{
+	hash_TableDelete(&DefaultTable, id);
+}
+
 /*
 void hash_PrintTable(void)
 {
@@ -99,85 +144,237 @@ HashStatus_t hash_SetTable(void)
 	hash_member_t member;
 
 	/* ---- set the table with the functions we care about ---------------- */
-	member.id = INV1_AV1_ID;
-	member.Set_Function = setInv1Av1Parameters;
+#define HASH_ROUTE_INSERT(msg_id, fn)                                  \
+	member.id = (msg_id);                                              \
+	member.Set_Function = (fn);                                        \
 	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
 
-	member.id = INV1_AV2_ID;
-	member.Set_Function = setInv1Av2Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	DB_CAN_ROUTE_TABLE(HASH_ROUTE_INSERT)
+#undef HASH_ROUTE_INSERT
 
+	return HASH_OK;
+}
 
-	member.id = INV2_AV1_ID;
-	member.Set_Function = setInv2Av1Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+HashStatus_t hash_Init(void)
+{
+	clear_table(&DefaultTable);  /* replaces malloc/calloc/free path */
+	return HASH_OK;
+	//return hash_SetTable();
+}
 
-	member.id = INV2_AV2_ID;
-	member.Set_Function = setInv2Av2Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+/* ---- direct-indexed backend ------------------------------------------- */
+_Static_assert(DIRECT_MAX_HANDLERS <= 256, "direct_table_t.index stores handler slots as uint8_t");
 
+HashStatus_t direct_TableInit(direct_table_t *table)
+{
+	if (!table) return HASH_ERROR;
 
+	for (int i = 0; i < DIRECT_ID_SPACE; ++i)
+		table->index[i] = 0;
+	for (int i = 0; i < DIRECT_MAX_HANDLERS; ++i)
+		table->handlers[i] = NULL;
+	return HASH_OK;
+}
 
-	member.id = INV3_AV1_ID;
-	member.Set_Function = setInv3Av1Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+HashStatus_t direct_TableInsert(direct_table_t *table, const hash_member_t *member)
+{
+	if (!table || !member) return HASH_ERROR;
 
-	member.id = INV3_AV2_ID;
-	member.Set_Function = setInv3Av2Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	if (member->id >= DIRECT_ID_SPACE || member->Set_Function == NULL)
+		return HASH_ERROR;
 
+	if (table->index[member->id] != 0)
+		return HASH_ERROR;                          /* duplicate ID */
 
-	member.id = INV4_AV1_ID;
-	member.Set_Function = setInv4Av1Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	/* share a slot between IDs routed to the same handler (routeRange) */
+	int free_slot = 0;
+	for (int i = 1; i < DIRECT_MAX_HANDLERS; ++i) {
+		if (table->handlers[i] == member->Set_Function) {
+			table->index[member->id] = (uint8_t)i;
+			return HASH_OK;
+		}
+		if (table->handlers[i] == NULL && free_slot == 0)
+			free_slot = i;
+	}
 
-	member.id = INV4_AV2_ID;
-	member.Set_Function = setInv4Av2Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	if (free_slot == 0)
+		return HASH_FULL;
 
+	table->handlers[free_slot] = member->Set_Function;
+	table->index[member->id]   = (uint8_t)free_slot;
+	return HASH_OK;
+}
 
-	member.id = STAGE_0_ID;
-	member.Set_Function = setStage0Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+Set_Function_t direct_TableLookup(const direct_table_t *table, uint32_t id)
+{
+	if (id >= DIRECT_ID_SPACE) return NULL;
+	return table->handlers[table->index[id]];
+}
 
-	member.id = STAGE_1_ID;
-	member.Set_Function = setStage1Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+void direct_TableDelete(direct_table_t *table, uint32_t id)
+{
+	if (!table || id >= DIRECT_ID_SPACE) return;
 
-	member.id = STAGE_2_ID;
-	member.Set_Function = setStage2Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	uint8_t slot = table->index[id];
+	if (slot == 0) return;
+	table->index[id] = 0;
 
-	member.id = STAGE_3_ID;
-	member.Set_Function = setStage3Parameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	/* free the handler slot once no ID references it */
+	for (int i = 0; i < DIRECT_ID_SPACE; ++i) {
+		if (table->index[i] == slot) return;
+	}
+	table->handlers[slot] = NULL;
+}
 
+HashStatus_t direct_Init(void)
+{
+	return direct_TableInit(&DefaultDirect);
+}
 
+HashStatus_t direct_InsertMember(const hash_member_t *member)
+{
+	return direct_TableInsert(&DefaultDirect, member);
+}
 
-	member.id = BMS_ID;
-	member.Set_Function = setBmsParameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+Set_Function_t direct_Lookup(uint32_t id)
+{
+	return direct_TableLookup(&DefaultDirect, id);
+}
 
-	member.id = RES_ID;
-	member.Set_Function = setResParameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+void direct_DeleteMember(uint32_t id)
+{
+	direct_TableDelete(&DefaultDirect, id);
+}
 
-	member.id = PEDAL_ID;
-	member.Set_Function = setPedalParameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+/* ---- range routes ------------------------------------------------------ */
+HashStatus_t range_TableInit(range_table_t *table, hash_range_t *storage, uint16_t capacity)
+{
+	if (!table || (!storage && capacity != 0)) return HASH_ERROR;
 
-	member.id = DB_ID;
-	member.Set_Function = setDBParameters;
-	if (hash_InsertMember(&member) != HASH_OK) return HASH_ERROR;
+	table->ranges   = storage;
+	table->capacity = capacity;
+	table->count    = 0;
+	return HASH_OK;
+}
 
+/* index of the first range whose start is greater than id */
+static uint16_t range_UpperBound(const range_table_t *table, uint32_t id)
+{
+	uint16_t lo = 0, hi = table->count;
+	while (lo < hi) {
+		uint16_t mid = (uint16_t)((lo + hi) / 2);
+		if (table->ranges[mid].start <= id)
+			lo = (uint16_t)(mid + 1);
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+HashStatus_t range_TableInsert(range_table_t *table, uint16_t start, uint16_t end, Set_Function_t fn)
+{
+	if (!table || !fn || start > end) return HASH_ERROR;
+
+	uint16_t pos = range_UpperBound(table, start);
+
+	/* reject overlap with the neighbours on either side */
+	if (pos > 0 && table->ranges[pos - 1].end >= start) return HASH_ERROR;
+	if (pos < table->count && table->ranges[pos].start <= end) return HASH_ERROR;
+
+	if (table->count >= table->capacity) return HASH_FULL;
+
+	for (uint16_t i = table->count; i > pos; --i)
+		table->ranges[i] = table->ranges[i - 1];
+
+	table->ranges[pos].start        = start;
+	table->ranges[pos].end          = end;
+	table->ranges[pos].Set_Function = fn;
+	table->count++;
 	return HASH_OK;
+}
+
+Set_Function_t range_TableLookup(const range_table_t *table, uint32_t id)
+{
+	if (!table || table->count == 0) return NULL;
 
+	uint16_t pos = range_UpperBound(table, id);
+	if (pos == 0) return NULL;
+
+	const hash_range_t *range = &table->ranges[pos - 1];
+	return (id <= range->end) ? range->Set_Function : NULL;
 }
 
-HashStatus_t hash_Init(void)
+void range_TableDelete(range_table_t *table, uint16_t start)
+{
+	if (!table) return;
+
+	uint16_t pos = range_UpperBound(table, start);
+	if (pos == 0 || table->ranges[pos - 1].start != start) return;
+
+	for (uint16_t i = pos - 1; i + 1 < table->count; ++i)
+		table->ranges[i] = table->ranges[i + 1];
+	table->count--;
+}
+
+/* ---- static backend ---------------------------------------------------- */
+/*
+ * Everything below is built by the preprocessor from DB_CAN_ROUTE_TABLE and
+ * lives in flash: no insert calls at startup, no RAM for HashTable[], and
+ * every configured ID resolves with the same two loads.
+ */
+#define STATIC_ROUTE_CHECK_ID(msg_id, fn) \
+	_Static_assert((msg_id) < DIRECT_ID_SPACE, #msg_id " is not an 11-bit standard ID");
+DB_CAN_ROUTE_TABLE(STATIC_ROUTE_CHECK_ID)
+#undef STATIC_ROUTE_CHECK_ID
+
+enum {
+	STATIC_ROUTE_NONE = 0,                  /* slot 0 = no route          */
+#define STATIC_ROUTE_SLOT(msg_id, fn) STATIC_ROUTE_##fn,
+	DB_CAN_ROUTE_TABLE(STATIC_ROUTE_SLOT)
+#undef STATIC_ROUTE_SLOT
+	STATIC_ROUTE_COUNT
+};
+_Static_assert(STATIC_ROUTE_COUNT <= 256, "StaticIndex[] stores handler slots as uint8_t");
+
+static const Set_Function_t StaticHandlers[STATIC_ROUTE_COUNT] = {
+	[STATIC_ROUTE_NONE] = NULL,
+#define STATIC_ROUTE_HANDLER(msg_id, fn) [STATIC_ROUTE_##fn] = fn,
+	DB_CAN_ROUTE_TABLE(STATIC_ROUTE_HANDLER)
+#undef STATIC_ROUTE_HANDLER
+};
+
+/* sized by the highest configured ID, unlisted IDs default to slot 0 */
+static const uint8_t StaticIndex[] = {
+#define STATIC_ROUTE_INDEX(msg_id, fn) [msg_id] = STATIC_ROUTE_##fn,
+	DB_CAN_ROUTE_TABLE(STATIC_ROUTE_INDEX)
+#undef STATIC_ROUTE_INDEX
+};
+
+HashStatus_t static_Init(void)
 {
-	clear_table();             /* replaces malloc/calloc/free path */
+	/* nothing to build at runtime - the switch turns a duplicate ID in
+	 * DB_CAN_ROUTE_TABLE into a "duplicate case value" compile error */
+	switch (0) {
+#define STATIC_ROUTE_CASE(msg_id, fn) case (msg_id):
+	DB_CAN_ROUTE_TABLE(STATIC_ROUTE_CASE)
+#undef STATIC_ROUTE_CASE
+	default:
+		break;
+	}
 	return HASH_OK;
-	//return hash_SetTable();
 }
 
+HashStatus_t static_InsertMember(const hash_member_t *member)
+{
+	if (!member) return HASH_ERROR;
+
+	/* the table is in flash: only routes it already holds are accepted */
+	return (static_Lookup(member->id) == member->Set_Function &&
+	        member->Set_Function != NULL) ? HASH_OK : HASH_ERROR;
+}
+
+Set_Function_t static_Lookup(uint32_t id)
+{
+	if (id >= sizeof(StaticIndex)) return NULL;
+	return StaticHandlers[StaticIndex[id]];
+}
@@ -37,6 +37,8 @@ const char* plt_StatusToString(plt_status_t status) {
             return "Buffer overflow";
         case PLT_UNDERFLOW:
             return "Buffer underflow";
+        case PLT_CRC_ERROR:
+            return "Checksum mismatch";
         default:
             return "Unknown error";
     }
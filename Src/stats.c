@@ -0,0 +1,62 @@
+/**
+ * @file stats.c
+ * @brief Hot-path timing counters
+ */
+
+#include "stats.h"
+#include <string.h>
+
+#if PLT_ENABLE_STATS
+StatsTimings_t Stats_timings;
+#endif
+
+void Stats_Record(StatsCounter_t* counter, uint32_t value) {
+    if (counter == NULL) return;
+
+    if (counter->count == 0 || value < counter->min) counter->min = value;
+    if (value > counter->max) counter->max = value;
+    counter->total += value;
+    counter->count++;
+}
+
+void Stats_RecordRoute(StatsTimings_t* timings, uint16_t id, uint32_t cycles) {
+    if (timings == NULL) return;
+
+    for (uint8_t i = 0; i < timings->route_count; i++) {
+        if (timings->route[i].id == id) {
+            Stats_Record(&timings->route[i].cycles, cycles);
+            return;
+        }
+    }
+
+    if (timings->route_count >= STATS_MAX_ROUTES) {
+        timings->route_overflow++;
+        return;
+    }
+    StatsRoute_t* route = &timings->route[timings->route_count++];
+    route->id = id;
+    Stats_Record(&route->cycles, cycles);
+}
+
+uint32_t Stats_Average(const StatsCounter_t* counter) {
+    if (counter == NULL || counter->count == 0) return 0;
+    return (uint32_t)(counter->total / counter->count);
+}
+
+void Stats_Reset(StatsTimings_t* timings) {
+    if (timings == NULL) return;
+    memset(timings, 0, sizeof(*timings));
+}
+
+void Stats_EnableCycleCounter(void) {
+#if STATS_HAVE_CYCCNT
+    volatile uint32_t* demcr = (volatile uint32_t*)0xE000EDFCu;     // CoreDebug->DEMCR
+    volatile uint32_t* dwt_ctrl = (volatile uint32_t*)0xE0001000u;  // DWT->CTRL
+    volatile uint32_t* dwt_lar = (volatile uint32_t*)0xE0001FB0u;   // DWT->LAR (locked on Cortex-M7)
+
+    *demcr |= (1u << 24);           // TRCENA: power the DWT
+    *dwt_lar = 0xC5ACCE55u;
+    STATS_DWT_CYCCNT = 0;
+    *dwt_ctrl |= 1u;                // CYCCNTENA
+#endif
+}
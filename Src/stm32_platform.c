@@ -9,17 +9,111 @@
 #include "stm32_platform.h"
 #include "utils.h"
 #include "hashtable.h"
+#include "can_filter.h"
+#include "telemetry.h"
+#include "adc_filter.h"
 #include "database.h"
 // Note: callbacks.h is a legacy stub - not required for v2.0.0
-#include <stdio.h>
 #include <string.h>
+#if PLT_USE_CMSIS_DSP
+#include "arm_math.h"
+#endif
 
 /* ==================== Configuration ==================== */
 
+// Queue depths (items per instance) - override with -D to resize
+#ifndef CAN_RX_QUEUE_SIZE
 #define CAN_RX_QUEUE_SIZE   32
+#endif
+#ifndef CAN_RX_FAST_QUEUE_SIZE
+#define CAN_RX_FAST_QUEUE_SIZE  8   // Power of two - frames from RX FIFO1 (prioritized IDs)
+#endif
+#ifndef CAN_FAST_RANGES
+#define CAN_FAST_RANGES     4       // prioritize() ranges per instance
+#endif
+#ifndef CAN_TX_QUEUE_SIZE
+#define CAN_TX_QUEUE_SIZE   16      // Frames waiting for a TX mailbox, lowest ID first
+#endif
+#ifndef CAN_TX_STAMP_SLOTS
+#define CAN_TX_STAMP_SLOTS  8       // Power of two - IDs whose last TX completion time is kept
+#endif
+#ifndef CAN_CAPTURE_QUEUE_SIZE
+#define CAN_CAPTURE_QUEUE_SIZE  64  // Frames between the RX interrupt and handleCapture (PLT_ENABLE_CAN_TRACE)
+#endif
+#ifndef CAN_CAPTURE_FLUSH_MS
+#define CAN_CAPTURE_FLUSH_MS    20  // Longest a partly filled capture record waits for more entries
+#endif
+#ifndef UART_RX_QUEUE_SIZE
 #define UART_RX_QUEUE_SIZE  16
-#define UART_TX_QUEUE_SIZE  16
-#define SPI_RX_QUEUE_SIZE   8
+#endif
+#ifndef UART_TX_QUEUE_SIZE
+#define UART_TX_QUEUE_SIZE  128     // DMA TX byte ring
+#endif
+#ifndef UART_TX_DMA_CHUNK
+#define UART_TX_DMA_CHUNK   64      // Largest single TX DMA transfer
+#endif
+#ifndef UART_PRINTF_CHUNK
+#define UART_PRINTF_CHUNK   32      // printf staging when sending without TX DMA
+#endif
+#ifndef SPI_RX_QUEUE_SIZE
+#define SPI_RX_QUEUE_SIZE   8       // Completed transactions awaiting handleRxData (power of two)
+#endif
+#ifndef SPI_TXN_QUEUE_SIZE
+#define SPI_TXN_QUEUE_SIZE  8       // Submitted transactions waiting for the bus
+#endif
+#ifndef SPI_TIMEOUT_MS
+#define SPI_TIMEOUT_MS      100     // Blocking transfer timeout
+#endif
+#define ADC_CHANNEL_SLOTS   32      // Channel numbers a scan can map (0-31)
+
+// ADC block conversion through CMSIS-DSP (arm_q15_to_float + arm_scale_f32)
+// on cores that link it; the plain loop is used otherwise
+#ifndef PLT_USE_CMSIS_DSP
+#define PLT_USE_CMSIS_DSP   0
+#endif
+
+// UART RX via circular DMA + idle-line events when the handle's hdmarx is circular.
+// Needs HAL_UARTEx_ReceiveToIdle_DMA (F4 HAL >= 1.7.10); set to 0 for older HALs
+#ifndef PLT_UART_DMA_RX
+#define PLT_UART_DMA_RX     1
+#endif
+
+// ISR -> main loop RX queues run in lock-free SPSC mode (power-of-two sizes)
+_Static_assert((CAN_RX_QUEUE_SIZE & (CAN_RX_QUEUE_SIZE - 1)) == 0, "CAN_RX_QUEUE_SIZE must be a power of two");
+_Static_assert((UART_RX_QUEUE_SIZE & (UART_RX_QUEUE_SIZE - 1)) == 0, "UART_RX_QUEUE_SIZE must be a power of two");
+_Static_assert((SPI_RX_QUEUE_SIZE & (SPI_RX_QUEUE_SIZE - 1)) == 0, "SPI_RX_QUEUE_SIZE must be a power of two");
+
+// CAN routing backend - override with -DPLT_CAN_ROUTING=PLT_CAN_ROUTING_DIRECT
+#define PLT_CAN_ROUTING_HASH    0   ///< Per-instance hashtables, linear probing (8 B per slot)
+#define PLT_CAN_ROUTING_DIRECT  1   ///< Per-instance 2048-entry index tables, O(1) hit and miss (~2.2 KB each)
+#define PLT_CAN_ROUTING_STATIC  2   ///< const table generated from DB_CAN_ROUTE_TABLE (flash only, all instances)
+#ifndef PLT_CAN_ROUTING
+#define PLT_CAN_ROUTING PLT_CAN_ROUTING_HASH
+#endif
+
+#if PLT_CAN_ROUTING != PLT_CAN_ROUTING_HASH && PLT_CAN_ROUTING != PLT_CAN_ROUTING_DIRECT && \
+    PLT_CAN_ROUTING != PLT_CAN_ROUTING_STATIC
+#error "Unknown PLT_CAN_ROUTING backend"
+#endif
+
+// Hash backend slots per CAN instance (power of two) - override with -D
+#ifndef CAN_ROUTE_TABLE_SIZE_0
+#define CAN_ROUTE_TABLE_SIZE_0  TABLE_SIZE
+#endif
+#ifndef CAN_ROUTE_TABLE_SIZE_1
+#define CAN_ROUTE_TABLE_SIZE_1  64
+#endif
+#ifndef CAN_ROUTE_TABLE_SIZE_2
+#define CAN_ROUTE_TABLE_SIZE_2  32
+#endif
+#ifndef CAN_ROUTE_TABLE_SIZE_3
+#define CAN_ROUTE_TABLE_SIZE_3  32
+#endif
+
+// Interval routes per CAN instance - override with -D
+#ifndef CAN_ROUTE_RANGES
+#define CAN_ROUTE_RANGES        8
+#endif
 
 /* ==================== Private State ==================== */
 
@@ -51,44 +145,375 @@ static struct {
     #endif
 } hw_handles = {0};
 
+// Interrupt-side handle lookup: peripheral base address -> instance index.
+// Register blocks are 1 KB aligned, so bits 10-15 tell the CAN and UART
+// controllers of a part apart; a clash falls back to a scan.
+#define PLT_SLOT_COUNT  64
+#define PLT_NO_INSTANCE 0xFF
+#ifdef HAL_CAN_MODULE_ENABLED
+static uint8_t can_slot[PLT_SLOT_COUNT];
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+static uint8_t uart_slot[PLT_SLOT_COUNT];
+#endif
+
 // CAN state (per instance)
 static struct {
     Queue_t rx_queue;
+    Queue_t rx_fast;            // FIFO1 frames, dispatched before rx_queue
+    struct { uint16_t start, end; } fast[CAN_FAST_RANGES];
+    uint8_t fast_count;
+    #if PLT_CAN_ROUTING == PLT_CAN_ROUTING_HASH
+    hash_table_t routes;
+    #elif PLT_CAN_ROUTING == PLT_CAN_ROUTING_DIRECT
+    direct_table_t routes;
+    #endif
+    range_table_t ranges;       // Consulted after an exact-match miss
     bool routing_initialized;
     void (*default_handler)(CANMessage_t*);
     volatile uint32_t tx_count;
     volatile uint32_t rx_count;
     volatile uint32_t error_count;
+    uint32_t baudrate;          // Last bit rate set by setBaudrate (0 = CubeMX timing)
+    volatile uint16_t tx_pending;   // Frames in the TX heap
+    uint16_t tx_seq;                // Submission counter, keeps equal IDs in order
+    uint16_t tx_mailbox_id[3];      // ID loaded into each hardware mailbox
+    struct { uint16_t id; bool valid; uint32_t time; } tx_stamp[CAN_TX_STAMP_SLOTS];   // By id % slots
+    #if PLT_ENABLE_STATS
+    uint16_t tx_high_water;         // Deepest TX heap seen
+    volatile uint32_t tx_drops;     // Sends refused with PLT_QUEUE_FULL
+    #endif
 } can_state[PLT_MAX_CAN_INSTANCES] = {0};
 
+_Static_assert((CAN_TX_STAMP_SLOTS & (CAN_TX_STAMP_SLOTS - 1)) == 0, "CAN_TX_STAMP_SLOTS must be a power of two");
+
+// Frame timestamp clock (shared by all CAN instances)
+static struct {
+    CANTimestampSource_t source;
+    #ifdef HAL_TIM_MODULE_ENABLED
+    TIM_TypeDef* timer;         // CAN_TIMESTAMP_TIMER counter
+    #endif
+    uint32_t hz;                // Ticks per second of the software sources
+} can_clock = { .source = CAN_TIMESTAMP_TICK, .hz = 1000 };
+
+#if PLT_ENABLE_CAN_TRACE
+// Frame as the RX interrupt hands it to the capture ring
+typedef struct {
+    CANMessage_t msg;
+    uint8_t instance;
+} can_capture_entry_t;
+
+// Bus capture and replay (shared by all CAN instances)
+static struct {
+    volatile bool capturing;
+    uint8_t uart;                   // Capture UART, or CAN_CAPTURE_NO_UART
+    bool header_pending;            // Trace header not emitted yet
+    bool have_last;                 // last_stamp holds the previous entry's time
+    uint32_t last_stamp;            // Timestamp of the previous encoded entry
+    uint64_t capture_ticks;         // Clock ticks from the first entry to the previous one
+    uint64_t capture_us;            // Same in microseconds, so deltas do not accumulate rounding
+    uint8_t chunk[TELEMETRY_MAX_PAYLOAD];   // Record handleCapture is filling
+    uint16_t chunk_length;
+    uint32_t chunk_started;         // HAL_GetTick when the first entry went into chunk
+    volatile uint32_t captured;
+    volatile uint32_t capture_drops;
+    volatile bool replaying;        // Set: the RX interrupt discards live frames
+    const uint8_t* trace;           // Replay source
+    uint32_t trace_length;
+    uint32_t trace_pos;             // Offset of the entry after next
+    CANTraceFrame_t next;           // Decoded entry waiting for its due time
+    uint16_t speed;                 // Percent of recorded timing, 0 = flat out
+    uint64_t trace_us;              // Recorded time of next from the first entry
+    uint64_t due_ticks;             // Replay clock value at which next is due
+    uint64_t clock_ticks;           // Replay clock: ticks since startReplay
+    uint32_t clock_last;            // CAN_clockNow() at the previous pump
+    uint32_t replayed;
+    uint32_t replay_drops;
+} can_trace = {0};
+
+QUEUE_DEFINE(can_capture_queue, can_capture_entry_t, CAN_CAPTURE_QUEUE_SIZE);
+#endif
+
 // UART state (per instance)
+#define UART_RX_DMA_SIZE    256     // rx_buffer doubles as the circular DMA ring
 static struct {
     Queue_t rx_queue;
     Queue_t tx_queue;
-    uint8_t rx_buffer[256];
+    uint8_t rx_buffer[UART_RX_DMA_SIZE];
     volatile uint16_t rx_index;
     uint16_t timeout_ms;
+    bool rx_dma;                    // RX runs from the DMA ring instead of rx_queue
+    uint16_t rx_dma_pos;            // Ring position at the last RX event (ISR only)
+    volatile uint32_t rx_written;   // Bytes landed in the ring (free-running, ISR)
+    uint32_t rx_read;               // Bytes consumed from the ring (free-running, main loop)
+    volatile uint32_t rx_overruns;  // Bytes lost because the ring lapped the reader
+    volatile uint32_t rx_resync;    // Ring boundary the last RX restart moved rx_written to (ISR)
+    volatile uint32_t rx_skipped;   // Ring slots restarts jumped over, never written (ISR)
+    uint32_t rx_skipped_seen;       // rx_skipped already applied to rx_read (main loop)
+    bool tx_dma;                    // Writes go through tx_queue + DMA
+    volatile bool tx_busy;          // A TX DMA transfer is in flight
+    UARTTxPolicy_t tx_policy;       // Full-ring behaviour
+    volatile uint32_t tx_dropped;   // Bytes discarded by DROP/OVERWRITE/timeout
+    uint8_t tx_seq;                 // Next telemetry record sequence number
 } uart_state[PLT_MAX_UART_INSTANCES] = {0};
 
+_Static_assert((UART_RX_DMA_SIZE & (UART_RX_DMA_SIZE - 1)) == 0, "UART_RX_DMA_SIZE must be a power of two");
+
 #ifdef HAL_SPI_MODULE_ENABLED
 // SPI state (per instance)
 static struct {
-    Queue_t rx_queue;
-    volatile bool busy;
+    Queue_t rx_queue;                   // Completed SPITransaction_t* for handleRxData (SPSC, ISR -> main)
+    Queue_t txn_queue;                  // Submitted SPITransaction_t* waiting for the bus
+    SPITransaction_t* volatile active;  // Transaction on the wire
+    volatile bool busy;                 // Blocking transfer owns the bus
+    bool dma;                           // hdmatx and hdmarx linked
+    volatile uint32_t done_bytes;       // Bytes received by undelivered transactions
+    uint32_t clock_hz;                  // Requested SCK of the current BR setting
+    uint8_t mode;                       // Current CPOL/CPHA as SPI mode 0-3
+    #if PLT_ENABLE_STATS
+    uint32_t started;                   // Cycle count when the active transaction went on the wire
+    #endif
 } spi_state[PLT_MAX_SPI_INSTANCES] = {0};
 #endif
 
+/* Queue storage lives in .bss so Platform.begin() never touches the heap */
+#ifdef HAL_CAN_MODULE_ENABLED
+static CANMessage_t can_rx_storage[PLT_MAX_CAN_INSTANCES][CAN_RX_QUEUE_SIZE];
+static CANMessage_t can_rx_fast_storage[PLT_MAX_CAN_INSTANCES][CAN_RX_FAST_QUEUE_SIZE];
+
+// TX backlog: binary min-heap on (id, seq), the frame bxCAN would win arbitration with on top
+typedef struct {
+    CANMessage_t msg;
+    uint16_t seq;
+} can_tx_entry_t;
+static can_tx_entry_t can_tx_storage[PLT_MAX_CAN_INSTANCES][CAN_TX_QUEUE_SIZE];
+
+#if PLT_CAN_ROUTING == PLT_CAN_ROUTING_HASH
+// One pool carved into per-instance routing tables of independent size
+_Static_assert(PLT_MAX_CAN_INSTANCES == 4, "extend CAN_ROUTE_TABLE_SIZE_n to match PLT_MAX_CAN_INSTANCES");
+static const uint16_t can_route_sizes[PLT_MAX_CAN_INSTANCES] = {
+    CAN_ROUTE_TABLE_SIZE_0, CAN_ROUTE_TABLE_SIZE_1, CAN_ROUTE_TABLE_SIZE_2, CAN_ROUTE_TABLE_SIZE_3
+};
+static hash_member_t can_route_storage[CAN_ROUTE_TABLE_SIZE_0 + CAN_ROUTE_TABLE_SIZE_1 +
+                                       CAN_ROUTE_TABLE_SIZE_2 + CAN_ROUTE_TABLE_SIZE_3];
+#endif
+static hash_range_t can_range_storage[PLT_MAX_CAN_INSTANCES][CAN_ROUTE_RANGES];
+#endif
+#ifdef HAL_UART_MODULE_ENABLED
+static uint8_t uart_rx_storage[PLT_MAX_UART_INSTANCES][UART_RX_QUEUE_SIZE];
+static uint8_t uart_tx_storage[PLT_MAX_UART_INSTANCES][UART_TX_QUEUE_SIZE];
+static uint8_t uart_tx_dma[PLT_MAX_UART_INSTANCES][UART_TX_DMA_CHUNK];  // DMA reads from here while the ring refills
+static uint8_t uart_record_frame[TELEMETRY_FRAME_SIZE(TELEMETRY_MAX_PAYLOAD)];  // sendRecord scratch, free again on return
+#endif
+#ifdef HAL_SPI_MODULE_ENABLED
+static SPITransaction_t* spi_rx_storage[PLT_MAX_SPI_INSTANCES][SPI_RX_QUEUE_SIZE];
+static SPITransaction_t* spi_txn_storage[PLT_MAX_SPI_INSTANCES][SPI_TXN_QUEUE_SIZE];
+#endif
+
+#ifdef HAL_TIM_MODULE_ENABLED
+// Timer state (per instance)
+static struct {
+    uint32_t hz;        // Frequency of the current PSC/ARR (0 = not set by setFrequency)
+} tim_state[PLT_MAX_TIM_INSTANCES] = {0};
+#endif
+
 #ifdef HAL_ADC_MODULE_ENABLED
 // ADC state (per instance)
 static struct {
-    uint16_t* dma_buffer;
-    uint16_t buffer_size;
+    uint16_t* dma_buffer;                       // Ping-pong scan buffer, NULL when not scanning
+    const volatile uint16_t* volatile latest;   // Last complete sequence (set by the DMA callbacks)
+    uint16_t buffer_size;                       // Samples per half-buffer
+    uint8_t count;                              // Channels per sequence
+    uint8_t rank[ADC_CHANNEL_SLOTS];            // Channel number -> sequence position (0xFF = not scanned)
+    ADCFilter_t* volatile filter[ADC_MAX_SCAN_CHANNELS];  // Per-rank filter run on each half-buffer
+    volatile uint32_t blocks;                   // Completed half-buffers
+    ADC_InitTypeDef idle_init;                  // CubeMX configuration restored by stopScan
     float vref;
+    float scale;                                // Volts per LSB: vref / full-scale code
+    uint32_t scale_q24;                         // Same in Q8.24, for readVoltageQ16
+    uint8_t bits;                               // Current resolution
 } adc_state[PLT_MAX_ADC_INSTANCES] = {0};
+static uint16_t adc_scan_storage[PLT_MAX_ADC_INSTANCES][2 * ADC_MAX_SCAN_CHANNELS * ADC_SCAN_BLOCK];
+#endif
+
+/* ==================== Clock Helpers ==================== */
+
+/**
+ * @brief Lookup slot of a peripheral register block
+ */
+static inline uint8_t PLT_slotOf(const volatile void* periph) {
+    return (uint8_t)(((uintptr_t)periph >> 10) & (PLT_SLOT_COUNT - 1));
+}
+
+/**
+ * @brief Resolve a HAL handle to its instance index: slot hit, else scan
+ * @param slots Slot table filled by Platform.begin()
+ * @param handles Registered handles
+ * @param count Number of registered handles
+ * @param handle Handle passed to the HAL callback
+ * @param periph handle->Instance
+ * @return Instance index, or PLT_NO_INSTANCE if the handle is not ours
+ */
+static inline uint8_t PLT_instanceOf(const uint8_t* slots, void* const* handles, uint8_t count,
+                                     const void* handle, const volatile void* periph) {
+    uint8_t i = slots[PLT_slotOf(periph)];
+    if (i < count && handles[i] == handle) return i;
+    for (i = 0; i < count; i++) {
+        if (handles[i] == handle) return i;
+    }
+    return PLT_NO_INSTANCE;
+}
+
+/**
+ * @brief Check whether a peripheral hangs off APB2
+ * @param periph Peripheral register block (e.g. hspi->Instance)
+ * @note APB2 sits between APB2PERIPH_BASE and the AHB block; everything else is APB1
+ */
+static bool PLT_onApb2(const volatile void* periph) {
+    uintptr_t addr = (uintptr_t)periph;
+    (void)addr;
+#if defined(APB2PERIPH_BASE) && defined(AHB1PERIPH_BASE)
+    return addr >= APB2PERIPH_BASE && addr < AHB1PERIPH_BASE;
+#elif defined(APB2PERIPH_BASE) && defined(AHBPERIPH_BASE)
+    return addr >= APB2PERIPH_BASE && addr < AHBPERIPH_BASE;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Clock of the APB bus a peripheral hangs off
+ * @param periph Peripheral register block (e.g. hspi->Instance)
+ */
+static uint32_t PLT_busClock(const volatile void* periph) {
+    return PLT_onApb2(periph) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+}
+
+#ifdef HAL_TIM_MODULE_ENABLED
+/**
+ * @brief Counter clock of a timer before its prescaler
+ * @note Timers run at twice PCLK whenever the APB prescaler is above 1
+ */
+static uint32_t PLT_timerClock(const TIM_TypeDef* tim) {
+    uint32_t pclk = PLT_busClock(tim);
+    uint32_t divided = 0;
+#if defined(RCC_CFGR_PPRE1_Pos) && defined(RCC_CFGR_PPRE2_Pos)
+    uint32_t pos = PLT_onApb2(tim) ? RCC_CFGR_PPRE2_Pos : RCC_CFGR_PPRE1_Pos;
+    divided = (RCC->CFGR >> pos) & 0x4u;   // PPRE = 0xx: /1, 1xx: /2 to /16
+#elif defined(RCC_CFGR_PPRE_Pos)
+    divided = (RCC->CFGR >> RCC_CFGR_PPRE_Pos) & 0x4u;
+#endif
+    return divided ? 2u * pclk : pclk;
+}
 #endif
 
 /* ==================== CAN Implementation ==================== */
 
+/**
+ * @brief Hand one frame to a free TX mailbox
+ */
+static bool CAN_mailboxAdd(uint8_t instance, uint16_t id, const uint8_t* data, uint8_t length) {
+    CAN_TxHeaderTypeDef tx_header;
+    tx_header.StdId = id;
+    tx_header.ExtId = 0;
+    tx_header.IDE = CAN_ID_STD;
+    tx_header.RTR = CAN_RTR_DATA;
+    tx_header.DLC = length;
+    tx_header.TransmitGlobalTime = DISABLE;
+    
+    uint32_t tx_mailbox;
+    if (HAL_CAN_AddTxMessage(hw_handles.hcan[instance], &tx_header, (uint8_t*)data, &tx_mailbox) != HAL_OK) {
+        return false;
+    }
+    // CAN_TX_MAILBOX0/1/2 are the bits 1/2/4
+    can_state[instance].tx_mailbox_id[(tx_mailbox >> 1) & 0x3u] = id;
+    can_state[instance].tx_count++;
+    return true;
+}
+
+/**
+ * @brief Read the software timestamp clock
+ * @note CAN_TIMESTAMP_HARDWARE stamps are latched by the controller and
+ *       cannot be read here; this returns 0 for that source
+ */
+static inline uint32_t CAN_clockNow(void) {
+    switch (can_clock.source) {
+        case CAN_TIMESTAMP_DWT:
+            return Stats_Now();
+        #ifdef HAL_TIM_MODULE_ENABLED
+        case CAN_TIMESTAMP_TIMER:
+            return can_clock.timer->CNT;
+        #endif
+        case CAN_TIMESTAMP_HARDWARE:
+            return 0;
+        case CAN_TIMESTAMP_TICK:
+        default:
+            return HAL_GetTick();
+    }
+}
+
+static bool CAN_txBefore(const can_tx_entry_t* a, const can_tx_entry_t* b) {
+    if (a->msg.id != b->msg.id) return a->msg.id < b->msg.id;
+    return (int16_t)(a->seq - b->seq) < 0;
+}
+
+/**
+ * @brief Insert into the TX heap (caller holds the critical section, heap not full)
+ */
+static void CAN_txPush(uint8_t instance, const CANMessage_t* msg) {
+    can_tx_entry_t* heap = can_tx_storage[instance];
+    uint16_t i = can_state[instance].tx_pending++;
+    can_tx_entry_t entry = {.msg = *msg, .seq = can_state[instance].tx_seq++};
+    
+    while (i > 0) {
+        uint16_t parent = (uint16_t)((i - 1u) / 2u);
+        if (!CAN_txBefore(&entry, &heap[parent])) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = entry;
+    
+    #if PLT_ENABLE_STATS
+    if (can_state[instance].tx_pending > can_state[instance].tx_high_water) {
+        can_state[instance].tx_high_water = can_state[instance].tx_pending;
+    }
+    #endif
+}
+
+/**
+ * @brief Remove the top of the TX heap (caller holds the critical section, heap not empty)
+ */
+static void CAN_txPop(uint8_t instance) {
+    can_tx_entry_t* heap = can_tx_storage[instance];
+    uint16_t n = --can_state[instance].tx_pending;
+    can_tx_entry_t last = heap[n];
+    
+    uint16_t i = 0;
+    for (;;) {
+        uint16_t child = (uint16_t)(2u * i + 1u);
+        if (child >= n) break;
+        if (child + 1u < n && CAN_txBefore(&heap[child + 1u], &heap[child])) child++;
+        if (!CAN_txBefore(&heap[child], &last)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+}
+
+/**
+ * @brief Move queued frames into free mailboxes, highest priority first
+ * @note Runs from the mailbox-complete interrupts and after each send
+ */
+static void CAN_txDrain(uint8_t instance) {
+    uint32_t primask = Queue_EnterCritical();
+    while (can_state[instance].tx_pending > 0 && HAL_CAN_GetTxMailboxesFreeLevel(hw_handles.hcan[instance]) > 0) {
+        const CANMessage_t* top = &can_tx_storage[instance][0].msg;
+        if (!CAN_mailboxAdd(instance, top->id, top->data, top->length)) break;
+        CAN_txPop(instance);
+    }
+    Queue_ExitCritical(primask);
+}
+
 static bool CAN_send_impl(uint8_t instance, uint16_t id, const uint8_t* data, uint8_t length) {
     if (instance >= hw_handles.can_count || hw_handles.hcan[instance] == NULL) {
         lastError = PLT_NOT_INITIALIZED;
@@ -100,28 +525,39 @@ static bool CAN_send_impl(uint8_t instance, uint16_t id, const uint8_t* data, ui
         return false;
     }
     
-    // Prepare CAN message
-    CAN_TxHeaderTypeDef tx_header;
-    tx_header.StdId = id;
-    tx_header.ExtId = 0;
-    tx_header.IDE = CAN_ID_STD;
-    tx_header.RTR = CAN_RTR_DATA;
-    tx_header.DLC = length;
-    tx_header.TransmitGlobalTime = DISABLE;
-    
-    uint32_t tx_mailbox;
-    HAL_StatusTypeDef status = HAL_CAN_AddTxMessage(hw_handles.hcan[instance], &tx_header, 
-                                                     (uint8_t*)data, &tx_mailbox);
-    
-    if (status == HAL_OK) {
-        can_state[instance].tx_count++;
+    bool queued = true;
+    uint32_t primask = Queue_EnterCritical();
+    if (can_state[instance].tx_pending == 0 && HAL_CAN_GetTxMailboxesFreeLevel(hw_handles.hcan[instance]) > 0) {
+        // Nothing waiting: straight into a mailbox
+        queued = CAN_mailboxAdd(instance, id, data, length);
+        lastError = queued ? PLT_OK : PLT_HAL_ERROR;
+    } else if (can_state[instance].tx_pending < CAN_TX_QUEUE_SIZE) {
+        CANMessage_t msg = {.id = id, .length = length};
+        memcpy(msg.data, data, length);
+        CAN_txPush(instance, &msg);
         lastError = PLT_OK;
-        return true;
     } else {
-        lastError = PLT_HAL_ERROR;
+        queued = false;
+        lastError = PLT_QUEUE_FULL;
+        #if PLT_ENABLE_STATS
+        can_state[instance].tx_drops++;
+        #endif
+    }
+    Queue_ExitCritical(primask);
+    
+    if (!queued) {
         can_state[instance].error_count++;
         return false;
     }
+    
+    // Covers a mailbox that freed up between the interrupt and the push
+    CAN_txDrain(instance);
+    return true;
+}
+
+static uint16_t CAN_pendingTxMessages_impl(uint8_t instance) {
+    if (instance >= hw_handles.can_count) return 0;
+    return can_state[instance].tx_pending;
 }
 
 static bool CAN_sendMessage_impl(uint8_t instance, const CANMessage_t* msg) {
@@ -132,29 +568,281 @@ static bool CAN_sendMessage_impl(uint8_t instance, const CANMessage_t* msg) {
     return CAN_send_impl(instance, msg->id, msg->data, msg->length);
 }
 
+/**
+ * @brief Set up the routing table of one instance
+ */
+static HashStatus_t CAN_routeInit(uint8_t instance) {
+    range_TableInit(&can_state[instance].ranges, can_range_storage[instance], CAN_ROUTE_RANGES);
+    
+    #if PLT_CAN_ROUTING == PLT_CAN_ROUTING_HASH
+    size_t offset = 0;
+    for (uint8_t i = 0; i < instance; i++) {
+        offset += can_route_sizes[i];
+    }
+    return hash_TableInit(&can_state[instance].routes, &can_route_storage[offset], can_route_sizes[instance]);
+    #elif PLT_CAN_ROUTING == PLT_CAN_ROUTING_DIRECT
+    return direct_TableInit(&can_state[instance].routes);
+    #else
+    (void)instance;
+    return static_Init();
+    #endif
+}
+
+static inline HashStatus_t CAN_routeInsert(uint8_t instance, const hash_member_t* member) {
+    #if PLT_CAN_ROUTING == PLT_CAN_ROUTING_HASH
+    return hash_TableInsert(&can_state[instance].routes, member);
+    #elif PLT_CAN_ROUTING == PLT_CAN_ROUTING_DIRECT
+    return direct_TableInsert(&can_state[instance].routes, member);
+    #else
+    (void)instance;
+    return static_InsertMember(member);
+    #endif
+}
+
+static inline Set_Function_t CAN_routeLookup(uint8_t instance, uint32_t id) {
+    #if PLT_CAN_ROUTING == PLT_CAN_ROUTING_HASH
+    Set_Function_t handler = hash_TableLookup(&can_state[instance].routes, id);
+    #elif PLT_CAN_ROUTING == PLT_CAN_ROUTING_DIRECT
+    Set_Function_t handler = direct_TableLookup(&can_state[instance].routes, id);
+    #else
+    Set_Function_t handler = static_Lookup(id);
+    #endif
+    
+    // Exact routes win over ranges
+    if (handler == NULL) {
+        handler = range_TableLookup(&can_state[instance].ranges, id);
+    }
+    return handler;
+}
+
+/**
+ * @brief Route one received message to its handler
+ */
+static inline void CAN_dispatch(uint8_t instance, CANMessage_t* msg) {
+    // Try this bus's routing table first
+    Set_Function_t handler = CAN_routeLookup(instance, msg->id);
+    #if PLT_ENABLE_STATS
+    if (can_clock.source != CAN_TIMESTAMP_HARDWARE) {
+        STATS_SAMPLE(STATS_CAN_LATENCY, CAN_clockNow() - msg->timestamp);
+    }
+    #endif
+    
+    if (handler != NULL) {
+        // Route to specific handler - pass message data buffer
+        STATS_START(t0);
+        handler(msg->data);
+        STATS_STOP_ROUTE(msg->id, t0);
+        STATS_STOP(STATS_CAN_DISPATCH, t0);
+    } else if (can_state[instance].default_handler != NULL) {
+        // Route to default handler
+        can_state[instance].default_handler(msg);
+    }
+}
+
+#if PLT_ENABLE_CAN_TRACE
+/**
+ * @brief Copy one received frame into the capture ring (RX interrupt)
+ */
+static void CAN_captureFrame(uint8_t instance, const CAN_RxHeaderTypeDef* header, const uint8_t* data,
+                             uint32_t stamp) {
+    can_capture_entry_t entry;
+    entry.msg.id = (uint16_t)header->StdId;
+    entry.msg.length = (header->DLC > 8) ? 8 : (uint8_t)header->DLC;
+    entry.msg.timestamp = stamp;
+    memcpy(entry.msg.data, data, sizeof(entry.msg.data));
+    entry.instance = instance;
+    
+    // Locked ring: the FIFO0/FIFO1 interrupts of every instance share it
+    if (Queue_Push(&can_capture_queue, &entry) == PLT_OK) {
+        can_trace.captured++;
+    } else {
+        can_trace.capture_drops++;
+    }
+}
+
+/**
+ * @brief Encode captured frames into out, whole entries only
+ * @return Bytes written (the header first after startCapture)
+ */
+static size_t CAN_captureEncode(uint8_t* out, size_t size) {
+    size_t pos = 0;
+    if (can_trace.header_pending) {
+        pos = CANTrace_WriteHeader(out, size);
+        if (pos == 0) return 0;
+        can_trace.header_pending = false;
+    }
+    
+    can_capture_entry_t entry;
+    while (Queue_Peek(&can_capture_queue, &entry) == PLT_OK) {
+        // Stamps from a preempted FIFO interrupt can land slightly out of order
+        uint64_t ticks = can_trace.capture_ticks;
+        int32_t step = (int32_t)(entry.msg.timestamp - can_trace.last_stamp);
+        if (can_trace.have_last && step > 0) {
+            ticks += (uint32_t)step;
+        }
+        uint64_t us = (can_clock.hz != 0) ? ticks * 1000000u / can_clock.hz : 0;
+        
+        CANTraceFrame_t frame;
+        frame.delta_us = (uint32_t)(us - can_trace.capture_us);
+        frame.id = entry.msg.id & 0x7FF;
+        frame.instance = entry.instance;
+        frame.length = entry.msg.length;
+        memcpy(frame.data, entry.msg.data, sizeof(frame.data));
+        
+        size_t n = CANTrace_Encode(&frame, &out[pos], size - pos);
+        if (n == 0) break;
+        Queue_Release(&can_capture_queue, 1);
+        pos += n;
+        
+        if (!can_trace.have_last || step > 0) {
+            can_trace.last_stamp = entry.msg.timestamp;
+            can_trace.have_last = true;
+        }
+        can_trace.capture_ticks = ticks;
+        can_trace.capture_us = us;
+    }
+    return pos;
+}
+
+/**
+ * @brief Queue a replayed frame lands in: rx_fast for prioritized IDs, as the filters would
+ */
+static Queue_t* CAN_replayQueue(uint8_t instance, uint16_t id) {
+    for (uint8_t r = 0; r < can_state[instance].fast_count; r++) {
+        if (id >= can_state[instance].fast[r].start && id <= can_state[instance].fast[r].end) {
+            return &can_state[instance].rx_fast;
+        }
+    }
+    return &can_state[instance].rx_queue;
+}
+
+/**
+ * @brief Decode the next replay entry and work out when it is due
+ * @return false at the end of the trace (lastError set if it was malformed)
+ */
+static bool CAN_replayAdvance(void) {
+    if (can_trace.trace_pos >= can_trace.trace_length) return false;
+    
+    size_t used;
+    plt_status_t status = CANTrace_Decode(&can_trace.trace[can_trace.trace_pos],
+                                          can_trace.trace_length - can_trace.trace_pos, &can_trace.next, &used);
+    if (status != PLT_OK) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    can_trace.trace_pos += (uint32_t)used;
+    can_trace.trace_us += can_trace.next.delta_us;
+    
+    // due = trace_us * 100 / speed in clock ticks, split so it cannot overflow
+    if (can_trace.speed != 0) {
+        uint64_t d = (uint64_t)can_trace.speed * 10000u;
+        can_trace.due_ticks = (can_trace.trace_us / d) * can_clock.hz +
+                              ((can_trace.trace_us % d) * can_clock.hz) / d;
+    }
+    return true;
+}
+
+/**
+ * @brief Move every replay entry that has come due into its RX queue
+ * @note Main loop (handleRxMessages) only: the RX interrupt stays off the queues while replaying
+ */
+static void CAN_replayPump(void) {
+    if (!can_trace.replaying) return;
+    
+    uint32_t now = CAN_clockNow();
+    can_trace.clock_ticks += now - can_trace.clock_last;
+    can_trace.clock_last = now;
+    
+    do {
+        if (can_trace.speed != 0 && can_trace.due_ticks > can_trace.clock_ticks) return;
+        
+        const CANTraceFrame_t* frame = &can_trace.next;
+        if (frame->instance >= hw_handles.can_count || hw_handles.hcan[frame->instance] == NULL) {
+            can_trace.replay_drops++;
+            continue;
+        }
+        
+        Queue_t* queue = CAN_replayQueue(frame->instance, frame->id);
+        if (can_trace.speed == 0 && Queue_IsFull(queue)) {
+            return;     // Flat out: wait for the dispatcher instead of dropping
+        }
+        CANMessage_t* msg = (CANMessage_t*)Queue_Reserve(queue);
+        if (msg == NULL) {
+            can_trace.replay_drops++;   // Timed: the bus does not wait either
+            continue;
+        }
+        msg->id = frame->id;
+        msg->length = frame->length;
+        memcpy(msg->data, frame->data, sizeof(msg->data));
+        msg->timestamp = now;
+        if (Queue_Commit(queue) == PLT_OK) {
+            can_state[frame->instance].rx_count++;
+            can_trace.replayed++;
+        }
+    } while (CAN_replayAdvance());
+    
+    can_trace.replaying = false;
+}
+#endif
+
 static void CAN_handleRxMessages_impl(uint8_t instance) {
     if (instance >= hw_handles.can_count || hw_handles.hcan[instance] == NULL) return;
     
-    CANMessage_t msg;
+    #if PLT_ENABLE_CAN_TRACE
+    CAN_replayPump();
+    #endif
     
-    // Process all messages in queue
-    while (Queue_Pop(&can_state[instance].rx_queue, &msg) == PLT_OK) {
-        // Try hashtable routing first
-        Set_Function_t handler = hash_Lookup(msg.id);
-        
-        if (handler != NULL) {
-            // Route to specific handler - pass message data buffer
-            handler(msg.data);
-        } else if (can_state[instance].default_handler != NULL) {
-            // Route to default handler
-            can_state[instance].default_handler(&msg);
+    CANMessage_t* msg;
+    
+    // Prioritized FIFO1 frames first, then the rest - handlers read the payload in place
+    while ((msg = (CANMessage_t*)Queue_PeekSlot(&can_state[instance].rx_fast)) != NULL) {
+        CAN_dispatch(instance, msg);
+        Queue_Release(&can_state[instance].rx_fast, 1);
+    }
+    while ((msg = (CANMessage_t*)Queue_PeekSlot(&can_state[instance].rx_queue)) != NULL) {
+        CAN_dispatch(instance, msg);
+        Queue_Release(&can_state[instance].rx_queue, 1);
+    }
+}
+
+/**
+ * @brief Dispatch up to maxMessages straight out of one ring
+ */
+static size_t CAN_dispatchBatch(uint8_t instance, Queue_t* queue, size_t maxMessages) {
+    // No per-message copy or index update
+    Queue_Span_t spans[2];
+    size_t count = Queue_PeekBatch(queue, spans, maxMessages);
+    
+    for (uint8_t s = 0; s < 2; s++) {
+        CANMessage_t* msgs = (CANMessage_t*)spans[s].data;
+        for (size_t i = 0; i < spans[s].count; i++) {
+            CAN_dispatch(instance, &msgs[i]);
         }
     }
+    
+    // Hand all slots back to the ISR with one tail update
+    Queue_Release(queue, count);
+    return count;
+}
+
+static uint16_t CAN_handleRxMessagesBatch_impl(uint8_t instance, uint16_t maxMessages) {
+    if (instance >= hw_handles.can_count || hw_handles.hcan[instance] == NULL) return 0;
+    
+    #if PLT_ENABLE_CAN_TRACE
+    CAN_replayPump();
+    #endif
+    
+    size_t count = CAN_dispatchBatch(instance, &can_state[instance].rx_fast, maxMessages);
+    if (maxMessages == 0 || count < maxMessages) {
+        count += CAN_dispatchBatch(instance, &can_state[instance].rx_queue,
+                                   (maxMessages == 0) ? 0 : maxMessages - count);
+    }
+    return (uint16_t)count;
 }
 
 static uint16_t CAN_availableMessages_impl(uint8_t instance) {
     if (instance >= hw_handles.can_count) return 0;
-    return (uint16_t)Queue_Count(&can_state[instance].rx_queue);
+    return (uint16_t)(Queue_Count(&can_state[instance].rx_fast) + Queue_Count(&can_state[instance].rx_queue));
 }
 
 static void CAN_route_impl(uint8_t instance, uint16_t id, void (*handler)(CANMessage_t*)) {
@@ -169,12 +857,27 @@ static void CAN_route_impl(uint8_t instance, uint16_t id, void (*handler)(CANMes
     member.id = id;
     member.Set_Function = (Set_Function_t)handler;
     
-    hash_InsertMember(&member);
+    HashStatus_t status = CAN_routeInsert(instance, &member);
+    if (status != HASH_OK) {
+        lastError = (status == HASH_FULL) ? PLT_NO_MEMORY : PLT_INVALID_PARAM;
+    }
 }
 
 static void CAN_routeRange_impl(uint8_t instance, uint16_t idStart, uint16_t idEnd, void (*handler)(CANMessage_t*)) {
-    for (uint16_t id = idStart; id <= idEnd; id++) {
-        CAN_route_impl(instance, id, handler);
+    if (instance >= hw_handles.can_count || !can_state[instance].routing_initialized || handler == NULL) {
+        return;
+    }
+    
+    if (idStart > idEnd) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    
+    // One interval entry for the whole block, found by binary search
+    HashStatus_t status = range_TableInsert(&can_state[instance].ranges, idStart, idEnd,
+                                            (Set_Function_t)handler);
+    if (status != HASH_OK) {
+        lastError = (status == HASH_FULL) ? PLT_NO_MEMORY : PLT_INVALID_PARAM;
     }
 }
 
@@ -207,11 +910,183 @@ static void CAN_setFilter_impl(uint8_t instance, uint16_t id, uint16_t mask) {
     HAL_CAN_ConfigFilter(hw_handles.hcan[instance], &filter);
 }
 
-static void CAN_setBaudrate_impl(uint8_t instance, uint32_t baudrate) {
+/**
+ * @brief Filter banks owned by an instance (CAN1: 0-13, CAN2: 14-27)
+ */
+static uint8_t CAN_filterBankBase(uint8_t instance) {
+    #if defined(CAN2)
+    if (hw_handles.hcan[instance]->Instance == CAN2) {
+        return 14;
+    }
+    #else
     (void)instance;
-    (void)baudrate;
-    // Would require HAL re-initialization
-    lastError = PLT_NOT_SUPPORTED;
+    #endif
+    return 0;
+}
+
+/**
+ * @brief Mark every ID routed on an instance in a CANFilter bitmap
+ */
+static void CAN_routeCollect(uint8_t instance, uint8_t* bitmap) {
+    #if PLT_CAN_ROUTING == PLT_CAN_ROUTING_HASH
+    const hash_table_t* table = &can_state[instance].routes;
+    for (uint16_t i = 0; i < table->size; i++) {
+        if (table->slots[i].id != HASH_EMPTY_ID) {
+            CANFilter_BitmapSet(bitmap, (uint16_t)table->slots[i].id);
+        }
+    }
+    
+    const range_table_t* ranges = &can_state[instance].ranges;
+    for (uint16_t r = 0; r < ranges->count; r++) {
+        for (uint32_t id = ranges->ranges[r].start; id <= ranges->ranges[r].end && id < CANFILTER_ID_SPACE; id++) {
+            CANFilter_BitmapSet(bitmap, (uint16_t)id);
+        }
+    }
+    #else
+    for (uint16_t id = 0; id < CANFILTER_ID_SPACE; id++) {
+        if (CAN_routeLookup(instance, id) != NULL) {
+            CANFilter_BitmapSet(bitmap, id);
+        }
+    }
+    #endif
+}
+
+static bool CAN_prioritize_impl(uint8_t instance, uint16_t idStart, uint16_t idEnd) {
+    if (instance >= hw_handles.can_count || idStart > idEnd || idEnd >= CANFILTER_ID_SPACE) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    if (can_state[instance].fast_count >= CAN_FAST_RANGES) {
+        lastError = PLT_NO_MEMORY;
+        return false;
+    }
+    
+    uint8_t n = can_state[instance].fast_count++;
+    can_state[instance].fast[n].start = idStart;
+    can_state[instance].fast[n].end = idEnd;
+    return true;
+}
+
+static bool CAN_applyRouteFilters_impl(uint8_t instance) {
+    if (instance >= hw_handles.can_count || hw_handles.hcan[instance] == NULL ||
+        !can_state[instance].routing_initialized) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    uint8_t bitmap[CANFILTER_BITMAP_BYTES] = {0};
+    CAN_routeCollect(instance, bitmap);
+    
+    uint8_t fast[CANFILTER_BITMAP_BYTES] = {0};
+    for (uint8_t r = 0; r < can_state[instance].fast_count; r++) {
+        for (uint16_t id = can_state[instance].fast[r].start; id <= can_state[instance].fast[r].end; id++) {
+            CANFilter_BitmapSet(fast, id);
+        }
+    }
+    
+    // Plan is static: 14 banks do not belong on the stack
+    static CANFilterPlan_t plan;
+    plt_status_t status = CANFilter_PlanFifo(bitmap, fast, CANFILTER_MAX_BANKS, &plan);
+    if (status != PLT_OK) {
+        // Nothing routed - keep the current filters rather than drop everything
+        lastError = status;
+        return false;
+    }
+    
+    CAN_FilterTypeDef filter;
+    filter.FilterScale = CAN_FILTERSCALE_16BIT;
+    filter.SlaveStartFilterBank = 14;  // Written on every call by the HAL - keep the split
+    
+    uint8_t base = CAN_filterBankBase(instance);
+    for (uint8_t b = 0; b < CANFILTER_MAX_BANKS; b++) {
+        filter.FilterBank = base + b;
+        filter.FilterFIFOAssignment = (b < plan.bank_count && plan.banks[b].fifo) ? CAN_FILTER_FIFO1 : CAN_FILTER_FIFO0;
+        
+        if (b >= plan.bank_count) {
+            // Release banks left over from begin() or a previous plan
+            filter.FilterMode = CAN_FILTERMODE_IDMASK;
+            filter.FilterIdHigh = filter.FilterIdLow = 0;
+            filter.FilterMaskIdHigh = filter.FilterMaskIdLow = 0;
+            filter.FilterActivation = DISABLE;
+        } else if (plan.banks[b].mode == CANFILTER_LIST16) {
+            // 16-bit entry: STDID[10:0] << 5, RTR = IDE = 0
+            const uint16_t* id = plan.banks[b].id;
+            filter.FilterMode = CAN_FILTERMODE_IDLIST;
+            filter.FilterIdLow = (uint32_t)id[0] << 5;
+            filter.FilterMaskIdLow = (uint32_t)id[1] << 5;
+            filter.FilterIdHigh = (uint32_t)id[2] << 5;
+            filter.FilterMaskIdHigh = (uint32_t)id[3] << 5;
+            filter.FilterActivation = ENABLE;
+        } else {
+            // Mask also pins RTR and IDE: standard data frames only
+            const CANFilterBank_t* bank = &plan.banks[b];
+            filter.FilterMode = CAN_FILTERMODE_IDMASK;
+            filter.FilterIdLow = (uint32_t)bank->id[0] << 5;
+            filter.FilterMaskIdLow = ((uint32_t)bank->mask[0] << 5) | 0x18;
+            filter.FilterIdHigh = (uint32_t)bank->id[1] << 5;
+            filter.FilterMaskIdHigh = ((uint32_t)bank->mask[1] << 5) | 0x18;
+            filter.FilterActivation = ENABLE;
+        }
+        
+        if (HAL_CAN_ConfigFilter(hw_handles.hcan[instance], &filter) != HAL_OK) {
+            lastError = PLT_HAL_ERROR;
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Find bxCAN bit timing for a bit rate: exact prescaler, sample point near 87.5 %
+ * @return BTR value (BRP/TS1/TS2, SJW = 1 tq), or 0 if the clock cannot produce the rate
+ */
+static uint32_t CAN_bitTiming(uint32_t pclk, uint32_t baudrate) {
+    // Most time quanta first: finer sample point placement and resynchronisation
+    for (uint32_t tq = 25; tq >= 8; tq--) {
+        if (pclk % (baudrate * tq) != 0) continue;
+        uint32_t brp = pclk / (baudrate * tq);
+        uint32_t ts1 = (tq * 7 + 4) / 8 - 1;    // Sync segment is the remaining 1 tq
+        uint32_t ts2 = tq - 1 - ts1;
+        if (brp < 1 || brp > 1024 || ts1 < 1 || ts1 > 16 || ts2 < 1 || ts2 > 8) continue;
+        return ((brp - 1) << CAN_BTR_BRP_Pos) | ((ts1 - 1) << CAN_BTR_TS1_Pos) |
+               ((ts2 - 1) << CAN_BTR_TS2_Pos) | CAN_SJW_1TQ;
+    }
+    return 0;
+}
+
+static void CAN_setBaudrate_impl(uint8_t instance, uint32_t baudrate) {
+    if (instance >= hw_handles.can_count || hw_handles.hcan[instance] == NULL || baudrate == 0) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    if (can_state[instance].baudrate == baudrate) return;
+    
+    CAN_HandleTypeDef* hcan = hw_handles.hcan[instance];
+    uint32_t btr = CAN_bitTiming(PLT_busClock(hcan->Instance), baudrate);
+    if (btr == 0) {
+        lastError = PLT_NOT_SUPPORTED;
+        return;
+    }
+    
+    // BTR is only writable in initialization mode; filters and interrupt enables survive
+    bool running = (HAL_CAN_GetState(hcan) == HAL_CAN_STATE_LISTENING);
+    if (running && HAL_CAN_Stop(hcan) != HAL_OK) {
+        lastError = PLT_HAL_ERROR;
+        return;
+    }
+    hcan->Instance->BTR = (hcan->Instance->BTR & (CAN_BTR_LBKM | CAN_BTR_SILM)) | btr;
+    hcan->Init.Prescaler = ((btr >> CAN_BTR_BRP_Pos) & CAN_BTR_BRP) + 1;
+    hcan->Init.TimeSeg1 = btr & (0xFu << CAN_BTR_TS1_Pos);
+    hcan->Init.TimeSeg2 = btr & (0x7u << CAN_BTR_TS2_Pos);
+    hcan->Init.SyncJumpWidth = CAN_SJW_1TQ;
+    can_state[instance].baudrate = baudrate;
+    
+    if (running && HAL_CAN_Start(hcan) != HAL_OK) {
+        lastError = PLT_HAL_ERROR;
+        return;
+    }
+    lastError = PLT_OK;
 }
 
 static bool CAN_isReady_impl(uint8_t instance) {
@@ -236,44 +1111,669 @@ static uint32_t CAN_getErrorCount_impl(uint8_t instance) {
     return hw_handles.hcan[instance]->ErrorCode + can_state[instance].error_count;
 }
 
+static bool CAN_setTimestampSource_impl(CANTimestampSource_t source, uint8_t timer) {
+    uint32_t hz = 0;
+    
+    #if PLT_ENABLE_CAN_TRACE
+    // Trace deltas and replay deadlines are kept in the current clock's ticks
+    if (can_trace.capturing || can_trace.replaying) {
+        lastError = PLT_BUSY;
+        return false;
+    }
+    #endif
+    
+    switch (source) {
+        case CAN_TIMESTAMP_TICK:
+            hz = 1000;
+            break;
+            
+        case CAN_TIMESTAMP_DWT:
+            #if STATS_HAVE_CYCCNT
+            Stats_EnableCycleCounter();
+            hz = SystemCoreClock;
+            break;
+            #else
+            lastError = PLT_NOT_SUPPORTED;
+            return false;
+            #endif
+            
+        case CAN_TIMESTAMP_TIMER: {
+            #ifdef HAL_TIM_MODULE_ENABLED
+            if (timer >= hw_handles.tim_count || hw_handles.htim[timer] == NULL) {
+                lastError = PLT_INVALID_PARAM;
+                return false;
+            }
+            TIM_HandleTypeDef* htim = hw_handles.htim[timer];
+            // A 16-bit timer would wrap every few milliseconds at 1 MHz
+            if (__HAL_TIM_GET_AUTORELOAD(htim) != 0xFFFFFFFFu) {
+                lastError = PLT_INVALID_PARAM;
+                return false;
+            }
+            hz = PLT_timerClock(htim->Instance) / (htim->Instance->PSC + 1u);
+            if ((htim->Instance->CR1 & TIM_CR1_CEN) == 0 && HAL_TIM_Base_Start(htim) != HAL_OK) {
+                lastError = PLT_HAL_ERROR;
+                return false;
+            }
+            can_clock.timer = htim->Instance;
+            break;
+            #else
+            (void)timer;
+            lastError = PLT_NOT_SUPPORTED;
+            return false;
+            #endif
+        }
+            
+        case CAN_TIMESTAMP_HARDWARE:
+            // The counter only runs in Time Triggered Communication Mode
+            for (uint8_t i = 0; i < hw_handles.can_count; i++) {
+                if (hw_handles.hcan[i] != NULL && hw_handles.hcan[i]->Init.TimeTriggeredMode != ENABLE) {
+                    lastError = PLT_INVALID_PARAM;
+                    return false;
+                }
+            }
+            break;
+            
+        default:
+            lastError = PLT_INVALID_PARAM;
+            return false;
+    }
+    
+    uint32_t primask = Queue_EnterCritical();
+    can_clock.source = source;
+    can_clock.hz = hz;
+    for (uint8_t i = 0; i < hw_handles.can_count; i++) {
+        memset(can_state[i].tx_stamp, 0, sizeof(can_state[i].tx_stamp));
+    }
+    Queue_ExitCritical(primask);
+    lastError = PLT_OK;
+    return true;
+}
+
+/**
+ * @brief Nominal bit rate of an instance, from its BTR register
+ */
+static uint32_t CAN_bitRate(uint8_t instance) {
+    CAN_HandleTypeDef* hcan = hw_handles.hcan[instance];
+    uint32_t btr = hcan->Instance->BTR;
+    uint32_t brp = ((btr >> CAN_BTR_BRP_Pos) & CAN_BTR_BRP) + 1u;
+    uint32_t tq = 1u + ((btr >> CAN_BTR_TS1_Pos) & 0xFu) + 1u + ((btr >> CAN_BTR_TS2_Pos) & 0x7u) + 1u;
+    return PLT_busClock(hcan->Instance) / (brp * tq);
+}
+
+static uint32_t CAN_toMicros_impl(uint8_t instance, uint32_t ticks) {
+    uint32_t hz = can_clock.hz;
+    if (can_clock.source == CAN_TIMESTAMP_HARDWARE) {
+        if (instance >= hw_handles.can_count || hw_handles.hcan[instance] == NULL) return 0;
+        hz = CAN_bitRate(instance);
+    }
+    if (hz == 0) return 0;
+    return (uint32_t)(((uint64_t)ticks * 1000000u) / hz);
+}
+
+static uint32_t CAN_elapsedMicros_impl(uint8_t instance, uint32_t start, uint32_t end) {
+    uint32_t ticks = end - start;
+    if (can_clock.source == CAN_TIMESTAMP_HARDWARE) {
+        ticks &= 0xFFFFu;   // TIME field of the mailbox registers is 16 bits
+    }
+    return CAN_toMicros_impl(instance, ticks);
+}
+
+static bool CAN_getTxTimestamp_impl(uint8_t instance, uint16_t id, uint32_t* timestamp) {
+    if (instance >= hw_handles.can_count || timestamp == NULL) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    bool found = false;
+    uint32_t primask = Queue_EnterCritical();
+    const uint8_t slot = id & (CAN_TX_STAMP_SLOTS - 1u);
+    if (can_state[instance].tx_stamp[slot].valid && can_state[instance].tx_stamp[slot].id == id) {
+        *timestamp = can_state[instance].tx_stamp[slot].time;
+        found = true;
+    }
+    Queue_ExitCritical(primask);
+    return found;
+}
+
+/* ==================== CAN Trace Implementation ==================== */
+
+#if PLT_ENABLE_CAN_TRACE
+static bool CAN_startCapture_impl(uint8_t uart) {
+    #ifdef HAL_UART_MODULE_ENABLED
+    bool uart_ok = (uart < hw_handles.uart_count && hw_handles.huart[uart] != NULL);
+    #else
+    bool uart_ok = false;
+    #endif
+    if (uart != CAN_CAPTURE_NO_UART && !uart_ok) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    if (can_trace.replaying) {
+        lastError = PLT_BUSY;
+        return false;
+    }
+    if (can_clock.source == CAN_TIMESTAMP_HARDWARE) {
+        // Per-controller 16-bit counters cannot order frames across instances
+        lastError = PLT_NOT_SUPPORTED;
+        return false;
+    }
+    
+    uint32_t primask = Queue_EnterCritical();
+    Queue_Release(&can_capture_queue, Queue_Count(&can_capture_queue));
+    can_trace.uart = uart;
+    can_trace.header_pending = true;
+    can_trace.have_last = false;
+    can_trace.capture_ticks = 0;
+    can_trace.capture_us = 0;
+    can_trace.chunk_length = 0;
+    can_trace.captured = 0;
+    can_trace.capture_drops = 0;
+    can_trace.capturing = true;
+    Queue_ExitCritical(primask);
+    lastError = PLT_OK;
+    return true;
+}
+
+static void CAN_stopCapture_impl(void) {
+    can_trace.capturing = false;
+}
+
+static void CAN_handleCapture_impl(void) {
+    if (can_trace.uart == CAN_CAPTURE_NO_UART) return;
+    
+    for (;;) {
+        size_t n = CAN_captureEncode(&can_trace.chunk[can_trace.chunk_length],
+                                     sizeof(can_trace.chunk) - can_trace.chunk_length);
+        if (n > 0 && can_trace.chunk_length == 0) {
+            can_trace.chunk_started = HAL_GetTick();
+        }
+        can_trace.chunk_length = (uint16_t)(can_trace.chunk_length + n);
+        if (can_trace.chunk_length == 0) return;
+        
+        // Full once the largest entry may not fit; otherwise wait for more, up to the flush time
+        bool full = sizeof(can_trace.chunk) - can_trace.chunk_length < CAN_TRACE_ENTRY_MAX;
+        if (!full && HAL_GetTick() - can_trace.chunk_started < CAN_CAPTURE_FLUSH_MS) return;
+        
+        // Records hold whole entries, so a lost one only loses its own frames
+        P_UART.sendRecord(can_trace.uart, TELEMETRY_TYPE_CAN_TRACE, can_trace.chunk, can_trace.chunk_length);
+        can_trace.chunk_length = 0;
+        if (!full) return;
+    }
+}
+
+static uint16_t CAN_readCapture_impl(uint8_t* buffer, uint16_t size) {
+    if (buffer == NULL || size < CAN_TRACE_ENTRY_MAX || can_trace.uart != CAN_CAPTURE_NO_UART) {
+        lastError = PLT_INVALID_PARAM;
+        return 0;
+    }
+    return (uint16_t)CAN_captureEncode(buffer, size);
+}
+
+static bool CAN_startReplay_impl(const uint8_t* trace, uint32_t length, uint16_t speedPercent) {
+    plt_status_t status = CANTrace_CheckHeader(trace, length);
+    if (status != PLT_OK) {
+        lastError = status;
+        return false;
+    }
+    if (can_trace.capturing) {
+        lastError = PLT_BUSY;
+        return false;
+    }
+    if (speedPercent != 0 && can_clock.source == CAN_TIMESTAMP_HARDWARE) {
+        // No readable clock to schedule against
+        lastError = PLT_NOT_SUPPORTED;
+        return false;
+    }
+    
+    can_trace.replaying = false;
+    can_trace.trace = trace;
+    can_trace.trace_length = length;
+    can_trace.trace_pos = CAN_TRACE_HEADER_SIZE;
+    can_trace.speed = speedPercent;
+    can_trace.trace_us = 0;
+    can_trace.due_ticks = 0;
+    can_trace.clock_ticks = 0;
+    can_trace.replayed = 0;
+    can_trace.replay_drops = 0;
+    
+    lastError = PLT_OK;
+    if (!CAN_replayAdvance()) {
+        // Empty trace: nothing to do; malformed: lastError says so
+        return lastError == PLT_OK;
+    }
+    can_trace.clock_last = CAN_clockNow();
+    can_trace.replaying = true;
+    return true;
+}
+
+static void CAN_stopReplay_impl(void) {
+    can_trace.replaying = false;
+}
+
+static bool CAN_getTraceStatus_impl(CANTraceStatus_t* out) {
+    if (out == NULL) {
+        lastError = PLT_NULL_POINTER;
+        return false;
+    }
+    
+    out->captured = can_trace.captured;
+    out->capture_drops = can_trace.capture_drops;
+    out->replayed = can_trace.replayed;
+    out->replay_drops = can_trace.replay_drops;
+    out->capturing = can_trace.capturing;
+    out->replaying = can_trace.replaying;
+    return true;
+}
+#else
+static bool CAN_startCapture_impl(uint8_t uart) {
+    (void)uart;
+    lastError = PLT_NOT_SUPPORTED;
+    return false;
+}
+
+static void CAN_stopCapture_impl(void) {
+}
+
+static void CAN_handleCapture_impl(void) {
+}
+
+static uint16_t CAN_readCapture_impl(uint8_t* buffer, uint16_t size) {
+    (void)buffer;
+    (void)size;
+    lastError = PLT_NOT_SUPPORTED;
+    return 0;
+}
+
+static bool CAN_startReplay_impl(const uint8_t* trace, uint32_t length, uint16_t speedPercent) {
+    (void)trace;
+    (void)length;
+    (void)speedPercent;
+    lastError = PLT_NOT_SUPPORTED;
+    return false;
+}
+
+static void CAN_stopReplay_impl(void) {
+}
+
+static bool CAN_getTraceStatus_impl(CANTraceStatus_t* out) {
+    (void)out;
+    lastError = PLT_NOT_SUPPORTED;
+    return false;
+}
+#endif
+
 /* ==================== UART Implementation ==================== */
 
+/**
+ * @brief Start the next TX DMA transfer if none is in flight
+ * @note Called from the main loop after queueing and from the TX-complete ISR
+ */
+static void UART_txKick(uint8_t instance) {
+    uint32_t primask = Queue_EnterCritical();
+    if (uart_state[instance].tx_busy) {
+        Queue_ExitCritical(primask);
+        return;
+    }
+    size_t n = Queue_PopBatch(&uart_state[instance].tx_queue, uart_tx_dma[instance], UART_TX_DMA_CHUNK);
+    if (n == 0) {
+        Queue_ExitCritical(primask);
+        return;
+    }
+    uart_state[instance].tx_busy = true;
+    Queue_ExitCritical(primask);
+    
+    if (HAL_UART_Transmit_DMA(hw_handles.huart[instance], uart_tx_dma[instance], (uint16_t)n) != HAL_OK) {
+        uart_state[instance].tx_busy = false;
+        uart_state[instance].tx_dropped += n;
+        lastError = PLT_HAL_ERROR;
+    }
+}
+
+/**
+ * @brief Queue bytes for DMA TX according to the instance's full-ring policy
+ * @note Does not start DMA (except while blocking on a full ring); callers
+ *       kick once after queueing everything that belongs together
+ */
+static bool UART_txEnqueue(uint8_t instance, const uint8_t* data, size_t length) {
+    Queue_t* q = &uart_state[instance].tx_queue;
+    bool queued = true;
+    
+    switch (uart_state[instance].tx_policy) {
+        case UART_TX_DROP: {
+            // All or nothing, so a dropped write never leaves half a line
+            uint32_t primask = Queue_EnterCritical();
+            if (q->capacity - Queue_Count(q) >= length) {
+                Queue_PushBatch(q, data, length);
+            } else {
+                queued = false;
+            }
+            Queue_ExitCritical(primask);
+            if (!queued) {
+                uart_state[instance].tx_dropped += length;
+                lastError = PLT_QUEUE_FULL;
+            }
+            break;
+        }
+        
+        case UART_TX_OVERWRITE: {
+            if (length > q->capacity) {
+                // Only the newest ring-full of this write can survive
+                uart_state[instance].tx_dropped += length - q->capacity;
+                data += length - q->capacity;
+                length = q->capacity;
+            }
+            uint32_t primask = Queue_EnterCritical();
+            size_t space = q->capacity - Queue_Count(q);
+            if (space < length) {
+                Queue_Release(q, length - space);
+                uart_state[instance].tx_dropped += length - space;
+            }
+            Queue_PushBatch(q, data, length);
+            Queue_ExitCritical(primask);
+            break;
+        }
+        
+        case UART_TX_BLOCK:
+        default: {
+            uint32_t start = HAL_GetTick();
+            for (;;) {
+                size_t pushed = Queue_PushBatch(q, data, length);
+                data += pushed;
+                length -= pushed;
+                if (length == 0) break;
+                
+                // Ring full: keep DMA going and wait for room
+                UART_txKick(instance);
+                if (HAL_GetTick() - start >= uart_state[instance].timeout_ms) {
+                    uart_state[instance].tx_dropped += length;
+                    lastError = PLT_TIMEOUT;
+                    queued = false;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    
+    return queued;
+}
+
+/**
+ * @brief Check ring space up front for an all-or-nothing UART_TX_DROP write
+ * @note Only the ISR drains the ring, so space can grow but never shrink here
+ */
+static bool UART_txFits(uint8_t instance, size_t length) {
+    Queue_t* q = &uart_state[instance].tx_queue;
+    if (uart_state[instance].tx_policy != UART_TX_DROP || q->capacity - Queue_Count(q) >= length) {
+        return true;
+    }
+    uart_state[instance].tx_dropped += length;
+    lastError = PLT_QUEUE_FULL;
+    return false;
+}
+
+/**
+ * @brief Send bytes: queued for DMA when available, blocking HAL otherwise
+ */
+static bool UART_output(uint8_t instance, const uint8_t* data, size_t length) {
+    STATS_START(t0);
+    if (uart_state[instance].tx_dma) {
+        bool queued = UART_txEnqueue(instance, data, length);
+        UART_txKick(instance);
+        STATS_STOP(STATS_UART_TX, t0);
+        return queued;
+    }
+    
+    HAL_StatusTypeDef status = HAL_UART_Transmit(hw_handles.huart[instance], (uint8_t*)data,
+                                                  (uint16_t)length, uart_state[instance].timeout_ms);
+    STATS_STOP(STATS_UART_TX, t0);
+    if (status != HAL_OK) {
+        lastError = PLT_HAL_ERROR;
+    }
+    return (status == HAL_OK);
+}
+
 static void UART_print_impl(uint8_t instance, const char* str) {
     if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || str == NULL) return;
     
-    HAL_UART_Transmit(hw_handles.huart[instance], (uint8_t*)str, strlen(str), uart_state[instance].timeout_ms);
+    UART_output(instance, (const uint8_t*)str, strlen(str));
+}
+
+/**
+ * @brief Send several buffers, kicking TX DMA once after all are queued
+ */
+static bool UART_outputv(uint8_t instance, const UARTSegment_t* segments, uint8_t count) {
+    bool ok = true;
+    
+    if (uart_state[instance].tx_dma) {
+        size_t total = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            total += segments[i].length;
+        }
+        if (!UART_txFits(instance, total)) {
+            return false;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            if (segments[i].data != NULL && segments[i].length > 0) {
+                ok = UART_txEnqueue(instance, (const uint8_t*)segments[i].data, segments[i].length) && ok;
+            }
+        }
+        UART_txKick(instance);
+        return ok;
+    }
+    
+    for (uint8_t i = 0; i < count && ok; i++) {
+        if (segments[i].data != NULL && segments[i].length > 0) {
+            ok = UART_output(instance, (const uint8_t*)segments[i].data, segments[i].length);
+        }
+    }
+    return ok;
+}
+
+static void UART_println_impl(uint8_t instance, const char* str) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || str == NULL) return;
+    
+    const UARTSegment_t line[2] = {
+        {str, (uint16_t)strlen(str)},
+        {"\r\n", 2}
+    };
+    UART_outputv(instance, line, 2);
+}
+
+/**
+ * @brief printf output state: TX ring directly, or a small block for blocking HAL
+ */
+typedef struct {
+    uint8_t instance;
+    uint8_t pending;                    // Bytes staged in chunk (blocking path)
+    bool ok;
+    uint8_t chunk[UART_PRINTF_CHUNK];
+} uart_format_t;
+
+static void UART_formatCount(void* context, const char* data, size_t length) {
+    (void)data;
+    *(size_t*)context += length;
+}
+
+static void UART_formatSink(void* context, const char* data, size_t length) {
+    uart_format_t* f = (uart_format_t*)context;
+    if (!f->ok) return;
+    
+    if (uart_state[f->instance].tx_dma) {
+        f->ok = UART_txEnqueue(f->instance, (const uint8_t*)data, length);
+        return;
+    }
+    
+    while (length > 0 && f->ok) {
+        size_t n = sizeof(f->chunk) - f->pending;
+        if (n > length) n = length;
+        memcpy(&f->chunk[f->pending], data, n);
+        f->pending = (uint8_t)(f->pending + n);
+        data += n;
+        length -= n;
+        if (f->pending == sizeof(f->chunk)) {
+            f->ok = UART_output(f->instance, f->chunk, f->pending);
+            f->pending = 0;
+        }
+    }
+}
+
+static void UART_printf_impl(uint8_t instance, const char* fmt, ...) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || fmt == NULL) return;
+    
+    uart_format_t f = {.instance = instance, .pending = 0, .ok = true};
+    va_list args;
+    va_start(args, fmt);
+    
+    if (uart_state[instance].tx_dma && uart_state[instance].tx_policy == UART_TX_DROP) {
+        // Measure first so a dropped line is dropped whole
+        size_t total = 0;
+        va_list measure;
+        va_copy(measure, args);
+        plt_vformat(UART_formatCount, &total, fmt, measure);
+        va_end(measure);
+        f.ok = UART_txFits(instance, total);
+    }
+    
+    if (f.ok) {
+        plt_vformat(UART_formatSink, &f, fmt, args);
+    }
+    va_end(args);
+    
+    if (uart_state[instance].tx_dma) {
+        UART_txKick(instance);
+    } else if (f.ok && f.pending > 0) {
+        UART_output(instance, f.chunk, f.pending);
+    }
+}
+
+static bool UART_write_impl(uint8_t instance, const uint8_t* data, uint16_t length) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || data == NULL || length == 0) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    bool ok = UART_output(instance, data, length);
+    if (ok) {
+        lastError = PLT_OK;
+    }
+    return ok;
+}
+
+static bool UART_writev_impl(uint8_t instance, const UARTSegment_t* segments, uint8_t count) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || segments == NULL || count == 0) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    bool ok = UART_outputv(instance, segments, count);
+    if (ok) {
+        lastError = PLT_OK;
+    }
+    return ok;
+}
+
+static bool UART_sendRecord_impl(uint8_t instance, uint8_t type, const void* data, uint16_t length) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    size_t n = Telemetry_Encode(type, uart_state[instance].tx_seq, data, length,
+                                uart_record_frame, sizeof(uart_record_frame));
+    if (n == 0) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    // Advance even if the frame is dropped, so the host sees the gap
+    uart_state[instance].tx_seq++;
+    bool ok = UART_output(instance, uart_record_frame, n);
+    if (ok) {
+        lastError = PLT_OK;
+    }
+    return ok;
+}
+
+/**
+ * @brief Start RX in the mode the handle supports: circular DMA or per-byte IT
+ */
+static void UART_startRx(uint8_t instance) {
+    UART_HandleTypeDef* huart = hw_handles.huart[instance];
+    
+    #if PLT_UART_DMA_RX && defined(HAL_DMA_MODULE_ENABLED)
+    if (huart->hdmarx != NULL && huart->hdmarx->Init.Mode == DMA_CIRCULAR) {
+        // Events arrive on IDLE, half and full ring - not per byte
+        uart_state[instance].rx_dma = true;
+        uart_state[instance].rx_dma_pos = 0;
+        if (HAL_UARTEx_ReceiveToIdle_DMA(huart, uart_state[instance].rx_buffer, UART_RX_DMA_SIZE) != HAL_OK) {
+            lastError = PLT_HAL_ERROR;
+        }
+        return;
+    }
+    #endif
+    
+    uart_state[instance].rx_dma = false;
+    HAL_UART_Receive_IT(huart, &uart_state[instance].rx_buffer[uart_state[instance].rx_index], 1);
 }
 
-static void UART_println_impl(uint8_t instance, const char* str) {
-    UART_print_impl(instance, str);
-    UART_print_impl(instance, "\r\n");
+/**
+ * @brief Apply RX restarts of the error ISR: skip rx_read to the restart boundary
+ *
+ * The ISR never touches rx_read/rx_overruns, so a restart landing in the middle
+ * of a read is picked up here on the next one.
+ */
+static void UART_dmaResync(uint8_t instance) {
+    uint32_t resync, skipped;
+    do {
+        resync = uart_state[instance].rx_resync;
+        skipped = uart_state[instance].rx_skipped;
+    } while (resync != uart_state[instance].rx_resync);
+    
+    if ((int32_t)(resync - uart_state[instance].rx_read) > 0) {
+        // Everything before the boundary is gone: unread bytes count as overruns
+        uart_state[instance].rx_overruns += resync - uart_state[instance].rx_read -
+                                            (skipped - uart_state[instance].rx_skipped_seen);
+        uart_state[instance].rx_read = resync;
+    }
+    uart_state[instance].rx_skipped_seen = skipped;
 }
 
-static void UART_printf_impl(uint8_t instance, const char* fmt, ...) {
-    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL) return;
-    
-    char buffer[256];
-    va_list args;
-    va_start(args, fmt);
-    int len = vsnprintf(buffer, sizeof(buffer), fmt, args);
-    va_end(args);
+/**
+ * @brief Bytes waiting in the DMA ring; drops the oldest if the DMA lapped the reader
+ */
+static uint32_t UART_dmaPending(uint8_t instance) {
+    // rx_written before the resync check: a restart in between leaves rx_read ahead
+    uint32_t written = uart_state[instance].rx_written;
+    UART_dmaResync(instance);
     
-    if (len > 0) {
-        HAL_UART_Transmit(hw_handles.huart[instance], (uint8_t*)buffer, len, uart_state[instance].timeout_ms);
+    if ((int32_t)(written - uart_state[instance].rx_read) <= 0) {
+        return 0;
     }
+    uint32_t pending = written - uart_state[instance].rx_read;
+    if (pending > UART_RX_DMA_SIZE) {
+        uart_state[instance].rx_overruns += pending - UART_RX_DMA_SIZE;
+        uart_state[instance].rx_read = written - UART_RX_DMA_SIZE;
+        pending = UART_RX_DMA_SIZE;
+    }
+    return pending;
 }
 
-static bool UART_write_impl(uint8_t instance, const uint8_t* data, uint16_t length) {
-    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || data == NULL || length == 0) {
-        lastError = PLT_INVALID_PARAM;
-        return false;
-    }
+/**
+ * @brief Copy up to length bytes out of the DMA ring (at most two memcpy)
+ */
+static uint16_t UART_dmaRead(uint8_t instance, uint8_t* buffer, uint16_t length) {
+    uint32_t count = UART_dmaPending(instance);
+    if (count > length) count = length;
     
-    HAL_StatusTypeDef status = HAL_UART_Transmit(hw_handles.huart[instance], (uint8_t*)data, 
-                                                  length, uart_state[instance].timeout_ms);
+    uint32_t offset = uart_state[instance].rx_read & (UART_RX_DMA_SIZE - 1);
+    uint32_t first = UART_RX_DMA_SIZE - offset;
+    if (first > count) first = count;
     
-    lastError = (status == HAL_OK) ? PLT_OK : PLT_HAL_ERROR;
-    return (status == HAL_OK);
+    memcpy(buffer, &uart_state[instance].rx_buffer[offset], first);
+    memcpy(buffer + first, &uart_state[instance].rx_buffer[0], count - first);
+    uart_state[instance].rx_read += count;
+    return (uint16_t)count;
 }
 
 static void UART_handleRxData_impl(uint8_t instance) {
@@ -284,12 +1784,19 @@ static void UART_handleRxData_impl(uint8_t instance) {
 
 static uint16_t UART_availableBytes_impl(uint8_t instance) {
     if (instance >= hw_handles.uart_count) return 0;
+    if (uart_state[instance].rx_dma) {
+        return (uint16_t)UART_dmaPending(instance);
+    }
     return (uint16_t)Queue_Count(&uart_state[instance].rx_queue);
 }
 
 static uint8_t UART_read_impl(uint8_t instance) {
     if (instance >= hw_handles.uart_count) return 0;
     uint8_t byte = 0;
+    if (uart_state[instance].rx_dma) {
+        UART_dmaRead(instance, &byte, 1);
+        return byte;
+    }
     Queue_Pop(&uart_state[instance].rx_queue, &byte);
     return byte;
 }
@@ -297,6 +1804,10 @@ static uint8_t UART_read_impl(uint8_t instance) {
 static uint16_t UART_readBytes_impl(uint8_t instance, uint8_t* buffer, uint16_t length) {
     if (instance >= hw_handles.uart_count || buffer == NULL || length == 0) return 0;
     
+    if (uart_state[instance].rx_dma) {
+        return UART_dmaRead(instance, buffer, length);
+    }
+    
     uint16_t count = 0;
     while (count < length && Queue_Pop(&uart_state[instance].rx_queue, &buffer[count]) == PLT_OK) {
         count++;
@@ -304,13 +1815,6 @@ static uint16_t UART_readBytes_impl(uint8_t instance, uint8_t* buffer, uint16_t
     return count;
 }
 
-static void UART_setBaudrate_impl(uint8_t instance, uint32_t baudrate) {
-    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL) return;
-    
-    hw_handles.huart[instance]->Init.BaudRate = baudrate;
-    HAL_UART_Init(hw_handles.huart[instance]);
-}
-
 static void UART_setTimeout_impl(uint8_t instance, uint16_t ms) {
     if (instance >= hw_handles.uart_count) return;
     uart_state[instance].timeout_ms = ms;
@@ -321,15 +1825,186 @@ static bool UART_isReady_impl(uint8_t instance) {
     return (HAL_UART_GetState(hw_handles.huart[instance]) == HAL_UART_STATE_READY);
 }
 
+static void UART_setTxPolicy_impl(uint8_t instance, UARTTxPolicy_t policy) {
+    if (instance >= hw_handles.uart_count) return;
+    uart_state[instance].tx_policy = policy;
+}
+
+static bool UART_flush_impl(uint8_t instance) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL) return false;
+    if (!uart_state[instance].tx_dma) return true;  // Blocking writes are already on the wire
+    
+    uint32_t start = HAL_GetTick();
+    while (uart_state[instance].tx_busy || !Queue_IsEmpty(&uart_state[instance].tx_queue)) {
+        UART_txKick(instance);
+        if (HAL_GetTick() - start >= uart_state[instance].timeout_ms) {
+            lastError = PLT_TIMEOUT;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void UART_setBaudrate_impl(uint8_t instance, uint32_t baudrate) {
+    if (instance >= hw_handles.uart_count || hw_handles.huart[instance] == NULL || baudrate == 0) return;
+    
+    UART_HandleTypeDef* huart = hw_handles.huart[instance];
+    if (huart->Init.BaudRate == baudrate) return;
+    
+#if defined(UART_BRR_SAMPLING16)
+    // Let queued output leave at the old rate, then rewrite BRR in place (RX DMA keeps running)
+    UART_flush_impl(instance);
+    uint32_t pclk = PLT_busClock(huart->Instance);
+    huart->Instance->BRR = (huart->Init.OverSampling == UART_OVERSAMPLING_8) ?
+                           UART_BRR_SAMPLING8(pclk, baudrate) : UART_BRR_SAMPLING16(pclk, baudrate);
+    huart->Init.BaudRate = baudrate;
+#else
+    // Families with the newer USART block need UE cleared for BRR; let the HAL do it
+    huart->Init.BaudRate = baudrate;
+    HAL_UART_Init(huart);
+#endif
+}
+
 /* ==================== SPI Implementation ==================== */
 #ifdef HAL_SPI_MODULE_ENABLED
 
+/**
+ * @brief Start a transaction in DMA or interrupt mode
+ */
+static HAL_StatusTypeDef SPI_startTransfer(uint8_t instance, SPITransaction_t* txn) {
+    SPI_HandleTypeDef* hspi = hw_handles.hspi[instance];
+    
+    if (spi_state[instance].dma) {
+        if (txn->tx == NULL) return HAL_SPI_Receive_DMA(hspi, txn->rx, txn->length);
+        if (txn->rx == NULL) return HAL_SPI_Transmit_DMA(hspi, (uint8_t*)txn->tx, txn->length);
+        return HAL_SPI_TransmitReceive_DMA(hspi, (uint8_t*)txn->tx, txn->rx, txn->length);
+    }
+    if (txn->tx == NULL) return HAL_SPI_Receive_IT(hspi, txn->rx, txn->length);
+    if (txn->rx == NULL) return HAL_SPI_Transmit_IT(hspi, (uint8_t*)txn->tx, txn->length);
+    return HAL_SPI_TransmitReceive_IT(hspi, (uint8_t*)txn->tx, txn->rx, txn->length);
+}
+
+/**
+ * @brief Apply SCK rate and SPI mode with a direct CR1 update
+ * @note No-op when the request matches the cached setting. The bus must be idle:
+ *       BR/CPOL/CPHA only change with SPE cleared, and the HAL sets SPE again
+ *       at the start of the next transfer.
+ */
+static void SPI_configure(uint8_t instance, uint32_t hz, uint8_t mode) {
+    if (hz == spi_state[instance].clock_hz && mode == spi_state[instance].mode) return;
+    
+    SPI_HandleTypeDef* hspi = hw_handles.hspi[instance];
+    uint32_t pclk = PLT_busClock(hspi->Instance);
+    
+    // Fastest prescaler (2^(br+1)) that does not exceed the requested rate
+    uint32_t br = 0;
+    while (br < 7 && (pclk >> (br + 1)) > hz) {
+        br++;
+    }
+    uint32_t bits = (br << SPI_CR1_BR_Pos) | ((mode & 2u) ? SPI_CR1_CPOL : 0u) | ((mode & 1u) ? SPI_CR1_CPHA : 0u);
+    uint32_t cr1 = hspi->Instance->CR1;
+    if ((cr1 & (SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA)) != bits) {
+        hspi->Instance->CR1 = cr1 & ~SPI_CR1_SPE;
+        hspi->Instance->CR1 = (cr1 & ~(SPI_CR1_SPE | SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA)) | bits;
+    }
+    
+    // Keep the handle in step so a later HAL_SPI_Init() reproduces this setting
+    hspi->Init.BaudRatePrescaler = bits & SPI_CR1_BR;
+    hspi->Init.CLKPolarity = bits & SPI_CR1_CPOL;
+    hspi->Init.CLKPhase = bits & SPI_CR1_CPHA;
+    spi_state[instance].clock_hz = hz;
+    spi_state[instance].mode = mode;
+}
+
+/**
+ * @brief Retire the active transaction: release chip select, hand it to handleRxData
+ * @note Runs in the SPI interrupt, or in thread context when a start fails
+ */
+static void SPI_finish(uint8_t instance, plt_status_t status) {
+    SPITransaction_t* txn = spi_state[instance].active;
+    if (txn == NULL) return;
+    
+    if (txn->cs_port != NULL) {
+        HAL_GPIO_WritePin(txn->cs_port, txn->cs_pin, GPIO_PIN_SET);
+    }
+    STATS_SAMPLE(STATS_SPI_TRANSFER, Stats_Now() - spi_state[instance].started);
+    if (status == PLT_OK && txn->rx != NULL) {
+        spi_state[instance].done_bytes += txn->length;
+    }
+    txn->status = status;
+    // submit() bounds outstanding transactions to the RX queue depth, so this never fails
+    Queue_Push(&spi_state[instance].rx_queue, &txn);
+    spi_state[instance].active = NULL;
+}
+
+/**
+ * @brief Put the next queued transaction on the bus if it is idle
+ * @note Called after submit, after a blocking transfer, and from the completion ISR
+ */
+static void SPI_startNext(uint8_t instance) {
+    for (;;) {
+        uint32_t primask = Queue_EnterCritical();
+        SPITransaction_t* txn = NULL;
+        if (spi_state[instance].active != NULL || spi_state[instance].busy ||
+            Queue_Pop(&spi_state[instance].txn_queue, &txn) != PLT_OK) {
+            Queue_ExitCritical(primask);
+            return;
+        }
+        spi_state[instance].active = txn;
+        Queue_ExitCritical(primask);
+        
+        if (txn->clock_hz != 0) {
+            SPI_configure(instance, txn->clock_hz, txn->mode);
+        }
+        if (txn->cs_port != NULL) {
+            HAL_GPIO_WritePin(txn->cs_port, txn->cs_pin, GPIO_PIN_RESET);
+        }
+        #if PLT_ENABLE_STATS
+        spi_state[instance].started = Stats_Now();
+        #endif
+        if (SPI_startTransfer(instance, txn) == HAL_OK) {
+            return;
+        }
+        SPI_finish(instance, PLT_HAL_ERROR);
+    }
+}
+
+static bool SPI_isBusy_impl(uint8_t instance) {
+    if (instance >= hw_handles.spi_count) return false;
+    return spi_state[instance].active != NULL || !Queue_IsEmpty(&spi_state[instance].txn_queue);
+}
+
 static void SPI_transfer_impl(uint8_t instance, uint8_t* txData, uint8_t* rxData, uint16_t length) {
     if (instance >= hw_handles.spi_count || hw_handles.hspi[instance] == NULL || txData == NULL || rxData == NULL || length == 0) {
+        lastError = PLT_INVALID_PARAM;
         return;
     }
     
-    HAL_SPI_TransmitReceive(hw_handles.hspi[instance], txData, rxData, length, 1000);
+    // Let queued transactions drain, then hold the bus against new ones
+    uint32_t start = HAL_GetTick();
+    for (;;) {
+        uint32_t primask = Queue_EnterCritical();
+        bool idle = (spi_state[instance].active == NULL && Queue_IsEmpty(&spi_state[instance].txn_queue));
+        if (idle) {
+            spi_state[instance].busy = true;
+        }
+        Queue_ExitCritical(primask);
+        if (idle) break;
+        if (HAL_GetTick() - start >= SPI_TIMEOUT_MS) {
+            lastError = PLT_BUSY;
+            return;
+        }
+    }
+    
+    STATS_START(t0);
+    HAL_StatusTypeDef status = HAL_SPI_TransmitReceive(hw_handles.hspi[instance], txData, rxData, length, SPI_TIMEOUT_MS);
+    STATS_STOP(STATS_SPI_TRANSFER, t0);
+    spi_state[instance].busy = false;
+    SPI_startNext(instance);
+    
+    if (status != HAL_OK) {
+        lastError = (status == HAL_TIMEOUT) ? PLT_TIMEOUT : PLT_HAL_ERROR;
+    }
 }
 
 static uint8_t SPI_transferByte_impl(uint8_t instance, uint8_t data) {
@@ -338,28 +2013,89 @@ static uint8_t SPI_transferByte_impl(uint8_t instance, uint8_t data) {
     return rx;
 }
 
+static bool SPI_submit_impl(uint8_t instance, SPITransaction_t* txn) {
+    if (instance >= hw_handles.spi_count || hw_handles.hspi[instance] == NULL || txn == NULL ||
+        txn->length == 0 || (txn->tx == NULL && txn->rx == NULL)) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+    uint32_t primask = Queue_EnterCritical();
+    // Every outstanding transaction must fit in the completion queue
+    size_t outstanding = Queue_Count(&spi_state[instance].txn_queue) + Queue_Count(&spi_state[instance].rx_queue) +
+                         (spi_state[instance].active != NULL ? 1 : 0);
+    bool queued = (outstanding < SPI_RX_QUEUE_SIZE);
+    if (queued) {
+        txn->status = PLT_BUSY;
+        queued = (Queue_Push(&spi_state[instance].txn_queue, &txn) == PLT_OK);
+    }
+    Queue_ExitCritical(primask);
+    
+    if (!queued) {
+        lastError = PLT_QUEUE_FULL;
+        return false;
+    }
+    SPI_startNext(instance);
+    return true;
+}
+
 static void SPI_handleRxData_impl(uint8_t instance) {
-    (void)instance;
-    // SPI is synchronous, no background handling needed
+    if (instance >= hw_handles.spi_count) return;
+    
+    SPITransaction_t* txn;
+    while (Queue_Pop(&spi_state[instance].rx_queue, &txn) == PLT_OK) {
+        if (txn->status == PLT_OK && txn->rx != NULL) {
+            uint32_t primask = Queue_EnterCritical();
+            spi_state[instance].done_bytes -= txn->length;
+            Queue_ExitCritical(primask);
+        }
+        if (txn->onComplete != NULL) {
+            txn->onComplete(txn);
+        }
+    }
 }
 
 static uint16_t SPI_availableBytes_impl(uint8_t instance) {
     if (instance >= hw_handles.spi_count) return 0;
-    return (uint16_t)Queue_Count(&spi_state[instance].rx_queue);
+    uint32_t bytes = spi_state[instance].done_bytes;
+    return (uint16_t)((bytes > 0xFFFF) ? 0xFFFF : bytes);
+}
+
+/**
+ * @brief Reconfigure only while no transfer owns the bus
+ */
+static void SPI_reconfigure(uint8_t instance, uint32_t hz, uint8_t mode) {
+    uint32_t primask = Queue_EnterCritical();
+    bool idle = (spi_state[instance].active == NULL && !spi_state[instance].busy);
+    if (idle) {
+        spi_state[instance].busy = true;
+    }
+    Queue_ExitCritical(primask);
+    
+    if (!idle) {
+        lastError = PLT_BUSY;
+        return;
+    }
+    SPI_configure(instance, hz, mode);
+    spi_state[instance].busy = false;
+    SPI_startNext(instance);
+    lastError = PLT_OK;
 }
 
 static void SPI_setClockSpeed_impl(uint8_t instance, uint32_t hz) {
-    (void)instance;
-    (void)hz;
-    // Would require HAL re-initialization
-    lastError = PLT_NOT_SUPPORTED;
+    if (instance >= hw_handles.spi_count || hw_handles.hspi[instance] == NULL || hz == 0) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    SPI_reconfigure(instance, hz, spi_state[instance].mode);
 }
 
 static void SPI_setMode_impl(uint8_t instance, uint8_t mode) {
-    (void)instance;
-    (void)mode;
-    // Would require HAL re-initialization
-    lastError = PLT_NOT_SUPPORTED;
+    if (instance >= hw_handles.spi_count || hw_handles.hspi[instance] == NULL || mode > 3) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    SPI_reconfigure(instance, spi_state[instance].clock_hz, mode);
 }
 
 static void SPI_select_impl(GPIO_TypeDef* port, uint16_t pin) {
@@ -375,6 +2111,8 @@ static void SPI_deselect_impl(GPIO_TypeDef* port, uint16_t pin) {
 // Stub implementations when SPI not enabled
 static void SPI_transfer_impl(uint8_t instance, uint8_t* txData, uint8_t* rxData, uint16_t length) { (void)instance; (void)txData; (void)rxData; (void)length; lastError = PLT_NOT_SUPPORTED; }
 static uint8_t SPI_transferByte_impl(uint8_t instance, uint8_t data) { (void)instance; (void)data; lastError = PLT_NOT_SUPPORTED; return 0; }
+static bool SPI_submit_impl(uint8_t instance, SPITransaction_t* txn) { (void)instance; (void)txn; lastError = PLT_NOT_SUPPORTED; return false; }
+static bool SPI_isBusy_impl(uint8_t instance) { (void)instance; return false; }
 static void SPI_handleRxData_impl(uint8_t instance) { (void)instance; }
 static uint16_t SPI_availableBytes_impl(uint8_t instance) { (void)instance; return 0; }
 static void SPI_setClockSpeed_impl(uint8_t instance, uint32_t hz) { (void)instance; (void)hz; lastError = PLT_NOT_SUPPORTED; }
@@ -390,9 +2128,15 @@ static void SPI_deselect_impl(GPIO_TypeDef* port, uint16_t pin) { (void)port; (v
 static uint16_t ADC_readRaw_impl(uint8_t instance, uint8_t channel) {
     if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) return 0;
     
-    // For DMA mode, read from buffer
-    if (adc_state[instance].dma_buffer != NULL && channel < adc_state[instance].buffer_size) {
-        return adc_state[instance].dma_buffer[channel];
+    // Scan running: latest DMA sample, no HAL call
+    if (adc_state[instance].dma_buffer != NULL) {
+        uint8_t rank = (channel < ADC_CHANNEL_SLOTS) ? adc_state[instance].rank[channel] : 0xFF;
+        if (rank == 0xFF) {
+            lastError = PLT_INVALID_PARAM;
+            return 0;
+        }
+        ADCFilter_t* filter = adc_state[instance].filter[rank];
+        return (filter != NULL) ? filter->output : adc_state[instance].latest[rank];
     }
     
     // For polling mode, start conversion
@@ -404,54 +2148,299 @@ static uint16_t ADC_readRaw_impl(uint8_t instance, uint8_t channel) {
     return value;
 }
 
-static float ADC_readVoltage_impl(uint8_t instance, uint8_t channel) {
-    uint16_t raw = ADC_readRaw_impl(instance, channel);
+/**
+ * @brief Recompute the conversion factors after a resolution or reference change
+ */
+static void ADC_updateScale(uint8_t instance) {
+    float full_scale = (float)((1u << adc_state[instance].bits) - 1u);
+    adc_state[instance].scale = adc_state[instance].vref / full_scale;
+    adc_state[instance].scale_q24 = (uint32_t)(adc_state[instance].scale * 16777216.0f + 0.5f);
+}
+
+/**
+ * @brief Resolution in bits of a HAL Init.Resolution value
+ */
+static uint8_t ADC_resolutionBits(uint32_t resolution) {
+    switch (resolution) {
+        #if defined(ADC_RESOLUTION_12B)
+        case ADC_RESOLUTION_10B: return 10;
+        case ADC_RESOLUTION_8B:  return 8;
+        case ADC_RESOLUTION_6B:  return 6;
+        #elif defined(ADC_RESOLUTION12b)
+        case ADC_RESOLUTION10b: return 10;
+        case ADC_RESOLUTION8b:  return 8;
+        case ADC_RESOLUTION6b:  return 6;
+        #endif
+        default: return 12;
+    }
+}
+
+static float ADC_readVoltage_impl(uint8_t instance, uint8_t channel) {
+    uint16_t raw = ADC_readRaw_impl(instance, channel);
+    if (instance >= hw_handles.adc_count) return 0.0f;
+    return (float)raw * adc_state[instance].scale;
+}
+
+static uint32_t ADC_readVoltageQ16_impl(uint8_t instance, uint8_t channel) {
+    uint16_t raw = ADC_readRaw_impl(instance, channel);
+    if (instance >= hw_handles.adc_count) return 0;
+    // raw * Q8.24 stays below 2^32 for any reference under 256 V
+    return (raw * adc_state[instance].scale_q24) >> 8;
+}
+
+static uint16_t ADC_readVoltageBlock_impl(uint8_t instance, float* volts, uint16_t capacity) {
+    if (instance >= hw_handles.adc_count || adc_state[instance].dma_buffer == NULL) {
+        lastError = PLT_NOT_INITIALIZED;
+        return 0;
+    }
+    if (volts == NULL) {
+        lastError = PLT_NULL_POINTER;
+        return 0;
+    }
+    
+    uint16_t n = adc_state[instance].buffer_size;
+    if (capacity < n) {
+        lastError = PLT_INVALID_PARAM;
+        return 0;
+    }
+    
+    // The published half stays untouched until DMA comes back to it, one half-period from now
+    const volatile uint16_t* block = adc_state[instance].latest + adc_state[instance].count - n;
+    float scale = adc_state[instance].scale;
+    
+    #if PLT_USE_CMSIS_DSP
+    // Samples are below 2^15, so they read unchanged as q15; q15_to_float divides by 32768
+    arm_q15_to_float((const q15_t*)(uintptr_t)block, volts, n);
+    arm_scale_f32(volts, scale * 32768.0f, volts, n);
+    #else
+    for (uint16_t i = 0; i < n; i++) {
+        volts[i] = (float)block[i] * scale;
+    }
+    #endif
+    
+    lastError = PLT_OK;
+    return n;
+}
+
+static void ADC_handleConversions_impl(uint8_t instance) {
+    (void)instance;
+    // DMA handles conversions automatically
+}
+
+static void ADC_setResolution_impl(uint8_t instance, uint8_t bits) {
+    if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) return;
+    
+    uint32_t resolution;
+    switch (bits) {
+        // Different STM32 families use different constant naming
+        #if defined(ADC_RESOLUTION_12B)
+        case 12: resolution = ADC_RESOLUTION_12B; break;
+        case 10: resolution = ADC_RESOLUTION_10B; break;
+        case 8:  resolution = ADC_RESOLUTION_8B; break;
+        case 6:  resolution = ADC_RESOLUTION_6B; break;
+        #elif defined(ADC_RESOLUTION12b)
+        case 12: resolution = ADC_RESOLUTION12b; break;
+        case 10: resolution = ADC_RESOLUTION10b; break;
+        case 8:  resolution = ADC_RESOLUTION8b; break;
+        case 6:  resolution = ADC_RESOLUTION6b; break;
+        #endif
+        default: return;
+    }
+    
+    hw_handles.hadc[instance]->Init.Resolution = resolution;
+    adc_state[instance].idle_init.Resolution = resolution;  // Survives stopScan
+    HAL_ADC_Init(hw_handles.hadc[instance]);
+    
+    adc_state[instance].bits = bits;
+    ADC_updateScale(instance);
+}
+
+static void ADC_setReference_impl(uint8_t instance, float voltage) {
+    if (instance >= hw_handles.adc_count) return;
+    adc_state[instance].vref = voltage;
+    ADC_updateScale(instance);
+}
+
+static void ADC_calibrate_impl(uint8_t instance) {
+    if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) return;
+    
+#ifdef HAL_ADCEx_Calibration_Start
+    HAL_ADCEx_Calibration_Start(hw_handles.hadc[instance]);
+#endif
+}
+
+static void ADC_stopScan_impl(uint8_t instance) {
+    if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) return;
+    if (adc_state[instance].dma_buffer == NULL) return;
+    
+    HAL_ADC_Stop_DMA(hw_handles.hadc[instance]);
+    adc_state[instance].dma_buffer = NULL;
+    
+    hw_handles.hadc[instance]->Init = adc_state[instance].idle_init;
+    HAL_ADC_Init(hw_handles.hadc[instance]);
+}
+
+static bool ADC_startScan_impl(uint8_t instance, const ADCScanConfig_t* config) {
+    if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) {
+        lastError = PLT_NOT_INITIALIZED;
+        return false;
+    }
+    if (config == NULL || config->channels == NULL) {
+        lastError = PLT_NULL_POINTER;
+        return false;
+    }
+    if (config->count == 0 || config->count > ADC_MAX_SCAN_CHANNELS) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    for (uint8_t i = 0; i < config->count; i++) {
+        if (config->channels[i] >= ADC_CHANNEL_SLOTS) {
+            lastError = PLT_INVALID_PARAM;
+            return false;
+        }
+    }
+    
+    bool triggered = (config->trigger_timer != ADC_TRIGGER_NONE);
+    if (triggered) {
+        #ifdef HAL_TIM_MODULE_ENABLED
+        bool valid = (config->trigger_timer < hw_handles.tim_count && hw_handles.htim[config->trigger_timer] != NULL);
+        #else
+        bool valid = false;
+        #endif
+        if (!valid) {
+            lastError = PLT_INVALID_PARAM;
+            return false;
+        }
+    }
+    
+    ADC_HandleTypeDef* hadc = hw_handles.hadc[instance];
+    if (adc_state[instance].dma_buffer != NULL) {
+        HAL_ADC_Stop_DMA(hadc);
+        adc_state[instance].dma_buffer = NULL;
+    } else {
+        adc_state[instance].idle_init = hadc->Init;
+    }
+    
+    // Regular group: scan, circular DMA requests, hardware trigger or continuous
+    #if defined(ADC_SCAN_ENABLE)
+    hadc->Init.ScanConvMode = ADC_SCAN_ENABLE;
+    #else
+    hadc->Init.ScanConvMode = ENABLE;
+    #endif
+    hadc->Init.NbrOfConversion = config->count;
+    hadc->Init.DMAContinuousRequests = ENABLE;
+    hadc->Init.ContinuousConvMode = !triggered ? ENABLE : DISABLE;
+    if (!triggered) {
+        hadc->Init.ExternalTrigConv = ADC_SOFTWARE_START;
+    }
+    #if defined(ADC_EXTERNALTRIGCONVEDGE_NONE) && defined(ADC_EXTERNALTRIGCONVEDGE_RISING)
+    hadc->Init.ExternalTrigConvEdge = !triggered ? ADC_EXTERNALTRIGCONVEDGE_NONE : ADC_EXTERNALTRIGCONVEDGE_RISING;
+    #endif
+    if (HAL_ADC_Init(hadc) != HAL_OK) {
+        lastError = PLT_HAL_ERROR;
+        return false;
+    }
+    
+    memset(adc_state[instance].rank, 0xFF, sizeof(adc_state[instance].rank));
+    memset((void*)adc_state[instance].filter, 0, sizeof(adc_state[instance].filter));
+    for (uint8_t i = 0; i < config->count; i++) {
+        ADC_ChannelConfTypeDef channel = {0};
+        channel.Channel = config->channels[i];
+        channel.Rank = i + 1u;
+        channel.SamplingTime = config->sampling_time;
+        if (HAL_ADC_ConfigChannel(hadc, &channel) != HAL_OK) {
+            lastError = PLT_HAL_ERROR;
+            return false;
+        }
+        adc_state[instance].rank[config->channels[i]] = i;
+    }
+    
+    uint16_t* buffer = adc_scan_storage[instance];
+    uint16_t half = (uint16_t)(config->count * ADC_SCAN_BLOCK);
+    memset(buffer, 0, 2u * half * sizeof(uint16_t));
+    adc_state[instance].count = config->count;
+    adc_state[instance].buffer_size = half;
+    adc_state[instance].latest = &buffer[half - config->count];
+    adc_state[instance].blocks = 0;
+    adc_state[instance].dma_buffer = buffer;
+    
+    if (HAL_ADC_Start_DMA(hadc, (uint32_t*)buffer, 2u * half) != HAL_OK) {
+        adc_state[instance].dma_buffer = NULL;
+        lastError = PLT_HAL_ERROR;
+        return false;
+    }
+    
+    #ifdef HAL_TIM_MODULE_ENABLED
+    if (triggered) {
+        TIM_HandleTypeDef* htim = hw_handles.htim[config->trigger_timer];
+        
+        // Update event -> TRGO: one sequence per timer period
+        #if defined(TIM_CR2_MMS) && defined(TIM_TRGO_UPDATE)
+        htim->Instance->CR2 = (htim->Instance->CR2 & ~TIM_CR2_MMS) | TIM_TRGO_UPDATE;
+        #endif
+        // A timer already running PWM keeps its counter; only start an idle one
+        if ((htim->Instance->CR1 & TIM_CR1_CEN) == 0 && HAL_TIM_Base_Start(htim) != HAL_OK) {
+            ADC_stopScan_impl(instance);
+            lastError = PLT_HAL_ERROR;
+            return false;
+        }
+    }
+    #endif
+    
+    lastError = PLT_OK;
+    return true;
+}
+
+static bool ADC_attachFilter_impl(uint8_t instance, uint8_t channel, ADCFilter_t* filter) {
+    if (instance >= hw_handles.adc_count || adc_state[instance].dma_buffer == NULL) {
+        lastError = PLT_NOT_INITIALIZED;
+        return false;
+    }
+    uint8_t rank = (channel < ADC_CHANNEL_SLOTS) ? adc_state[instance].rank[channel] : 0xFF;
+    if (rank == 0xFF) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
     
-    // Assume 12-bit ADC
-    float max_value = 4095.0f;
-    return (raw / max_value) * adc_state[instance].vref;
+    // Reset before publishing: the DMA callback may pick it up right away
+    ADCFilter_Reset(filter);
+    adc_state[instance].filter[rank] = filter;
+    lastError = PLT_OK;
+    return true;
 }
 
-static void ADC_handleConversions_impl(uint8_t instance) {
-    (void)instance;
-    // DMA handles conversions automatically
+static uint32_t ADC_getScanCount_impl(uint8_t instance) {
+    if (instance >= hw_handles.adc_count) return 0;
+    return adc_state[instance].blocks;
 }
 
-static void ADC_setResolution_impl(uint8_t instance, uint8_t bits) {
-    if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) return;
-    
-    uint32_t resolution;
-    switch (bits) {
-        // Different STM32 families use different constant naming
-        #if defined(ADC_RESOLUTION_12B)
-        case 12: resolution = ADC_RESOLUTION_12B; break;
-        case 10: resolution = ADC_RESOLUTION_10B; break;
-        case 8:  resolution = ADC_RESOLUTION_8B; break;
-        case 6:  resolution = ADC_RESOLUTION_6B; break;
-        #elif defined(ADC_RESOLUTION12b)
-        case 12: resolution = ADC_RESOLUTION12b; break;
-        case 10: resolution = ADC_RESOLUTION10b; break;
-        case 8:  resolution = ADC_RESOLUTION8b; break;
-        case 6:  resolution = ADC_RESOLUTION6b; break;
-        #endif
-        default: return;
+/**
+ * @brief Run the attached filters over a filled half-buffer and publish it
+ */
+static void ADC_onScanBlock(ADC_HandleTypeDef* hadc, uint8_t half) {
+    for (uint8_t i = 0; i < hw_handles.adc_count; i++) {
+        if (hw_handles.hadc[i] == hadc && adc_state[i].dma_buffer != NULL) {
+            uint8_t count = adc_state[i].count;
+            const uint16_t* block = &adc_state[i].dma_buffer[half * adc_state[i].buffer_size];
+            for (uint8_t rank = 0; rank < count; rank++) {
+                ADCFilter_t* filter = adc_state[i].filter[rank];
+                if (filter != NULL) {
+                    ADCFilter_Process(filter, &block[rank], ADC_SCAN_BLOCK, count);
+                }
+            }
+            adc_state[i].latest = &block[adc_state[i].buffer_size - count];
+            adc_state[i].blocks++;
+            return;
+        }
     }
-    
-    hw_handles.hadc[instance]->Init.Resolution = resolution;
-    HAL_ADC_Init(hw_handles.hadc[instance]);
 }
 
-static void ADC_setReference_impl(uint8_t instance, float voltage) {
-    if (instance >= hw_handles.adc_count) return;
-    adc_state[instance].vref = voltage;
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc) {
+    ADC_onScanBlock(hadc, 0);
 }
 
-static void ADC_calibrate_impl(uint8_t instance) {
-    if (instance >= hw_handles.adc_count || hw_handles.hadc[instance] == NULL) return;
-    
-#ifdef HAL_ADCEx_Calibration_Start
-    HAL_ADCEx_Calibration_Start(hw_handles.hadc[instance]);
-#endif
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc) {
+    ADC_onScanBlock(hadc, 1);
 }
 
 #else // !HAL_ADC_MODULE_ENABLED
@@ -459,10 +2448,16 @@ static void ADC_calibrate_impl(uint8_t instance) {
 // Stub implementations when ADC not enabled
 static uint16_t ADC_readRaw_impl(uint8_t instance, uint8_t channel) { (void)instance; (void)channel; lastError = PLT_NOT_SUPPORTED; return 0; }
 static float ADC_readVoltage_impl(uint8_t instance, uint8_t channel) { (void)instance; (void)channel; lastError = PLT_NOT_SUPPORTED; return 0.0f; }
+static uint32_t ADC_readVoltageQ16_impl(uint8_t instance, uint8_t channel) { (void)instance; (void)channel; lastError = PLT_NOT_SUPPORTED; return 0; }
+static uint16_t ADC_readVoltageBlock_impl(uint8_t instance, float* volts, uint16_t capacity) { (void)instance; (void)volts; (void)capacity; lastError = PLT_NOT_SUPPORTED; return 0; }
 static void ADC_handleConversions_impl(uint8_t instance) { (void)instance; }
 static void ADC_setResolution_impl(uint8_t instance, uint8_t bits) { (void)instance; (void)bits; lastError = PLT_NOT_SUPPORTED; }
 static void ADC_setReference_impl(uint8_t instance, float voltage) { (void)instance; (void)voltage; }
 static void ADC_calibrate_impl(uint8_t instance) { (void)instance; lastError = PLT_NOT_SUPPORTED; }
+static bool ADC_startScan_impl(uint8_t instance, const ADCScanConfig_t* config) { (void)instance; (void)config; lastError = PLT_NOT_SUPPORTED; return false; }
+static void ADC_stopScan_impl(uint8_t instance) { (void)instance; }
+static bool ADC_attachFilter_impl(uint8_t instance, uint8_t channel, ADCFilter_t* filter) { (void)instance; (void)channel; (void)filter; lastError = PLT_NOT_SUPPORTED; return false; }
+static uint32_t ADC_getScanCount_impl(uint8_t instance) { (void)instance; return 0; }
 
 #endif // HAL_ADC_MODULE_ENABLED
 
@@ -480,25 +2475,53 @@ static void PWM_stop_impl(uint8_t instance, uint32_t channel) {
 }
 
 static void PWM_setFrequency_impl(uint8_t instance, uint32_t hz) {
-    if (instance >= hw_handles.tim_count || hw_handles.htim[instance] == NULL || hz == 0) return;
+    if (instance >= hw_handles.tim_count || hw_handles.htim[instance] == NULL || hz == 0) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    if (hz == tim_state[instance].hz) {
+        lastError = PLT_OK;
+        return;
+    }
     
     TIM_HandleTypeDef* htim = hw_handles.htim[instance];
+    uint32_t timer_clock = PLT_timerClock(htim->Instance);
+    uint32_t ticks = timer_clock / hz;
+    
+    uint32_t max_period = 65536;
+    #ifdef IS_TIM_32B_COUNTER_INSTANCE
+    if (IS_TIM_32B_COUNTER_INSTANCE(htim->Instance)) {
+        max_period = 0;     // 2^32: any tick count fits with prescaler 1
+    }
+    #endif
     
-    // Calculate prescaler and period for desired frequency
-    // This assumes timer clock = SystemCoreClock
-    uint32_t timer_clock = SystemCoreClock;
+    // Smallest prescaler that brings the period into range keeps the finest duty resolution
     uint32_t prescaler = 1;
-    uint32_t period = timer_clock / hz;
+    if (max_period != 0 && ticks > max_period) {
+        prescaler = (ticks + max_period - 1) / max_period;
+    }
+    if (ticks == 0 || prescaler > 65536) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    uint32_t period = (timer_clock / prescaler + hz / 2) / hz;
+    if (period == 0) period = 1;
+    if (max_period != 0 && period > max_period) period = max_period;
     
-    // Adjust if period too large
-    while (period > 65535 && prescaler < 65535) {
-        prescaler++;
-        period = timer_clock / (hz * prescaler);
+    // Keep duty cycles: scale the compare values to the new period
+    uint32_t old_period = htim->Instance->ARR + 1u;
+    __IO uint32_t* ccr = &htim->Instance->CCR1;
+    for (uint8_t ch = 0; ch < 4; ch++) {
+        if (ccr[ch] != 0 && old_period != 0) {
+            ccr[ch] = (uint32_t)(((uint64_t)ccr[ch] * period + old_period / 2) / old_period);
+        }
     }
     
     htim->Instance->PSC = prescaler - 1;
     htim->Instance->ARR = period - 1;
     HAL_TIM_GenerateEvent(htim, TIM_EVENTSOURCE_UPDATE);
+    tim_state[instance].hz = hz;
+    lastError = PLT_OK;
 }
 
 static void PWM_setDutyCycle_impl(uint8_t instance, uint32_t channel, float percent) {
@@ -519,6 +2542,109 @@ static void PWM_setPulseWidth_impl(uint8_t instance, uint32_t channel, uint32_t
     __HAL_TIM_SET_COMPARE(hw_handles.htim[instance], channel, us);
 }
 
+/**
+ * @brief Enable compare preload so CCR writes wait for the next update event
+ */
+static void PWM_enablePreload(TIM_TypeDef* tim, uint8_t mask) {
+    uint32_t ccmr1 = ((mask & PWM_CH1) ? TIM_CCMR1_OC1PE : 0u) | ((mask & PWM_CH2) ? TIM_CCMR1_OC2PE : 0u);
+    uint32_t ccmr2 = ((mask & PWM_CH3) ? TIM_CCMR2_OC3PE : 0u) | ((mask & PWM_CH4) ? TIM_CCMR2_OC4PE : 0u);
+    if ((tim->CCMR1 & ccmr1) != ccmr1) tim->CCMR1 |= ccmr1;
+    if ((tim->CCMR2 & ccmr2) != ccmr2) tim->CCMR2 |= ccmr2;
+}
+
+/**
+ * @brief Write a batch of compare values that take effect in the same period
+ * @note With UDIS set an overflow does not load the shadow registers, so the
+ *       batch is never split across two periods
+ */
+static void PWM_commitCompares(TIM_TypeDef* tim, const uint32_t compare[4], uint8_t mask) {
+    PWM_enablePreload(tim, mask);
+    
+    tim->CR1 |= TIM_CR1_UDIS;
+    __IO uint32_t* ccr = &tim->CCR1;
+    for (uint8_t ch = 0; ch < 4; ch++) {
+        if (mask & (1u << ch)) {
+            ccr[ch] = compare[ch];
+        }
+    }
+    tim->CR1 &= ~TIM_CR1_UDIS;
+}
+
+static void PWM_setCompares_impl(uint8_t instance, const uint32_t compare[4], uint8_t mask) {
+    if (instance >= hw_handles.tim_count || hw_handles.htim[instance] == NULL || compare == NULL) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    PWM_commitCompares(hw_handles.htim[instance]->Instance, compare, mask & 0x0Fu);
+}
+
+static void PWM_setDutyCycles_impl(uint8_t instance, const float percent[4], uint8_t mask) {
+    if (instance >= hw_handles.tim_count || hw_handles.htim[instance] == NULL || percent == NULL) {
+        lastError = PLT_INVALID_PARAM;
+        return;
+    }
+    
+    TIM_TypeDef* tim = hw_handles.htim[instance]->Instance;
+    float ticks_per_percent = (float)(tim->ARR + 1u) * 0.01f;
+    uint32_t compare[4] = {0};
+    for (uint8_t ch = 0; ch < 4; ch++) {
+        if (!(mask & (1u << ch))) continue;
+        float duty = percent[ch];
+        if (duty < 0.0f) duty = 0.0f;
+        if (duty > 100.0f) duty = 100.0f;
+        compare[ch] = (uint32_t)(duty * ticks_per_percent + 0.5f);
+    }
+    PWM_commitCompares(tim, compare, mask & 0x0Fu);
+}
+
+static bool PWM_streamCompares_impl(uint8_t instance, const uint32_t* table, uint16_t rows, uint8_t channels) {
+    if (instance >= hw_handles.tim_count || hw_handles.htim[instance] == NULL) {
+        lastError = PLT_NOT_INITIALIZED;
+        return false;
+    }
+    if (table == NULL) {
+        lastError = PLT_NULL_POINTER;
+        return false;
+    }
+    if (rows == 0 || channels == 0 || channels > 4 || (uint32_t)rows * channels > 0xFFFFu) {
+        lastError = PLT_INVALID_PARAM;
+        return false;
+    }
+    
+#if defined(TIM_DMABASE_CCR1) && defined(TIM_DMA_UPDATE)
+    TIM_HandleTypeDef* htim = hw_handles.htim[instance];
+    if (htim->hdma[TIM_DMA_ID_UPDATE] == NULL) {
+        lastError = PLT_NOT_SUPPORTED;
+        return false;
+    }
+    
+    static const uint32_t burst_length[4] = {
+        TIM_DMABURSTLENGTH_1TRANSFER, TIM_DMABURSTLENGTH_2TRANSFERS,
+        TIM_DMABURSTLENGTH_3TRANSFERS, TIM_DMABURSTLENGTH_4TRANSFERS
+    };
+    
+    // Each row is written right after an update and loaded at the following one
+    PWM_enablePreload(htim->Instance, (uint8_t)((1u << channels) - 1u));
+    if (HAL_TIM_DMABurst_MultiWriteStart(htim, TIM_DMABASE_CCR1, TIM_DMA_UPDATE, (uint32_t*)table,
+                                         burst_length[channels - 1], (uint32_t)rows * channels) != HAL_OK) {
+        lastError = PLT_HAL_ERROR;
+        return false;
+    }
+    lastError = PLT_OK;
+    return true;
+#else
+    lastError = PLT_NOT_SUPPORTED;
+    return false;
+#endif
+}
+
+static void PWM_stopStream_impl(uint8_t instance) {
+    if (instance >= hw_handles.tim_count || hw_handles.htim[instance] == NULL) return;
+#if defined(TIM_DMABASE_CCR1) && defined(TIM_DMA_UPDATE)
+    HAL_TIM_DMABurst_WriteStop(hw_handles.htim[instance], TIM_DMA_UPDATE);
+#endif
+}
+
 #else // !HAL_TIM_MODULE_ENABLED
 
 // Stub implementations when TIM not enabled
@@ -527,6 +2653,10 @@ static void PWM_stop_impl(uint8_t instance, uint32_t channel) { (void)instance;
 static void PWM_setFrequency_impl(uint8_t instance, uint32_t hz) { (void)instance; (void)hz; lastError = PLT_NOT_SUPPORTED; }
 static void PWM_setDutyCycle_impl(uint8_t instance, uint32_t channel, float percent) { (void)instance; (void)channel; (void)percent; lastError = PLT_NOT_SUPPORTED; }
 static void PWM_setPulseWidth_impl(uint8_t instance, uint32_t channel, uint32_t us) { (void)instance; (void)channel; (void)us; lastError = PLT_NOT_SUPPORTED; }
+static void PWM_setDutyCycles_impl(uint8_t instance, const float percent[4], uint8_t mask) { (void)instance; (void)percent; (void)mask; lastError = PLT_NOT_SUPPORTED; }
+static void PWM_setCompares_impl(uint8_t instance, const uint32_t compare[4], uint8_t mask) { (void)instance; (void)compare; (void)mask; lastError = PLT_NOT_SUPPORTED; }
+static bool PWM_streamCompares_impl(uint8_t instance, const uint32_t* table, uint16_t rows, uint8_t channels) { (void)instance; (void)table; (void)rows; (void)channels; lastError = PLT_NOT_SUPPORTED; return false; }
+static void PWM_stopStream_impl(uint8_t instance) { (void)instance; }
 
 #endif // HAL_TIM_MODULE_ENABLED
 
@@ -540,18 +2670,31 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
     
     lastError = PLT_OK;
     
+    #if PLT_ENABLE_STATS
+    Stats_EnableCycleCounter();
+    Stats_Reset(&Stats_timings);
+    #endif
+    
     // Store hardware handles counts and arrays
     #ifdef HAL_CAN_MODULE_ENABLED
     hw_handles.can_count = (handles->can_count > PLT_MAX_CAN_INSTANCES) ? PLT_MAX_CAN_INSTANCES : handles->can_count;
+    memset(can_slot, PLT_NO_INSTANCE, sizeof(can_slot));
     for (uint8_t i = 0; i < hw_handles.can_count; i++) {
         hw_handles.hcan[i] = (CAN_HandleTypeDef*)handles->hcan[i];
+        if (hw_handles.hcan[i] != NULL) {
+            can_slot[PLT_slotOf(hw_handles.hcan[i]->Instance)] = i;
+        }
     }
     #endif
     
     #ifdef HAL_UART_MODULE_ENABLED
     hw_handles.uart_count = (handles->uart_count > PLT_MAX_UART_INSTANCES) ? PLT_MAX_UART_INSTANCES : handles->uart_count;
+    memset(uart_slot, PLT_NO_INSTANCE, sizeof(uart_slot));
     for (uint8_t i = 0; i < hw_handles.uart_count; i++) {
         hw_handles.huart[i] = (UART_HandleTypeDef*)handles->huart[i];
+        if (hw_handles.huart[i] != NULL) {
+            uart_slot[PLT_slotOf(hw_handles.huart[i]->Instance)] = i;
+        }
     }
     #endif
     
@@ -573,6 +2716,7 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
     hw_handles.tim_count = (handles->tim_count > PLT_MAX_TIM_INSTANCES) ? PLT_MAX_TIM_INSTANCES : handles->tim_count;
     for (uint8_t i = 0; i < hw_handles.tim_count; i++) {
         hw_handles.htim[i] = (TIM_HandleTypeDef*)handles->htim[i];
+        tim_state[i].hz = 0;
     }
     #endif
     
@@ -581,14 +2725,17 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
     for (uint8_t i = 0; i < hw_handles.can_count; i++) {
         if (hw_handles.hcan[i] == NULL) continue;
         
-        // Initialize RX queue
-        if (Queue_Init(&can_state[i].rx_queue, sizeof(CANMessage_t), CAN_RX_QUEUE_SIZE) != PLT_OK) {
-            lastError = PLT_NO_MEMORY;
+        // Initialize RX queue (RX ISR is the only producer, handleRxMessages the only consumer)
+        if (Queue_InitStatic(&can_state[i].rx_queue, can_rx_storage[i], sizeof(CANMessage_t),
+                             CAN_RX_QUEUE_SIZE, QUEUE_MODE_SPSC) != PLT_OK ||
+            Queue_InitStatic(&can_state[i].rx_fast, can_rx_fast_storage[i], sizeof(CANMessage_t),
+                             CAN_RX_FAST_QUEUE_SIZE, QUEUE_MODE_SPSC) != PLT_OK) {
+            lastError = PLT_INVALID_PARAM;
             return &Platform;
         }
         
-        // Initialize routing hashtable (shared across instances for now)
-        if (i == 0 && hash_Init() != HASH_OK) {
+        // Each bus gets its own routing table
+        if (CAN_routeInit(i) != HASH_OK) {
             lastError = PLT_HAL_ERROR;
             return &Platform;
         }
@@ -623,11 +2770,18 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
         
         // Start CAN
         HAL_CAN_Start(hw_handles.hcan[i]);
-        HAL_CAN_ActivateNotification(hw_handles.hcan[i], CAN_IT_RX_FIFO0_MSG_PENDING);
+        HAL_CAN_ActivateNotification(hw_handles.hcan[i], CAN_IT_RX_FIFO0_MSG_PENDING |
+                                     CAN_IT_RX_FIFO1_MSG_PENDING | CAN_IT_TX_MAILBOX_EMPTY);
         
+        can_state[i].fast_count = 0;
+        can_state[i].tx_pending = 0;
         can_state[i].tx_count = 0;
         can_state[i].rx_count = 0;
         can_state[i].error_count = 0;
+        #if PLT_ENABLE_STATS
+        can_state[i].tx_high_water = 0;
+        can_state[i].tx_drops = 0;
+        #endif
     }
     #endif
     
@@ -637,14 +2791,29 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
         if (hw_handles.huart[i] == NULL) continue;
         
         // Initialize queues
-        Queue_Init(&uart_state[i].rx_queue, sizeof(uint8_t), UART_RX_QUEUE_SIZE);
-        Queue_Init(&uart_state[i].tx_queue, sizeof(uint8_t), UART_TX_QUEUE_SIZE);
+        Queue_InitStatic(&uart_state[i].rx_queue, uart_rx_storage[i], sizeof(uint8_t),
+                         UART_RX_QUEUE_SIZE, QUEUE_MODE_SPSC);
+        Queue_InitStatic(&uart_state[i].tx_queue, uart_tx_storage[i], sizeof(uint8_t),
+                         UART_TX_QUEUE_SIZE, QUEUE_MODE_LOCKED);
         
         uart_state[i].rx_index = 0;
         uart_state[i].timeout_ms = 1000;
         
-        // Start UART RX in interrupt mode
-        HAL_UART_Receive_IT(hw_handles.huart[i], &uart_state[i].rx_buffer[0], 1);
+        // TX: DMA-drained ring if the handle has a TX DMA channel
+        uart_state[i].tx_dma = (hw_handles.huart[i]->hdmatx != NULL);
+        uart_state[i].tx_busy = false;
+        uart_state[i].tx_policy = UART_TX_BLOCK;
+        uart_state[i].tx_dropped = 0;
+        
+        uart_state[i].rx_written = 0;
+        uart_state[i].rx_read = 0;
+        uart_state[i].rx_overruns = 0;
+        uart_state[i].rx_resync = 0;
+        uart_state[i].rx_skipped = 0;
+        uart_state[i].rx_skipped_seen = 0;
+        
+        // Start UART RX: circular DMA if the handle has one, else interrupt per byte
+        UART_startRx(i);
     }
     #endif
     
@@ -653,8 +2822,19 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
     for (uint8_t i = 0; i < hw_handles.spi_count; i++) {
         if (hw_handles.hspi[i] == NULL) continue;
         
-        Queue_Init(&spi_state[i].rx_queue, sizeof(uint8_t), SPI_RX_QUEUE_SIZE);
+        Queue_InitStatic(&spi_state[i].rx_queue, spi_rx_storage[i], sizeof(SPITransaction_t*),
+                         SPI_RX_QUEUE_SIZE, QUEUE_MODE_SPSC);
+        Queue_InitStatic(&spi_state[i].txn_queue, spi_txn_storage[i], sizeof(SPITransaction_t*),
+                         SPI_TXN_QUEUE_SIZE, QUEUE_MODE_LOCKED);
+        spi_state[i].active = NULL;
         spi_state[i].busy = false;
+        spi_state[i].dma = (hw_handles.hspi[i]->hdmatx != NULL && hw_handles.hspi[i]->hdmarx != NULL);
+        spi_state[i].done_bytes = 0;
+        
+        // Seed the configuration cache from what CubeMX programmed
+        uint32_t cr1 = hw_handles.hspi[i]->Instance->CR1;
+        spi_state[i].clock_hz = PLT_busClock(hw_handles.hspi[i]->Instance) >> (((cr1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos) + 1);
+        spi_state[i].mode = (uint8_t)(((cr1 & SPI_CR1_CPOL) ? 2u : 0u) | ((cr1 & SPI_CR1_CPHA) ? 1u : 0u));
     }
     #endif
     
@@ -666,6 +2846,10 @@ static Platform_t* Platform_begin_impl(PlatformHandles_t* handles) {
         adc_state[i].vref = 3.3f; // Default VREF
         adc_state[i].dma_buffer = NULL;
         adc_state[i].buffer_size = 0;
+        adc_state[i].blocks = 0;
+        adc_state[i].idle_init = hw_handles.hadc[i]->Init;
+        adc_state[i].bits = ADC_resolutionBits(hw_handles.hadc[i]->Init.Resolution);
+        ADC_updateScale(i);
         
         // Calibrate ADC
         ADC_calibrate_impl(i);
@@ -690,11 +2874,13 @@ static Platform_t* Platform_onCAN_impl(void (*callback)(CANMessage_t*)) {
 
 static Platform_t* Platform_onUART_impl(void (*callback)(UARTMessage_t*)) {
     // UART callback not yet implemented
+    (void)callback;
     return &Platform;
 }
 
 static Platform_t* Platform_onSPI_impl(void (*callback)(SPIMessage_t*)) {
     // SPI callback not yet implemented
+    (void)callback;
     return &Platform;
 }
 
@@ -714,57 +2900,200 @@ static bool Platform_isHealthy_impl(void) {
     return platform_initialized && (lastError == PLT_OK);
 }
 
-/* ==================== HAL Callbacks ==================== */
+#if PLT_ENABLE_STATS
+static PlatformQueueStats_t Platform_queueStats(const Queue_t* queue, uint32_t extra_drops) {
+    PlatformQueueStats_t stats;
+    stats.high_water = (uint16_t)queue->high_water;
+    stats.drops = queue->drops + extra_drops;
+    return stats;
+}
 
-/**
- * @brief CAN RX FIFO0 callback - called by HAL when message received
- */
-void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+static bool Platform_getStats_impl(PlatformStats_t* out) {
+    if (out == NULL) {
+        lastError = PLT_NULL_POINTER;
+        return false;
+    }
+    
+    memset(out, 0, sizeof(*out));
+    out->timings = Stats_timings;
+    out->core_hz = SystemCoreClock;
+    
     #ifdef HAL_CAN_MODULE_ENABLED
-    // Find which instance triggered the callback
-    uint8_t instance = 0xFF;
     for (uint8_t i = 0; i < hw_handles.can_count; i++) {
-        if (hcan == hw_handles.hcan[i]) {
-            instance = i;
-            break;
-        }
+        out->can[i].rx = Platform_queueStats(&can_state[i].rx_queue, 0);
+        out->can[i].rx_fast = Platform_queueStats(&can_state[i].rx_fast, 0);
+        out->can[i].tx.high_water = can_state[i].tx_high_water;
+        out->can[i].tx.drops = can_state[i].tx_drops;
+    }
+    #endif
+    #ifdef HAL_UART_MODULE_ENABLED
+    for (uint8_t i = 0; i < hw_handles.uart_count; i++) {
+        out->uart[i].rx = Platform_queueStats(&uart_state[i].rx_queue, uart_state[i].rx_overruns);
+        out->uart[i].tx = Platform_queueStats(&uart_state[i].tx_queue, uart_state[i].tx_dropped);
     }
+    #endif
+    return true;
+}
+
+static void Platform_resetStats_impl(void) {
+    Stats_Reset(&Stats_timings);
     
-    if (instance == 0xFF) return;  // Not our instance
+    #ifdef HAL_CAN_MODULE_ENABLED
+    for (uint8_t i = 0; i < hw_handles.can_count; i++) {
+        can_state[i].rx_queue.high_water = 0;
+        can_state[i].rx_queue.drops = 0;
+        can_state[i].rx_fast.high_water = 0;
+        can_state[i].rx_fast.drops = 0;
+        can_state[i].tx_high_water = 0;
+        can_state[i].tx_drops = 0;
+    }
+    #endif
+    #ifdef HAL_UART_MODULE_ENABLED
+    for (uint8_t i = 0; i < hw_handles.uart_count; i++) {
+        uart_state[i].rx_queue.high_water = 0;
+        uart_state[i].rx_queue.drops = 0;
+        uart_state[i].tx_queue.high_water = 0;
+        uart_state[i].tx_queue.drops = 0;
+    }
+    #endif
+}
+#else
+static bool Platform_getStats_impl(PlatformStats_t* out) {
+    (void)out;
+    lastError = PLT_NOT_SUPPORTED;
+    return false;
+}
+
+static void Platform_resetStats_impl(void) {
+}
+#endif
+
+/* ==================== HAL Callbacks ==================== */
+
+/**
+ * @brief Empty one hardware RX FIFO into its queue
+ * @note Drains every pending frame, so one interrupt covers a burst
+ */
+static void CAN_drainFifo(CAN_HandleTypeDef *hcan, uint32_t fifo) {
+    #ifdef HAL_CAN_MODULE_ENABLED
+    uint8_t instance = PLT_instanceOf(can_slot, (void* const*)hw_handles.hcan, hw_handles.can_count,
+                                      hcan, hcan->Instance);
+    if (instance == PLT_NO_INSTANCE) return;  // Not our instance
     
+    Queue_t* queue = (fifo == CAN_RX_FIFO1) ? &can_state[instance].rx_fast : &can_state[instance].rx_queue;
     CAN_RxHeaderTypeDef rx_header;
-    CANMessage_t msg;
     
-    if (HAL_CAN_GetRxMessage(hcan, CAN_RX_FIFO0, &rx_header, msg.data) == HAL_OK) {
-        msg.id = (uint16_t)rx_header.StdId;
-        msg.length = rx_header.DLC;
-        msg.timestamp = HAL_GetTick();
+    while (HAL_CAN_GetRxFifoFillLevel(hcan, fifo) > 0) {
+        // Let the HAL write the payload straight into the ring slot
+        #if PLT_ENABLE_CAN_TRACE
+        // A replay owns the RX queues: live frames are read and dropped
+        CANMessage_t* msg = can_trace.replaying ? NULL : (CANMessage_t*)Queue_Reserve(queue);
+        #else
+        CANMessage_t* msg = (CANMessage_t*)Queue_Reserve(queue);
+        #endif
+        uint8_t discard[8];
+        uint8_t* data = (msg != NULL) ? msg->data : discard;
+        
+        if (HAL_CAN_GetRxMessage(hcan, fifo, &rx_header, data) != HAL_OK) break;
+        uint32_t stamp = (can_clock.source == CAN_TIMESTAMP_HARDWARE) ? rx_header.Timestamp : CAN_clockNow();
+        #if PLT_ENABLE_CAN_TRACE
+        if (can_trace.capturing) {
+            CAN_captureFrame(instance, &rx_header, data, stamp);
+        }
+        #endif
         
-        // Push to queue (ISR-safe)
-        if (Queue_Push(&can_state[instance].rx_queue, &msg) == PLT_OK) {
+        // Queue full - the FIFO is still drained so the interrupt clears
+        if (msg == NULL) continue;
+        
+        msg->id = (uint16_t)rx_header.StdId;
+        msg->length = rx_header.DLC;
+        msg->timestamp = stamp;
+        
+        // Publish slot (lock-free, ISR is the single producer)
+        if (Queue_Commit(queue) == PLT_OK) {
             can_state[instance].rx_count++;
         }
     }
     #else
     (void)hcan;
+    (void)fifo;
+    #endif
+}
+
+/**
+ * @brief CAN RX FIFO0 callback - called by HAL when message received
+ */
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+    STATS_START(t0);
+    CAN_drainFifo(hcan, CAN_RX_FIFO0);
+    STATS_STOP(STATS_CAN_RX_ISR, t0);
+}
+
+/**
+ * @brief CAN RX FIFO1 callback - prioritized IDs (see P_CAN.prioritize)
+ */
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan) {
+    STATS_START(t0);
+    CAN_drainFifo(hcan, CAN_RX_FIFO1);
+    STATS_STOP(STATS_CAN_RX_ISR, t0);
+}
+
+/**
+ * @brief A TX mailbox went idle: refill it from the priority queue
+ */
+static void CAN_onTxMailboxFree(CAN_HandleTypeDef *hcan) {
+    #ifdef HAL_CAN_MODULE_ENABLED
+    uint8_t instance = PLT_instanceOf(can_slot, (void* const*)hw_handles.hcan, hw_handles.can_count,
+                                      hcan, hcan->Instance);
+    if (instance != PLT_NO_INSTANCE) {
+        CAN_txDrain(instance);
+    }
+    #else
+    (void)hcan;
+    #endif
+}
+
+/**
+ * @brief A transmission finished: record its time, then refill the mailbox
+ */
+static void CAN_onTxComplete(CAN_HandleTypeDef *hcan, uint8_t mailbox) {
+    #ifdef HAL_CAN_MODULE_ENABLED
+    uint32_t now = CAN_clockNow();
+    uint8_t instance = PLT_instanceOf(can_slot, (void* const*)hw_handles.hcan, hw_handles.can_count,
+                                      hcan, hcan->Instance);
+    if (instance == PLT_NO_INSTANCE) return;
+    
+    uint16_t id = can_state[instance].tx_mailbox_id[mailbox];
+    if (can_clock.source == CAN_TIMESTAMP_HARDWARE) {
+        // Start-of-frame time latched by the controller
+        now = HAL_CAN_GetTxTimestamp(hcan, 1u << mailbox);
+    }
+    const uint8_t slot = id & (CAN_TX_STAMP_SLOTS - 1u);
+    can_state[instance].tx_stamp[slot].id = id;
+    can_state[instance].tx_stamp[slot].time = now;
+    can_state[instance].tx_stamp[slot].valid = true;
+    CAN_txDrain(instance);
+    #else
+    (void)hcan;
+    (void)mailbox;
     #endif
 }
 
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan) { CAN_onTxComplete(hcan, 0); }
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan) { CAN_onTxComplete(hcan, 1); }
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan) { CAN_onTxComplete(hcan, 2); }
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan) { CAN_onTxMailboxFree(hcan); }
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan) { CAN_onTxMailboxFree(hcan); }
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan) { CAN_onTxMailboxFree(hcan); }
+
 /**
  * @brief UART RX complete callback - called when byte received
  */
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
     #ifdef HAL_UART_MODULE_ENABLED
-    // Find which instance triggered the callback
-    uint8_t instance = 0xFF;
-    for (uint8_t i = 0; i < hw_handles.uart_count; i++) {
-        if (huart == hw_handles.huart[i]) {
-            instance = i;
-            break;
-        }
-    }
-    
-    if (instance == 0xFF) return;  // Not our instance
+    uint8_t instance = PLT_instanceOf(uart_slot, (void* const*)hw_handles.huart, hw_handles.uart_count,
+                                      huart, huart->Instance);
+    if (instance == PLT_NO_INSTANCE) return;  // Not our instance
     
     // Push byte to queue
     Queue_Push(&uart_state[instance].rx_queue, &uart_state[instance].rx_buffer[uart_state[instance].rx_index]);
@@ -776,21 +3105,144 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart) {
     #endif
 }
 
+/**
+ * @brief UART RX event callback - DMA ring reached IDLE, half or full
+ * @param Size Ring position the DMA has written up to
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
+    #ifdef HAL_UART_MODULE_ENABLED
+    uint8_t instance = PLT_instanceOf(uart_slot, (void* const*)hw_handles.huart, hw_handles.uart_count,
+                                      huart, huart->Instance);
+    if (instance == PLT_NO_INSTANCE || !uart_state[instance].rx_dma) return;
+    
+    // Half/full events bound the gap to half a ring, so the delta is unambiguous
+    uint16_t pos = Size & (UART_RX_DMA_SIZE - 1);
+    uint16_t delta = (uint16_t)((pos - uart_state[instance].rx_dma_pos) & (UART_RX_DMA_SIZE - 1));
+    uart_state[instance].rx_dma_pos = pos;
+    uart_state[instance].rx_written += delta;
+    #else
+    (void)huart;
+    (void)Size;
+    #endif
+}
+
+/**
+ * @brief UART TX complete callback - chain the next DMA transfer from the ring
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+    #ifdef HAL_UART_MODULE_ENABLED
+    uint8_t i = PLT_instanceOf(uart_slot, (void* const*)hw_handles.huart, hw_handles.uart_count,
+                               huart, huart->Instance);
+    if (i == PLT_NO_INSTANCE) return;
+    
+    uart_state[i].tx_busy = false;
+    if (uart_state[i].tx_dma) {
+        UART_txKick(i);
+    }
+    #else
+    (void)huart;
+    #endif
+}
+
+/**
+ * @brief UART error callback - re-arm reception if the error stopped it
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart) {
+    #ifdef HAL_UART_MODULE_ENABLED
+    uint8_t i = PLT_instanceOf(uart_slot, (void* const*)hw_handles.huart, hw_handles.uart_count,
+                               huart, huart->Instance);
+    if (i == PLT_NO_INSTANCE) return;
+    
+    // A failed TX DMA leaves gState READY: unstick the chain
+    if (uart_state[i].tx_busy && huart->gState == HAL_UART_STATE_READY) {
+        uart_state[i].tx_busy = false;
+        UART_txKick(i);
+    }
+    
+    // Noise, framing and parity errors leave reception (and the DMA ring) running
+    if (huart->RxState == HAL_UART_STATE_BUSY_RX &&
+        (huart->ErrorCode & (HAL_UART_ERROR_ORE | HAL_UART_ERROR_DMA)) == 0) {
+        return;
+    }
+    
+    if (uart_state[i].rx_dma) {
+        // Restarted DMA begins again at ring position 0: move rx_written to the
+        // next ring boundary and publish it; the reader skips there (UART_dmaResync)
+        HAL_UART_AbortReceive(huart);
+        uint32_t written = uart_state[i].rx_written;
+        uint32_t boundary = (written + UART_RX_DMA_SIZE - 1) & ~(uint32_t)(UART_RX_DMA_SIZE - 1);
+        uart_state[i].rx_written = boundary;
+        uart_state[i].rx_skipped += boundary - written;
+        uart_state[i].rx_resync = boundary;
+        uart_state[i].rx_dma_pos = 0;
+    }
+    UART_startRx(i);
+    #else
+    (void)huart;
+    #endif
+}
+
+#ifdef HAL_SPI_MODULE_ENABLED
+/**
+ * @brief Retire the transaction that just finished on hspi and start the next one
+ */
+static void SPI_onTransferDone(SPI_HandleTypeDef *hspi, plt_status_t status) {
+    for (uint8_t i = 0; i < hw_handles.spi_count; i++) {
+        if (hw_handles.hspi[i] == hspi) {
+            SPI_finish(i, status);
+            SPI_startNext(i);
+            return;
+        }
+    }
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
+    SPI_onTransferDone(hspi, PLT_OK);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+    SPI_onTransferDone(hspi, PLT_OK);
+}
+
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi) {
+    SPI_onTransferDone(hspi, PLT_OK);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) {
+    SPI_onTransferDone(hspi, PLT_HAL_ERROR);
+}
+#endif
+
 /* ==================== Global Singleton Definitions ==================== */
 
 CAN_t P_CAN = {
     .send = CAN_send_impl,
     .sendMessage = CAN_sendMessage_impl,
     .handleRxMessages = CAN_handleRxMessages_impl,
+    .handleRxMessagesBatch = CAN_handleRxMessagesBatch_impl,
     .availableMessages = CAN_availableMessages_impl,
+    .pendingTxMessages = CAN_pendingTxMessages_impl,
     .route = CAN_route_impl,
     .routeRange = CAN_routeRange_impl,
     .setFilter = CAN_setFilter_impl,
+    .applyRouteFilters = CAN_applyRouteFilters_impl,
+    .prioritize = CAN_prioritize_impl,
+    .setTimestampSource = CAN_setTimestampSource_impl,
+    .toMicros = CAN_toMicros_impl,
+    .elapsedMicros = CAN_elapsedMicros_impl,
+    .getTxTimestamp = CAN_getTxTimestamp_impl,
     .setBaudrate = CAN_setBaudrate_impl,
     .isReady = CAN_isReady_impl,
     .getTxCount = CAN_getTxCount_impl,
     .getRxCount = CAN_getRxCount_impl,
     .getErrorCount = CAN_getErrorCount_impl,
+    .startCapture = CAN_startCapture_impl,
+    .stopCapture = CAN_stopCapture_impl,
+    .handleCapture = CAN_handleCapture_impl,
+    .readCapture = CAN_readCapture_impl,
+    .startReplay = CAN_startReplay_impl,
+    .stopReplay = CAN_stopReplay_impl,
+    .getTraceStatus = CAN_getTraceStatus_impl,
 };
 
 UART_t P_UART = {
@@ -798,6 +3250,8 @@ UART_t P_UART = {
     .println = UART_println_impl,
     .printf = UART_printf_impl,
     .write = UART_write_impl,
+    .writev = UART_writev_impl,
+    .sendRecord = UART_sendRecord_impl,
     .handleRxData = UART_handleRxData_impl,
     .availableBytes = UART_availableBytes_impl,
     .read = UART_read_impl,
@@ -805,11 +3259,15 @@ UART_t P_UART = {
     .setBaudrate = UART_setBaudrate_impl,
     .setTimeout = UART_setTimeout_impl,
     .isReady = UART_isReady_impl,
+    .setTxPolicy = UART_setTxPolicy_impl,
+    .flush = UART_flush_impl,
 };
 
 SPI_t P_SPI = {
     .transfer = SPI_transfer_impl,
     .transferByte = SPI_transferByte_impl,
+    .submit = SPI_submit_impl,
+    .isBusy = SPI_isBusy_impl,
     .handleRxData = SPI_handleRxData_impl,
     .availableBytes = SPI_availableBytes_impl,
     .setClockSpeed = SPI_setClockSpeed_impl,
@@ -821,10 +3279,16 @@ SPI_t P_SPI = {
 ADC_t P_ADC = {
     .readRaw = ADC_readRaw_impl,
     .readVoltage = ADC_readVoltage_impl,
+    .readVoltageQ16 = ADC_readVoltageQ16_impl,
+    .readVoltageBlock = ADC_readVoltageBlock_impl,
     .handleConversions = ADC_handleConversions_impl,
     .setResolution = ADC_setResolution_impl,
     .setReference = ADC_setReference_impl,
     .calibrate = ADC_calibrate_impl,
+    .startScan = ADC_startScan_impl,
+    .stopScan = ADC_stopScan_impl,
+    .attachFilter = ADC_attachFilter_impl,
+    .getScanCount = ADC_getScanCount_impl,
 };
 
 PWM_t P_PWM = {
@@ -832,7 +3296,11 @@ PWM_t P_PWM = {
     .stop = PWM_stop_impl,
     .setFrequency = PWM_setFrequency_impl,
     .setDutyCycle = PWM_setDutyCycle_impl,
-    .setPulseWidth = PWM_setPulseWidth_impl
+    .setPulseWidth = PWM_setPulseWidth_impl,
+    .setDutyCycles = PWM_setDutyCycles_impl,
+    .setCompares = PWM_setCompares_impl,
+    .streamCompares = PWM_streamCompares_impl,
+    .stopStream = PWM_stopStream_impl,
 };
 
 Platform_t Platform = {
@@ -843,5 +3311,7 @@ Platform_t Platform = {
     .version = Platform_version_impl,
     .getLastError = Platform_getLastError_impl,
     .getErrorString = Platform_getErrorString_impl,
-    .isHealthy = Platform_isHealthy_impl
+    .isHealthy = Platform_isHealthy_impl,
+    .getStats = Platform_getStats_impl,
+    .resetStats = Platform_resetStats_impl
 };
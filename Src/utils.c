@@ -1,45 +1,29 @@
 /**
  * @file utils.c
- * @brief Utility functions - Thread-safe queue implementation
+ * @brief Utility functions - Thread-safe queue and streaming formatter
  */
 
 #include "utils.h"
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
 /*================================== Queue implementation ===============================*/
 
 /**
- * @brief Enter critical section (disable interrupts)
- * @note For ARM Cortex-M: disables interrupts and returns PRIMASK state
- *       For testing: no-op stub that returns 0
+ * @brief Memory barrier between slot data and head/tail index updates
+ * @note For ARM Cortex-M: DMB, so an ISR never observes an index before the data
+ *       For testing: full compiler/CPU fence
  */
-static inline uint32_t Queue_EnterCritical(void) {
+static inline void Queue_Barrier(void) {
 #if defined(__ARM_ARCH) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARMCC_VERSION)
-    uint32_t primask = __get_PRIMASK();
-    __disable_irq();
-    return primask;
-#else
-    // Stub for unit testing on x86/x64
-    return 0;
-#endif
-}
-
-/**
- * @brief Exit critical section (restore interrupts)
- * @note For ARM Cortex-M: restores PRIMASK state
- *       For testing: no-op stub
- */
-static inline void Queue_ExitCritical(uint32_t primask) {
-#if defined(__ARM_ARCH) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARMCC_VERSION)
-    __set_PRIMASK(primask);
-#else
-    // Stub for unit testing on x86/x64
-    (void)primask; // Suppress unused parameter warning
+    __DMB();
+#elif defined(__GNUC__)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
 #endif
 }
 
-plt_status_t Queue_Init(Queue_t* queue, size_t item_size, size_t capacity) {
+static plt_status_t Queue_CheckParams(Queue_t* queue, size_t item_size, size_t capacity, QueueMode_t mode) {
     if (queue == NULL) {
         return PLT_NULL_POINTER;
     }
@@ -53,22 +37,123 @@ plt_status_t Queue_Init(Queue_t* queue, size_t item_size, size_t capacity) {
         return PLT_INVALID_PARAM;
     }
     
-    // Allocate contiguous buffer for all items
-    queue->buffer = calloc(capacity, item_size);
-    if (queue->buffer == NULL) {
-        return PLT_NO_MEMORY;
+    // SPSC indices are wrapped with a mask
+    if (mode == QUEUE_MODE_SPSC && (capacity & (capacity - 1)) != 0) {
+        return PLT_INVALID_PARAM;
     }
     
+    return PLT_OK;
+}
+
+static void Queue_Attach(Queue_t* queue, void* buffer, size_t item_size, size_t capacity, QueueMode_t mode, bool owns_buffer) {
+    queue->buffer = buffer;
+    queue->owns_buffer = owns_buffer;
     queue->item_size = item_size;
     queue->capacity = capacity;
+    queue->mask = capacity - 1;
+    queue->mode = mode;
     queue->head = 0;
     queue->tail = 0;
     queue->count = 0;
+    #if PLT_ENABLE_STATS
+    queue->high_water = 0;
+    queue->drops = 0;
+    #endif
+}
+
+static plt_status_t Queue_InitCommon(Queue_t* queue, size_t item_size, size_t capacity, QueueMode_t mode) {
+    plt_status_t status = Queue_CheckParams(queue, item_size, capacity, mode);
+    if (status != PLT_OK) {
+        return status;
+    }
     
+    // Allocate contiguous buffer for all items
+    void* buffer = calloc(capacity, item_size);
+    if (buffer == NULL) {
+        return PLT_NO_MEMORY;
+    }
+    
+    Queue_Attach(queue, buffer, item_size, capacity, mode, true);
     return PLT_OK;
 }
 
-plt_status_t Queue_Push(Queue_t* queue, const void* data) {
+plt_status_t Queue_Init(Queue_t* queue, size_t item_size, size_t capacity) {
+    return Queue_InitCommon(queue, item_size, capacity, QUEUE_MODE_LOCKED);
+}
+
+plt_status_t Queue_InitSPSC(Queue_t* queue, size_t item_size, size_t capacity) {
+    return Queue_InitCommon(queue, item_size, capacity, QUEUE_MODE_SPSC);
+}
+
+plt_status_t Queue_InitStatic(Queue_t* queue, void* buffer, size_t item_size, size_t capacity, QueueMode_t mode) {
+    plt_status_t status = Queue_CheckParams(queue, item_size, capacity, mode);
+    if (status != PLT_OK) {
+        return status;
+    }
+    
+    if (buffer == NULL) {
+        return PLT_NULL_POINTER;
+    }
+    
+    Queue_Attach(queue, buffer, item_size, capacity, mode, false);
+    return PLT_OK;
+}
+
+/*------------------------------- Statistics -------------------------------*/
+
+#if PLT_ENABLE_STATS
+static inline void Queue_NoteFill(Queue_t* queue, size_t count) {
+    if (count > queue->high_water) queue->high_water = count;
+}
+#define QUEUE_NOTE_FILL(queue, n)   Queue_NoteFill((queue), (n))
+#define QUEUE_NOTE_DROP(queue)      ((queue)->drops++)
+#else
+#define QUEUE_NOTE_FILL(queue, n)   do {} while (0)
+#define QUEUE_NOTE_DROP(queue)      do {} while (0)
+#endif
+
+/*------------------------------- SPSC fast paths -------------------------------*/
+
+static plt_status_t Queue_PushSPSC(Queue_t* queue, const void* data) {
+    size_t head = queue->head;
+    
+    // Tail is owned by the consumer - a stale value only under-reports space
+    if (head - queue->tail >= queue->capacity) {
+        QUEUE_NOTE_DROP(queue);
+        return PLT_QUEUE_FULL;
+    }
+    
+    void* dest = (uint8_t*)queue->buffer + ((head & queue->mask) * queue->item_size);
+    memcpy(dest, data, queue->item_size);
+    
+    // Publish the slot only after its contents are written
+    Queue_Barrier();
+    queue->head = head + 1;
+    QUEUE_NOTE_FILL(queue, head + 1 - queue->tail);
+    return PLT_OK;
+}
+
+static plt_status_t Queue_PopSPSC(Queue_t* queue, void* data) {
+    size_t tail = queue->tail;
+    
+    if (queue->head == tail) {
+        return PLT_QUEUE_EMPTY;
+    }
+    
+    // Read slot contents only after observing the producer's head
+    Queue_Barrier();
+    if (data != NULL) {
+        const void* src = (const uint8_t*)queue->buffer + ((tail & queue->mask) * queue->item_size);
+        memcpy(data, src, queue->item_size);
+    }
+    
+    // Hand the slot back only after the copy is complete
+    Queue_Barrier();
+    queue->tail = tail + 1;
+    return PLT_OK;
+}
+
+static plt_status_t Queue_PushAny(Queue_t* queue, const void* data) {
     if (queue == NULL || data == NULL) {
         return PLT_NULL_POINTER;
     }
@@ -77,11 +162,16 @@ plt_status_t Queue_Push(Queue_t* queue, const void* data) {
         return PLT_NOT_INITIALIZED;
     }
     
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        return Queue_PushSPSC(queue, data);
+    }
+    
     // Enter critical section
     uint32_t primask = Queue_EnterCritical();
     
     // Check if full
     if (queue->count >= queue->capacity) {
+        QUEUE_NOTE_DROP(queue);
         Queue_ExitCritical(primask);
         return PLT_QUEUE_FULL;
     }
@@ -93,12 +183,20 @@ plt_status_t Queue_Push(Queue_t* queue, const void* data) {
     // Update head and count
     queue->head = (queue->head + 1) % queue->capacity;
     queue->count++;
+    QUEUE_NOTE_FILL(queue, queue->count);
     
     Queue_ExitCritical(primask);
     return PLT_OK;
 }
 
-plt_status_t Queue_Pop(Queue_t* queue, void* data) {
+plt_status_t Queue_Push(Queue_t* queue, const void* data) {
+    STATS_START(t0);
+    plt_status_t status = Queue_PushAny(queue, data);
+    STATS_STOP(STATS_QUEUE_PUSH, t0);
+    return status;
+}
+
+static plt_status_t Queue_PopAny(Queue_t* queue, void* data) {
     if (queue == NULL) {
         return PLT_NULL_POINTER;
     }
@@ -107,6 +205,10 @@ plt_status_t Queue_Pop(Queue_t* queue, void* data) {
         return PLT_NOT_INITIALIZED;
     }
     
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        return Queue_PopSPSC(queue, data);
+    }
+    
     // Enter critical section
     uint32_t primask = Queue_EnterCritical();
     
@@ -130,6 +232,13 @@ plt_status_t Queue_Pop(Queue_t* queue, void* data) {
     return PLT_OK;
 }
 
+plt_status_t Queue_Pop(Queue_t* queue, void* data) {
+    STATS_START(t0);
+    plt_status_t status = Queue_PopAny(queue, data);
+    STATS_STOP(STATS_QUEUE_POP, t0);
+    return status;
+}
+
 plt_status_t Queue_Peek(Queue_t* queue, void* data) {
     if (queue == NULL || data == NULL) {
         return PLT_NULL_POINTER;
@@ -139,6 +248,18 @@ plt_status_t Queue_Peek(Queue_t* queue, void* data) {
         return PLT_NOT_INITIALIZED;
     }
     
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        // Consumer-side read: no lock needed
+        size_t tail = queue->tail;
+        if (queue->head == tail) {
+            return PLT_QUEUE_EMPTY;
+        }
+        Queue_Barrier();
+        const void* src = (const uint8_t*)queue->buffer + ((tail & queue->mask) * queue->item_size);
+        memcpy(data, src, queue->item_size);
+        return PLT_OK;
+    }
+    
     // Enter critical section (quick read)
     uint32_t primask = Queue_EnterCritical();
     
@@ -156,11 +277,221 @@ plt_status_t Queue_Peek(Queue_t* queue, void* data) {
     return PLT_OK;
 }
 
+/*------------------------------- Batch access -------------------------------*/
+
+/**
+ * @brief Split a run of n items starting at slot into at most two spans
+ */
+static void Queue_MakeSpans(const Queue_t* queue, size_t slot, size_t n, Queue_Span_t spans[2]) {
+    size_t first = queue->capacity - slot;
+    if (first > n) {
+        first = n;
+    }
+    spans[0].data = (uint8_t*)queue->buffer + (slot * queue->item_size);
+    spans[0].count = first;
+    spans[1].data = queue->buffer;
+    spans[1].count = n - first;
+}
+
+size_t Queue_PushBatch(Queue_t* queue, const void* items, size_t n) {
+    if (queue == NULL || items == NULL || queue->buffer == NULL || n == 0) {
+        return 0;
+    }
+    
+    Queue_Span_t spans[2];
+    
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        size_t head = queue->head;
+        size_t space = queue->capacity - (head - queue->tail);
+        if (n > space) {
+            n = space;
+        }
+        Queue_MakeSpans(queue, head & queue->mask, n, spans);
+        memcpy(spans[0].data, items, spans[0].count * queue->item_size);
+        memcpy(spans[1].data, (const uint8_t*)items + (spans[0].count * queue->item_size),
+               spans[1].count * queue->item_size);
+        Queue_Barrier();
+        queue->head = head + n;
+        QUEUE_NOTE_FILL(queue, head + n - queue->tail);
+        return n;
+    }
+    
+    uint32_t primask = Queue_EnterCritical();
+    
+    size_t space = queue->capacity - queue->count;
+    if (n > space) {
+        n = space;
+    }
+    Queue_MakeSpans(queue, queue->head, n, spans);
+    memcpy(spans[0].data, items, spans[0].count * queue->item_size);
+    memcpy(spans[1].data, (const uint8_t*)items + (spans[0].count * queue->item_size),
+           spans[1].count * queue->item_size);
+    queue->head = (queue->head + n) % queue->capacity;
+    queue->count += n;
+    QUEUE_NOTE_FILL(queue, queue->count);
+    
+    Queue_ExitCritical(primask);
+    return n;
+}
+
+size_t Queue_PopBatch(Queue_t* queue, void* items, size_t max) {
+    if (queue == NULL || items == NULL || max == 0) {
+        return 0;
+    }
+    
+    Queue_Span_t spans[2];
+    size_t n = Queue_PeekBatch(queue, spans, max);
+    if (n == 0) {
+        return 0;
+    }
+    
+    memcpy(items, spans[0].data, spans[0].count * queue->item_size);
+    memcpy((uint8_t*)items + (spans[0].count * queue->item_size), spans[1].data,
+           spans[1].count * queue->item_size);
+    
+    Queue_Release(queue, n);
+    return n;
+}
+
+size_t Queue_PeekBatch(Queue_t* queue, Queue_Span_t spans[2], size_t max) {
+    if (queue == NULL || spans == NULL || queue->buffer == NULL) {
+        return 0;
+    }
+    
+    size_t n;
+    size_t slot;
+    
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        size_t tail = queue->tail;
+        n = queue->head - tail;
+        Queue_Barrier();
+        slot = tail & queue->mask;
+    } else {
+        uint32_t primask = Queue_EnterCritical();
+        n = queue->count;
+        slot = queue->tail;
+        Queue_ExitCritical(primask);
+    }
+    
+    if (max != 0 && n > max) {
+        n = max;
+    }
+    
+    Queue_MakeSpans(queue, slot, n, spans);
+    return n;
+}
+
+plt_status_t Queue_Release(Queue_t* queue, size_t n) {
+    if (queue == NULL) {
+        return PLT_NULL_POINTER;
+    }
+    
+    if (queue->buffer == NULL) {
+        return PLT_NOT_INITIALIZED;
+    }
+    
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        size_t tail = queue->tail;
+        if (n > queue->head - tail) {
+            return PLT_UNDERFLOW;
+        }
+        // All reads of the released slots must complete first
+        Queue_Barrier();
+        queue->tail = tail + n;
+        return PLT_OK;
+    }
+    
+    uint32_t primask = Queue_EnterCritical();
+    
+    if (n > queue->count) {
+        Queue_ExitCritical(primask);
+        return PLT_UNDERFLOW;
+    }
+    queue->tail = (queue->tail + n) % queue->capacity;
+    queue->count -= n;
+    
+    Queue_ExitCritical(primask);
+    return PLT_OK;
+}
+
+/*------------------------------- Zero-copy slots -------------------------------*/
+
+void* Queue_Reserve(Queue_t* queue) {
+    if (queue == NULL || queue->buffer == NULL) {
+        return NULL;
+    }
+    
+    // Only the producer moves head, so the slot stays ours until commit
+    if (Queue_Count(queue) >= queue->capacity) {
+        QUEUE_NOTE_DROP(queue);
+        return NULL;
+    }
+    
+    size_t slot = (queue->mode == QUEUE_MODE_SPSC) ? (queue->head & queue->mask) : queue->head;
+    return (uint8_t*)queue->buffer + (slot * queue->item_size);
+}
+
+plt_status_t Queue_Commit(Queue_t* queue) {
+    if (queue == NULL) {
+        return PLT_NULL_POINTER;
+    }
+    
+    if (queue->buffer == NULL) {
+        return PLT_NOT_INITIALIZED;
+    }
+    
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        size_t head = queue->head;
+        if (head - queue->tail >= queue->capacity) {
+            return PLT_QUEUE_FULL;
+        }
+        // Slot contents must land before the consumer can see them
+        Queue_Barrier();
+        queue->head = head + 1;
+        QUEUE_NOTE_FILL(queue, head + 1 - queue->tail);
+        return PLT_OK;
+    }
+    
+    uint32_t primask = Queue_EnterCritical();
+    
+    if (queue->count >= queue->capacity) {
+        Queue_ExitCritical(primask);
+        return PLT_QUEUE_FULL;
+    }
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count++;
+    QUEUE_NOTE_FILL(queue, queue->count);
+    
+    Queue_ExitCritical(primask);
+    return PLT_OK;
+}
+
+void* Queue_PeekSlot(Queue_t* queue) {
+    if (queue == NULL || queue->buffer == NULL) {
+        return NULL;
+    }
+    
+    if (Queue_Count(queue) == 0) {
+        return NULL;
+    }
+    
+    // Observe the producer's index before touching the slot
+    Queue_Barrier();
+    size_t slot = (queue->mode == QUEUE_MODE_SPSC) ? (queue->tail & queue->mask) : queue->tail;
+    return (uint8_t*)queue->buffer + (slot * queue->item_size);
+}
+
 size_t Queue_Count(Queue_t* queue) {
     if (queue == NULL) {
         return 0;
     }
     
+    if (queue->mode == QUEUE_MODE_SPSC) {
+        // Free-running indices: difference is the fill level, even across wrap
+        size_t tail = queue->tail;
+        return queue->head - tail;
+    }
+    
     // Atomic read of volatile variable
     return queue->count;
 }
@@ -173,7 +504,7 @@ bool Queue_IsFull(Queue_t* queue) {
     if (queue == NULL) {
         return false;
     }
-    return queue->count >= queue->capacity;
+    return Queue_Count(queue) >= queue->capacity;
 }
 
 void Queue_Free(Queue_t* queue) {
@@ -182,8 +513,11 @@ void Queue_Free(Queue_t* queue) {
     }
     
     if (queue->buffer != NULL) {
-        free(queue->buffer);
+        if (queue->owns_buffer) {
+            free(queue->buffer);
+        }
         queue->buffer = NULL;
+        queue->owns_buffer = false;
     }
     
     queue->head = 0;
@@ -191,3 +525,420 @@ void Queue_Free(Queue_t* queue) {
     queue->count = 0;
     queue->capacity = 0;
 }
+
+/*================================== Formatter implementation ===============================*/
+
+#define FMT_LEFT    0x01    // '-'
+#define FMT_PLUS    0x02    // '+'
+#define FMT_SPACE   0x04    // ' '
+#define FMT_ZERO    0x08    // '0'
+#define FMT_ALT     0x10    // '#'
+
+#define FMT_MAX_FRACTION 9
+
+typedef struct {
+    plt_format_sink_t sink;
+    void* context;
+    int count;
+} fmt_out_t;
+
+static void Fmt_Emit(fmt_out_t* out, const char* data, size_t length) {
+    if (length == 0) return;
+    out->sink(out->context, data, length);
+    out->count += (int)length;
+}
+
+static void Fmt_Fill(fmt_out_t* out, char c, int n) {
+    static const char spaces[16] = "                ";
+    static const char zeros[16] = "0000000000000000";
+    const char* run = (c == '0') ? zeros : spaces;
+    while (n > 0) {
+        int chunk = (n > 16) ? 16 : n;
+        Fmt_Emit(out, run, (size_t)chunk);
+        n -= chunk;
+    }
+}
+
+/**
+ * @brief Emit [pad][prefix][zeros][body][pad] for one conversion
+ */
+static void Fmt_Field(fmt_out_t* out, const char* prefix, int prefix_len, int zeros,
+                      const char* body, int body_len, int width, uint8_t flags) {
+    int pad = width - (prefix_len + zeros + body_len);
+    if (pad < 0) pad = 0;
+
+    if (!(flags & FMT_LEFT) && !(flags & FMT_ZERO)) Fmt_Fill(out, ' ', pad);
+    Fmt_Emit(out, prefix, (size_t)prefix_len);
+    if (!(flags & FMT_LEFT) && (flags & FMT_ZERO)) Fmt_Fill(out, '0', pad);
+    Fmt_Fill(out, '0', zeros);
+    Fmt_Emit(out, body, (size_t)body_len);
+    if (flags & FMT_LEFT) Fmt_Fill(out, ' ', pad);
+}
+
+/**
+ * @brief Write value right-aligned into the end of buf, return digit count
+ */
+static int Fmt_Digits(char* end, unsigned long long value, unsigned base, bool upper) {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    int n = 0;
+    do {
+        *--end = digits[value % base];
+        value /= base;
+        n++;
+    } while (value != 0);
+    return n;
+}
+
+static const uint32_t fmt_pow10[FMT_MAX_FRACTION + 1] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u
+};
+
+/**
+ * @brief Strip the sign off value, return the prefix length ('-', '+', ' ' or none)
+ */
+static int Fmt_Sign(double* value, uint8_t flags, const char** prefix) {
+    *prefix = "";
+    if (signbit(*value)) {
+        *prefix = "-";
+        *value = -*value;
+        return 1;
+    }
+    if (flags & (FMT_PLUS | FMT_SPACE)) {
+        *prefix = (flags & FMT_PLUS) ? "+" : " ";
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Write value (0 <= value < 2^64) as "whole[.fraction]" right-aligned into
+ *        the end of buf, return its length
+ */
+static int Fmt_Fixed(char* end, double value, int precision, bool point) {
+    unsigned long long whole = (unsigned long long)value;
+    double scaled = (value - (double)whole) * fmt_pow10[precision] + 0.5;
+    uint32_t fraction = (uint32_t)scaled;
+    if (fraction >= fmt_pow10[precision]) {
+        fraction -= fmt_pow10[precision];
+        whole++;
+    }
+
+    int n = 0;
+    if (precision > 0) {
+        int f = Fmt_Digits(end, fraction, 10, false);
+        for (; f < precision; f++) {
+            *(end - f - 1) = '0';
+        }
+        n = precision;
+        *(end - n - 1) = '.';
+        n++;
+    } else if (point) {
+        *(end - 1) = '.';
+        n = 1;
+    }
+    return n + Fmt_Digits(end - n, whole, 10, false);
+}
+
+/**
+ * @brief Scale value (finite, >= 0) into [1, 10) as it rounds to precision
+ *        fraction digits, return the decimal exponent
+ */
+static int Fmt_Normalize(double* value, int precision) {
+    static const double scale[] = {1e256, 1e128, 1e64, 1e32, 1e16, 1e8, 1e4, 1e2, 1e1};
+    static const int digits[] = {256, 128, 64, 32, 16, 8, 4, 2, 1};
+    double v = *value;
+    int exponent = 0;
+
+    if (v != 0.0) {
+        for (size_t i = 0; i < sizeof(scale) / sizeof(scale[0]); i++) {
+            if (v >= scale[i]) {
+                v /= scale[i];
+                exponent += digits[i];
+            } else if (v < 1.0 && v * scale[i] < 10.0) {
+                v *= scale[i];
+                exponent -= digits[i];
+            }
+        }
+    }
+    // Rounding may carry into the next decade (9.9999995 -> 10.000000)
+    if (v * fmt_pow10[precision] + 0.5 >= 10.0 * fmt_pow10[precision]) {
+        v /= 10.0;
+        exponent++;
+    }
+    *value = v;
+    return exponent;
+}
+
+/**
+ * @brief Drop trailing fraction zeros and a bare '.' (%g without '#')
+ */
+static int Fmt_TrimFraction(const char* body, int n) {
+    if (memchr(body, '.', (size_t)n) == NULL) return n;
+    while (body[n - 1] == '0') n--;
+    if (body[n - 1] == '.') n--;
+    return n;
+}
+
+static void Fmt_Float(fmt_out_t* out, double value, int precision, int width, uint8_t flags) {
+    char buf[32];
+    const char* prefix;
+    int prefix_len = Fmt_Sign(&value, flags, &prefix);
+
+    if (value != value) {
+        Fmt_Field(out, prefix, prefix_len, 0, "nan", 3, width, (uint8_t)(flags & ~FMT_ZERO));
+        return;
+    }
+    if (value >= 18446744073709551616.0) {
+        // Beyond uint64 (or inf): no digits to show without an exponent form
+        Fmt_Field(out, prefix, prefix_len, 0, "inf", 3, width, (uint8_t)(flags & ~FMT_ZERO));
+        return;
+    }
+
+    if (precision < 0) precision = 6;
+    if (precision > FMT_MAX_FRACTION) precision = FMT_MAX_FRACTION;
+
+    int n = Fmt_Fixed(buf + sizeof(buf), value, precision, (flags & FMT_ALT) != 0);
+    Fmt_Field(out, prefix, prefix_len, 0, buf + sizeof(buf) - n, n, width, flags);
+}
+
+/**
+ * @brief %e/%E, and %g/%G (fixed or exponent form, whichever printf would pick)
+ */
+static void Fmt_Exp(fmt_out_t* out, double value, int precision, int width, uint8_t flags, char conv) {
+    char buf[32];
+    char* mantissa_end = buf + 16;      // d.ddddddddd, then e-ddd after it
+    bool upper = (conv == 'E' || conv == 'G');
+    bool general = (conv == 'g' || conv == 'G');
+    const char* prefix;
+    int prefix_len = Fmt_Sign(&value, flags, &prefix);
+
+    if (value != value || isinf(value)) {
+        const char* text = (value != value) ? (upper ? "NAN" : "nan") : (upper ? "INF" : "inf");
+        Fmt_Field(out, prefix, prefix_len, 0, text, 3, width, (uint8_t)(flags & ~FMT_ZERO));
+        return;
+    }
+
+    if (precision < 0) precision = 6;
+    if (general && precision == 0) precision = 1;
+    int fraction = general ? precision - 1 : precision;
+    if (fraction > FMT_MAX_FRACTION) fraction = FMT_MAX_FRACTION;
+
+    double mantissa = value;
+    int exponent = Fmt_Normalize(&mantissa, fraction);
+
+    if (general && exponent >= -4 && exponent < precision && exponent < 19) {
+        fraction = precision - 1 - exponent;
+        if (fraction > FMT_MAX_FRACTION) fraction = FMT_MAX_FRACTION;
+        int n = Fmt_Fixed(buf + sizeof(buf), value, fraction, (flags & FMT_ALT) != 0);
+        const char* body = buf + sizeof(buf) - n;
+        if (!(flags & FMT_ALT)) n = Fmt_TrimFraction(body, n);
+        Fmt_Field(out, prefix, prefix_len, 0, body, n, width, flags);
+        return;
+    }
+
+    int n = Fmt_Fixed(mantissa_end, mantissa, fraction, (flags & FMT_ALT) != 0);
+    char* body = mantissa_end - n;
+    if (general && !(flags & FMT_ALT)) n = Fmt_TrimFraction(body, n);
+
+    char* p = body + n;
+    *p++ = upper ? 'E' : 'e';
+    *p++ = (exponent < 0) ? '-' : '+';
+    char digits[4];
+    int d = Fmt_Digits(digits + sizeof(digits), (unsigned long long)(exponent < 0 ? -exponent : exponent), 10, false);
+    if (d < 2) *p++ = '0';
+    memcpy(p, digits + sizeof(digits) - d, (size_t)d);
+    p += d;
+
+    Fmt_Field(out, prefix, prefix_len, 0, body, (int)(p - body), width, flags);
+}
+
+int plt_vformat(plt_format_sink_t sink, void* context, const char* fmt, va_list args) {
+    if (sink == NULL || fmt == NULL) {
+        return -1;
+    }
+
+    fmt_out_t out = {sink, context, 0};
+    va_list ap;
+    va_copy(ap, args);
+
+    while (*fmt != '\0') {
+        // Literal text goes out as one run
+        const char* run = fmt;
+        while (*fmt != '\0' && *fmt != '%') fmt++;
+        Fmt_Emit(&out, run, (size_t)(fmt - run));
+        if (*fmt == '\0') break;
+        const char* spec = fmt++;
+
+        uint8_t flags = 0;
+        for (;; fmt++) {
+            if (*fmt == '-') flags |= FMT_LEFT;
+            else if (*fmt == '+') flags |= FMT_PLUS;
+            else if (*fmt == ' ') flags |= FMT_SPACE;
+            else if (*fmt == '0') flags |= FMT_ZERO;
+            else if (*fmt == '#') flags |= FMT_ALT;
+            else break;
+        }
+
+        int width = 0;
+        if (*fmt == '*') {
+            width = va_arg(ap, int);
+            if (width < 0) {
+                flags |= FMT_LEFT;
+                width = -width;
+            }
+            fmt++;
+        } else {
+            while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        }
+
+        int precision = -1;
+        if (*fmt == '.') {
+            fmt++;
+            precision = 0;
+            if (*fmt == '*') {
+                precision = va_arg(ap, int);
+                fmt++;
+            } else {
+                while (*fmt >= '0' && *fmt <= '9') precision = precision * 10 + (*fmt++ - '0');
+            }
+        }
+
+        // 'H' = hh, 'L' = ll
+        char length = 0;
+        if (*fmt == 'h' || *fmt == 'l' || *fmt == 'z' || *fmt == 'j' || *fmt == 't') {
+            length = *fmt++;
+            if ((length == 'h' || length == 'l') && *fmt == length) {
+                length = (length == 'h') ? 'H' : 'L';
+                fmt++;
+            }
+        }
+
+        char conv = *fmt;
+        if (conv == '\0') break;
+        fmt++;
+
+        char buf[24];   // 64-bit octal fits in 22 digits
+        char* end = buf + sizeof(buf);
+
+        switch (conv) {
+            case 'd':
+            case 'i': {
+                long long value;
+                if (length == 'L') value = va_arg(ap, long long);
+                else if (length == 'l') value = va_arg(ap, long);
+                else if (length == 'z') value = (long long)va_arg(ap, size_t);
+                else if (length == 'j') value = (long long)va_arg(ap, intmax_t);
+                else if (length == 't') value = (long long)va_arg(ap, ptrdiff_t);
+                else value = va_arg(ap, int);
+                if (length == 'h') value = (short)value;
+                else if (length == 'H') value = (signed char)value;
+
+                const char* prefix = "";
+                unsigned long long magnitude = (unsigned long long)value;
+                if (value < 0) {
+                    prefix = "-";
+                    magnitude = 0ULL - magnitude;
+                } else if (flags & FMT_PLUS) {
+                    prefix = "+";
+                } else if (flags & FMT_SPACE) {
+                    prefix = " ";
+                }
+
+                int n = (precision == 0 && magnitude == 0) ? 0 : Fmt_Digits(end, magnitude, 10, false);
+                int zeros = (precision > n) ? precision - n : 0;
+                if (precision >= 0) flags &= (uint8_t)~FMT_ZERO;
+                Fmt_Field(&out, prefix, (int)strlen(prefix), zeros, end - n, n, width, flags);
+                break;
+            }
+
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+            case 'p': {
+                unsigned long long value;
+                if (conv == 'p') value = (unsigned long long)(uintptr_t)va_arg(ap, void*);
+                else if (length == 'L') value = va_arg(ap, unsigned long long);
+                else if (length == 'l') value = va_arg(ap, unsigned long);
+                else if (length == 'z') value = va_arg(ap, size_t);
+                else if (length == 'j') value = (unsigned long long)va_arg(ap, uintmax_t);
+                else if (length == 't') value = (unsigned long long)va_arg(ap, ptrdiff_t);
+                else value = va_arg(ap, unsigned int);
+                if (length == 'h') value = (unsigned short)value;
+                else if (length == 'H') value = (unsigned char)value;
+
+                unsigned base = (conv == 'u') ? 10 : (conv == 'o') ? 8 : 16;
+                const char* prefix = "";
+                if (conv == 'p') {
+                    prefix = "0x";
+                } else if ((flags & FMT_ALT) && value != 0 && base == 16) {
+                    prefix = (conv == 'X') ? "0X" : "0x";
+                }
+
+                int n = (precision == 0 && value == 0) ? 0 : Fmt_Digits(end, value, base, conv == 'X');
+                int zeros = (precision > n) ? precision - n : 0;
+                if ((flags & FMT_ALT) && conv == 'o' && zeros == 0 && (n == 0 || *(end - n) != '0')) {
+                    zeros = 1;
+                }
+                if (precision >= 0) flags &= (uint8_t)~FMT_ZERO;
+                Fmt_Field(&out, prefix, (int)strlen(prefix), zeros, end - n, n, width, flags);
+                break;
+            }
+
+            case 'f':
+            case 'F':
+                Fmt_Float(&out, va_arg(ap, double), precision, width, flags);
+                break;
+
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+                Fmt_Exp(&out, va_arg(ap, double), precision, width, flags, conv);
+                break;
+
+            case 'a':
+            case 'A':
+                // No hex-float output: shown in decimal exponent form
+                Fmt_Exp(&out, va_arg(ap, double), precision, width, flags, (conv == 'a') ? 'e' : 'E');
+                break;
+
+            case 'c': {
+                char c = (char)va_arg(ap, int);
+                Fmt_Field(&out, "", 0, 0, &c, 1, width, (uint8_t)(flags & ~FMT_ZERO));
+                break;
+            }
+
+            case 's': {
+                const char* str = va_arg(ap, const char*);
+                if (str == NULL) str = "(null)";
+                int n = 0;
+                while (str[n] != '\0' && (precision < 0 || n < precision)) n++;
+                Fmt_Field(&out, "", 0, 0, str, n, width, (uint8_t)(flags & ~FMT_ZERO));
+                break;
+            }
+
+            case '%':
+                Fmt_Emit(&out, "%", 1);
+                break;
+
+            default:
+                // Unknown conversion (%n, %Lf, ...): its argument type is unknown, so
+                // print it as written and stop rather than misread every later one
+                Fmt_Emit(&out, spec, (size_t)(fmt - spec));
+                va_end(ap);
+                return out.count;
+        }
+    }
+
+    va_end(ap);
+    return out.count;
+}
+
+int plt_format(plt_format_sink_t sink, void* context, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int count = plt_vformat(sink, context, fmt, args);
+    va_end(args);
+    return count;
+}
@@ -6,12 +6,13 @@
  * - Receives pedal position via CAN
  * - Reads throttle position from ADC
  * - Sends motor commands via CAN
- * - Logs data via UART
+ * - Logs data via UART (binary telemetry records, text status on request)
  * - Controls cooling fan PWM
  */
 
 #include "main.h"
 #include "stm32_platform.h"
+#include "telemetry.h"
 
 /* ==================== Hardware Handles (from CubeMX) ==================== */
 CAN_HandleTypeDef hcan1;
@@ -30,6 +31,8 @@ typedef struct {
 
 VehicleState_t vehicle = {0};
 
+#define TELEMETRY_TYPE_VEHICLE_STATE  TELEMETRY_TYPE_USER  // Decoded by scripts/telemetry_decode.py
+
 /* ==================== CAN Message Handlers ==================== */
 
 // Called automatically when CAN message 0x180 arrives
@@ -133,6 +136,11 @@ void printSystemStatus(void) {
     P_UART.println(0, "===================================\n");
 }
 
+// Binary status: 22 bytes on the wire instead of ~250 of formatted text, no float printf
+void sendStatusRecord(void) {
+    P_UART.sendRecord(0, TELEMETRY_TYPE_VEHICLE_STATE, &vehicle, sizeof(vehicle));
+}
+
 /* ==================== Main Function ==================== */
 
 int main(void) {
@@ -221,10 +229,10 @@ int main(void) {
             }
         }
         
-        // Print status every 1 second
-        if (HAL_GetTick() - lastStatusTime >= 1000) {
+        // Stream status every 100ms (text dump on the 's' command)
+        if (HAL_GetTick() - lastStatusTime >= 100) {
             lastStatusTime = HAL_GetTick();
-            printSystemStatus();
+            sendStatusRecord();
         }
         
         // Health check every 100ms
@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+STM32 Platform Benchmark Comparison
+
+Compares two JSON reports written by tests/bench_platform and flags every
+benchmark whose ns per op grew by more than the threshold. Run both reports
+on the same machine; host timings are only comparable to themselves.
+
+Usage:
+    python bench_compare.py baseline.json bench.json
+    python bench_compare.py baseline.json bench.json --threshold 15   (percent, default 10)
+"""
+
+import argparse
+import json
+import sys
+from typing import Dict
+
+
+def load(path: str) -> Dict[str, float]:
+    """ns_per_op by benchmark name"""
+    with open(path, encoding="utf-8") as f:
+        report = json.load(f)
+    return {entry["name"]: float(entry["ns_per_op"]) for entry in report["benchmarks"]}
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compare two bench_platform reports")
+    parser.add_argument("baseline", help="report from the reference build")
+    parser.add_argument("current", help="report from the build under test")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="slowdown in percent that counts as a regression (default: 10)")
+    args = parser.parse_args()
+
+    try:
+        baseline = load(args.baseline)
+        current = load(args.current)
+    except (OSError, ValueError, KeyError) as err:
+        print("error: %s" % err, file=sys.stderr)
+        return 2
+
+    regressions = 0
+    print("%-32s %12s %12s %8s" % ("benchmark", "base ns/op", "ns/op", "change"))
+    for name in sorted(set(baseline) | set(current)):
+        if name not in current:
+            print("%-32s %12.2f %12s %8s" % (name, baseline[name], "-", "removed"))
+            continue
+        if name not in baseline:
+            print("%-32s %12s %12.2f %8s" % (name, "-", current[name], "new"))
+            continue
+        base, now = baseline[name], current[name]
+        change = (now - base) / base * 100.0 if base > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        print("%-32s %12.2f %12.2f %+7.1f%%%s" % (name, base, now, change, flag))
+
+    if regressions:
+        print("%d benchmark(s) slower than %.0f%%" % (regressions, args.threshold), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+STM32 Platform CAN Trace Tool
+
+Converts between the binary trace format of P_CAN.startCapture() /
+P_CAN.startReplay() (see Inc/can_trace.h) and candump log files:
+
+    header:  'CTRC' | version | 3 reserved
+    entry:   dlc | instance << 4 | id (u16 le) | delta_us (LEB128) | data[dlc]
+
+Usage:
+    python can_trace.py dump trace.ctr                       (candump -l style lines)
+    python can_trace.py from-candump race.log trace.ctr      (canN -> instance N)
+    python can_trace.py from-telemetry capture.bin trace.ctr (UART capture of sendRecord frames)
+"""
+
+import argparse
+import re
+import sys
+from typing import Iterator, List, Tuple
+
+from telemetry_decode import cobs_decode, crc16_ccitt_false, split_frames
+
+MAGIC = b"CTRC"
+VERSION = 1
+HEADER = MAGIC + bytes([VERSION, 0, 0, 0])
+TELEMETRY_TYPE_CAN_TRACE = 0x02
+
+# (delta_us, instance, id, data)
+Entry = Tuple[int, int, int, bytes]
+
+CANDUMP_LINE = re.compile(r"\((\d+\.\d+)\)\s+\S*?(\d+)\s+([0-9A-Fa-f]{1,3})#([0-9A-Fa-f]*)")
+
+
+def encode_entry(delta_us: int, instance: int, can_id: int, data: bytes) -> bytes:
+    if can_id > 0x7FF or len(data) > 8 or instance > 3:
+        raise ValueError("id 0x%X / %d bytes / instance %d cannot be traced" % (can_id, len(data), instance))
+    out = bytearray([len(data) | (instance << 4), can_id & 0xFF, can_id >> 8])
+    delta_us = min(max(delta_us, 0), 0xFFFFFFFF)
+    while delta_us >= 0x80:
+        out.append((delta_us & 0x7F) | 0x80)
+        delta_us >>= 7
+    out.append(delta_us)
+    return bytes(out) + data
+
+
+def decode_entries(trace: bytes) -> Iterator[Entry]:
+    if len(trace) < len(HEADER) or trace[:4] != MAGIC:
+        raise ValueError("not a CAN trace (bad magic)")
+    if trace[4] > VERSION:
+        raise ValueError("trace version %d is newer than this tool" % trace[4])
+
+    pos = len(HEADER)
+    while pos < len(trace):
+        if pos + 4 > len(trace):
+            raise ValueError("truncated entry at offset %d" % pos)
+        flags, can_id = trace[pos], trace[pos + 1] | (trace[pos + 2] << 8)
+        dlc, instance = flags & 0x0F, (flags >> 4) & 0x03
+        if flags & 0xC0 or dlc > 8 or can_id > 0x7FF:
+            raise ValueError("malformed entry at offset %d" % pos)
+        pos += 3
+        delta, shift = 0, 0
+        while True:
+            if pos >= len(trace) or shift > 28:
+                raise ValueError("bad delta at offset %d" % pos)
+            byte = trace[pos]
+            pos += 1
+            delta |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                break
+        if pos + dlc > len(trace):
+            raise ValueError("truncated entry at offset %d" % pos)
+        yield delta, instance, can_id, trace[pos:pos + dlc]
+        pos += dlc
+
+
+def dump(trace: bytes, out=sys.stdout) -> int:
+    time_us = 0
+    count = 0
+    for delta, instance, can_id, data in decode_entries(trace):
+        time_us += delta
+        print("(%d.%06d) can%d %03X#%s" % (time_us // 1000000, time_us % 1000000, instance,
+                                          can_id, data.hex().upper()), file=out)
+        count += 1
+    return count
+
+
+def from_candump(lines: List[str]) -> bytes:
+    out = bytearray(HEADER)
+    last_us = None
+    for line in lines:
+        match = CANDUMP_LINE.search(line)
+        if match is None:
+            continue
+        stamp, instance, can_id, data = match.groups()
+        seconds, fraction = stamp.split(".")
+        time_us = int(seconds) * 1000000 + int((fraction + "000000")[:6])
+        delta = 0 if last_us is None else time_us - last_us
+        last_us = time_us
+        out += encode_entry(delta, int(instance), int(can_id, 16), bytes.fromhex(data))
+    return bytes(out)
+
+
+def from_telemetry(stream) -> Tuple[bytes, int]:
+    """Concatenate CAN_TRACE record payloads; records hold whole entries"""
+    out = bytearray()
+    gaps = 0
+    last_seq = None
+    for frame in split_frames(stream):
+        try:
+            raw = cobs_decode(frame)
+        except ValueError:
+            continue
+        if len(raw) < 4 or crc16_ccitt_false(raw[:-2]) != (raw[-2] | (raw[-1] << 8)):
+            continue
+        if raw[0] != TELEMETRY_TYPE_CAN_TRACE:
+            continue
+        seq = raw[1]
+        if last_seq is not None and seq != (last_seq + 1) & 0xFF:
+            gaps += 1
+        last_seq = seq
+        out += raw[2:-2]
+    return bytes(out), gaps
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Convert STM32 Platform CAN traces")
+    sub = parser.add_subparsers(dest="command", required=True)
+    p = sub.add_parser("dump", help="print a trace as candump -l lines")
+    p.add_argument("trace")
+    p = sub.add_parser("from-candump", help="build a replay trace from a candump -l log")
+    p.add_argument("log")
+    p.add_argument("trace")
+    p = sub.add_parser("from-telemetry", help="extract a trace from a UART capture")
+    p.add_argument("capture")
+    p.add_argument("trace")
+    args = parser.parse_args()
+
+    try:
+        if args.command == "dump":
+            with open(args.trace, "rb") as f:
+                count = dump(f.read())
+            print("%d frames" % count, file=sys.stderr)
+        elif args.command == "from-candump":
+            with open(args.log, encoding="utf-8") as f:
+                trace = from_candump(f.readlines())
+            with open(args.trace, "wb") as f:
+                f.write(trace)
+            print("%d bytes" % len(trace), file=sys.stderr)
+        else:
+            with open(args.capture, "rb") as f:
+                trace, gaps = from_telemetry(f)
+            with open(args.trace, "wb") as f:
+                f.write(trace)
+            print("%d bytes, %d sequence gaps" % (len(trace), gaps), file=sys.stderr)
+            if gaps:
+                print("frames were lost; times after each gap run early", file=sys.stderr)
+    except (OSError, ValueError) as err:
+        print("error: %s" % err, file=sys.stderr)
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
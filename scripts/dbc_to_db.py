@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+"""
+STM32 Platform DBC to Database Signal Table Generator
+
+Reads a DBC file and writes the const signal tables that db_DecodeFrame()
+runs on (see Inc/database.h). Only messages and signals with a "db:" comment
+are emitted:
+
+    CM_ BO_ <id> "db:unit=<node> [alive=<keep_alive_t>]";
+    CM_ SG_ <id> <signal> "db:[<unit>:]<field> [clamp] [latch] [const=<value>]";
+
+<node>/<unit> is PEDAL, SUB, VCU, DASHBOARD or INV1..INV4. Fields are member
+paths inside the unit's struct (inverter_t for INVn). "clamp" limits to the
+DBC [min|max] range. DB fields hold raw values, so factor and offset are
+left to the DBC for host tools. Messages whose signal rows are identical
+share one array, so the four inverters cost one AV1 table.
+
+Usage:
+    python dbc_to_db.py scripts/vcu.dbc -o Inc/DbSignals.h
+    python dbc_to_db.py scripts/vcu.dbc --check Inc/DbSignals.h   (exit 1 if stale)
+"""
+
+import argparse
+import re
+import sys
+from typing import Dict, List, NamedTuple, Optional, Tuple
+
+UNIT_TYPES: Dict[str, str] = {
+    "PEDAL": "pedal_node_t",
+    "SUB": "sub_node_t",
+    "VCU": "vcu_node_t",
+    "DASHBOARD": "dashboard_node_t",
+    "INV1": "inverter_t",
+    "INV2": "inverter_t",
+    "INV3": "inverter_t",
+    "INV4": "inverter_t",
+}
+
+RE_MESSAGE = re.compile(r"^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)")
+RE_SIGNAL = re.compile(r"^SG_\s+(\w+)\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*\([^)]*\)\s*\[([^|]+)\|([^\]]+)\]")
+RE_COMMENT = re.compile(r'^CM_\s+(BO_|SG_)\s+(\d+)\s+(?:(\w+)\s+)?"([^"]*)"\s*;')
+
+
+class Signal(NamedTuple):
+    name: str
+    start: int
+    length: int
+    signed: bool
+    minimum: float
+    maximum: float
+
+
+class Message(NamedTuple):
+    can_id: int
+    name: str
+    signals: Dict[str, Signal]
+
+
+def parse_dbc(text: str) -> Tuple[Dict[int, Message], Dict[Tuple[int, Optional[str]], str]]:
+    """Messages by ID and db: comments keyed by (id, signal or None)"""
+    messages: Dict[int, Message] = {}
+    comments: Dict[Tuple[int, Optional[str]], str] = {}
+    current: Optional[Message] = None
+
+    for lineno, raw in enumerate(text.splitlines(), 1):
+        line = raw.strip()
+        match = RE_MESSAGE.match(line)
+        if match:
+            current = Message(int(match.group(1)), match.group(2), {})
+            messages[current.can_id] = current
+            continue
+        match = RE_SIGNAL.match(line)
+        if match:
+            if current is None:
+                raise ValueError("line %d: signal outside a message" % lineno)
+            name, start, length, order, sign = match.group(1, 2, 3, 4, 5)
+            if order != "1":
+                raise ValueError("line %d: %s is big endian (Motorola), only Intel is supported" % (lineno, name))
+            current.signals[name] = Signal(name, int(start), int(length), sign == "-",
+                                           float(match.group(6)), float(match.group(7)))
+            continue
+        match = RE_COMMENT.match(line)
+        if match and match.group(4).startswith("db:"):
+            comments[(int(match.group(2)), match.group(3))] = match.group(4)[3:].strip()
+    return messages, comments
+
+
+def signal_row(msg: Message, unit: str, sig: Signal, spec: str) -> Tuple[str, str]:
+    """C descriptor row for one mapped signal, and the unit it writes"""
+    words = spec.split()
+    target, options = words[0], words[1:]
+    row_unit = "DB_UNIT_MESSAGE"
+    if ":" in target:
+        override, target = target.split(":", 1)
+        if override not in UNIT_TYPES:
+            raise ValueError("%s.%s: unknown unit %s" % (msg.name, sig.name, override))
+        unit, row_unit = override, "DB_NODE_" + override
+
+    if sig.length < 1 or sig.length > 32 or sig.start + sig.length > 64:
+        raise ValueError("%s.%s: bits %d..%d do not fit the decoder" %
+                         (msg.name, sig.name, sig.start, sig.start + sig.length - 1))
+
+    flags: List[str] = []
+    low, high = 0, 0
+    if sig.signed:
+        flags.append("DB_SIG_SIGNED")
+    for option in options:
+        if option == "clamp":
+            flags.append("DB_SIG_CLAMP")
+            low, high = int(sig.minimum), int(sig.maximum)
+        elif option == "latch":
+            flags.append("DB_SIG_LATCH")
+        elif option.startswith("const="):
+            flags.append("DB_SIG_CONST")
+            low = int(option[6:], 0)
+        else:
+            raise ValueError("%s.%s: unknown option %s" % (msg.name, sig.name, option))
+    for value in (low, high):
+        if value < -32768 or value > 32767:
+            raise ValueError("%s.%s: %d does not fit int16_t" % (msg.name, sig.name, value))
+
+    const = ("0x%02X" % low) if "DB_SIG_CONST" in flags else str(low)
+    row = "DB_SIG(%s, %s, %d, %d, %s, %s, %s, %d)" % (
+        UNIT_TYPES[unit], target, sig.start, sig.length, " | ".join(flags) or "0", row_unit, const, high)
+    return row, row_unit
+
+
+def generate(messages: Dict[int, Message], comments: Dict[Tuple[int, Optional[str]], str], source: str) -> str:
+    tables: Dict[Tuple[str, ...], str] = {}     # rows -> array name
+    arrays: List[Tuple[str, Tuple[str, ...]]] = []
+    descriptors: List[str] = []
+
+    for can_id in sorted(messages, key=lambda i: messages[i].name):
+        msg = messages[can_id]
+        spec = comments.get((can_id, None))
+        if spec is None:
+            continue
+        fields = dict(item.split("=", 1) for item in spec.split())
+        unit = fields.get("unit")
+        if unit not in UNIT_TYPES:
+            raise ValueError("%s: missing or unknown unit" % msg.name)
+        alive = fields.get("alive", "DB_NO_ALIVE")
+
+        rows: List[Tuple[int, str]] = []
+        for sig in msg.signals.values():
+            sig_spec = comments.get((can_id, sig.name))
+            if sig_spec is None:
+                continue
+            row, row_unit = signal_row(msg, unit, sig, sig_spec)
+            rows.append((0 if row_unit == "DB_UNIT_MESSAGE" else 1, row))
+        if not rows:
+            raise ValueError("%s: no mapped signals" % msg.name)
+
+        # Group by unit so each seqlock is taken once per frame
+        key = tuple(row for _, row in sorted(rows, key=lambda r: r[0]))
+        if key not in tables:
+            tables[key] = "db_sig_" + msg.name
+            arrays.append((tables[key], key))
+        descriptors.append("static const db_message_t db_msg_%s = {%s, %d, DB_NODE_%s, %s}; // 0x%03X" % (
+            msg.name, tables[key], len(key), unit, alive, can_id))
+
+    out = [
+        "/*",
+        " * Generated by scripts/dbc_to_db.py from %s - do not edit." % source,
+        " * Signal tables for db_DecodeFrame(); included by DbSetFunctions.c only.",
+        " */",
+        "",
+        "#ifndef DBSIGNALS_H",
+        "#define DBSIGNALS_H",
+        "",
+        '#include "database.h"',
+        "",
+    ]
+    for name, rows in arrays:
+        out.append("static const db_signal_t %s[] = {" % name)
+        out.extend("    %s," % row for row in rows)
+        out.append("};")
+        out.append("")
+    out.extend(descriptors)
+    out.append("")
+    out.append("#endif // DBSIGNALS_H")
+    return "\n".join(out) + "\n"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Generate database signal tables from a DBC file")
+    parser.add_argument("dbc", help="input DBC file")
+    parser.add_argument("-o", "--output", help="header to write (default: stdout)")
+    parser.add_argument("--check", metavar="HEADER", help="compare against an existing header instead")
+    args = parser.parse_args()
+
+    with open(args.dbc, encoding="utf-8", errors="replace") as f:
+        text = f.read()
+    try:
+        messages, comments = parse_dbc(text)
+        header = generate(messages, comments, args.dbc.replace("\\", "/"))
+    except ValueError as err:
+        print("error: %s" % err, file=sys.stderr)
+        return 1
+
+    if args.check:
+        with open(args.check, encoding="utf-8") as f:
+            if f.read() != header:
+                print("%s is out of date - rerun dbc_to_db.py" % args.check, file=sys.stderr)
+                return 1
+        return 0
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8", newline="\n") as f:
+            f.write(header)
+    else:
+        sys.stdout.write(header)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""
+STM32 Platform Telemetry Decoder
+
+Decodes binary records sent with P_UART.sendRecord() (see Inc/telemetry.h).
+Each frame is COBS( type | seq | payload | crc16_le ) followed by 0x00; the CRC
+is CRC-16/CCITT-FALSE over type, seq and payload.
+
+Usage:
+    python telemetry_decode.py capture.bin
+    python telemetry_decode.py --port /dev/ttyUSB0 --baud 115200   (needs pyserial)
+    python telemetry_decode.py - < capture.bin
+"""
+
+import argparse
+import struct
+import sys
+from typing import BinaryIO, Dict, Iterator, List, Optional, Tuple
+
+# Record types and payload layouts (little endian, Cortex-M natural alignment).
+# Records without a layout are printed as hex.
+RECORD_TYPES: Dict[int, Tuple[str, Optional[str], List[str]]] = {
+    0x01: ("TEXT", None, []),
+    0x02: ("CAN_TRACE", None, []),  # Whole can_trace.h entries: scripts/can_trace.py from-telemetry
+    0x10: ("PEDAL_NODE", "<HHhH", ["gas_value", "brake_value", "steering_wheel_angle", "BIOPS"]),
+    0x11: ("SUB_NODE", "<BBHH2x3f3f", ["ASMS", "water_temp", "pump_val1", "pump_val2",
+                                     "accel_x", "accel_y", "accel_z",
+                                     "gyro_x", "gyro_y", "gyro_z"]),
+    0x12: ("VCU_NODE", None, []),
+    0x13: ("DASHBOARD_NODE", "<B", ["R2D"]),
+    # Application records (0x80 and up)
+    0x80: ("VEHICLE_STATE", "<BxHff?3x", ["pedalPosition", "throttleRaw", "throttleVoltage",
+                                         "motorSpeed", "systemReady"]),
+}
+
+
+def crc16_ccitt_false(data: bytes, crc: int = 0xFFFF) -> int:
+    """CRC-16/CCITT-FALSE, matching Telemetry_Crc16()"""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame: bytes) -> bytes:
+    """Undo COBS on one frame (delimiter already removed)"""
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(frame):
+            raise ValueError("malformed COBS block")
+        out += frame[i:i + code - 1]
+        i += code - 1
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def split_frames(stream: BinaryIO) -> Iterator[bytes]:
+    """Yield raw frames between 0x00 delimiters"""
+    pending = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            break
+        for byte in chunk:
+            if byte == 0:
+                if pending:
+                    yield bytes(pending)
+                pending.clear()
+            else:
+                pending.append(byte)
+
+
+def format_record(rtype: int, payload: bytes) -> str:
+    """Render a payload with its known layout, or as hex"""
+    name, layout, fields = RECORD_TYPES.get(rtype, ("TYPE_0x%02X" % rtype, None, []))
+    if rtype == 0x01:
+        return "%s %s" % (name, payload.decode("utf-8", errors="replace"))
+    if layout is not None and struct.calcsize(layout) == len(payload):
+        values = struct.unpack(layout, payload)
+        body = " ".join("%s=%s" % (f, round(v, 4) if isinstance(v, float) else v)
+                        for f, v in zip(fields, values))
+        return "%s %s" % (name, body)
+    return "%s [%d] %s" % (name, len(payload), payload.hex())
+
+
+def decode_stream(stream: BinaryIO, out=sys.stdout) -> Dict[str, int]:
+    stats = {"frames": 0, "crc_errors": 0, "malformed": 0, "seq_gaps": 0}
+    last_seq: Dict[int, int] = {}
+
+    for frame in split_frames(stream):
+        try:
+            raw = cobs_decode(frame)
+        except ValueError:
+            stats["malformed"] += 1
+            continue
+        if len(raw) < 4:
+            stats["malformed"] += 1
+            continue
+
+        body, crc = raw[:-2], raw[-2] | (raw[-1] << 8)
+        if crc16_ccitt_false(body) != crc:
+            stats["crc_errors"] += 1
+            continue
+
+        rtype, seq, payload = body[0], body[1], body[2:]
+        if rtype in last_seq and seq != (last_seq[rtype] + 1) & 0xFF:
+            stats["seq_gaps"] += 1
+        last_seq[rtype] = seq
+
+        stats["frames"] += 1
+        print("seq=%03d %s" % (seq, format_record(rtype, payload)), file=out)
+
+    return stats
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Decode STM32 Platform telemetry frames")
+    parser.add_argument("input", nargs="?", help="capture file, or - for stdin")
+    parser.add_argument("--port", help="serial port to read instead of a file")
+    parser.add_argument("--baud", type=int, default=115200, help="serial baud rate")
+    args = parser.parse_args()
+
+    if args.port:
+        try:
+            import serial  # type: ignore
+        except ImportError:
+            print("pyserial is required for --port (pip install pyserial)", file=sys.stderr)
+            return 1
+        stream = serial.Serial(args.port, args.baud)
+    elif args.input and args.input != "-":
+        stream = open(args.input, "rb")
+    else:
+        stream = sys.stdin.buffer
+
+    try:
+        stats = decode_stream(stream)
+    except KeyboardInterrupt:
+        return 0
+    finally:
+        if stream is not sys.stdin.buffer:
+            stream.close()
+
+    print("%d frames, %d CRC errors, %d malformed, %d sequence gaps" %
+          (stats["frames"], stats["crc_errors"], stats["malformed"], stats["seq_gaps"]), file=sys.stderr)
+    return 0 if stats["crc_errors"] == 0 and stats["malformed"] == 0 else 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
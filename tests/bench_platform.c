@@ -0,0 +1,413 @@
+/**
+ * @file bench_platform.c
+ * @brief Host benchmark: queue, routing, CAN dispatch and decode throughput
+ *
+ * Links the whole library against the HAL mocks and times the paths a CAN
+ * frame takes: Queue_Push/Queue_Pop, hash_TableLookup (hit, miss, full
+ * table), the RX interrupt plus P_CAN.handleRxMessages() dispatch with a
+ * bus-like ID mix, a flat-out P_CAN.startReplay() of the same mix (the
+ * saturation rate of the dispatch path), and each database decode handler.
+ * Each benchmark runs BENCH_REPEATS times and keeps its fastest pass, which
+ * filters out most scheduler noise. Results go to stdout, or to the file
+ * named on the command line, as JSON:
+ *
+ *     {"benchmarks": [{"name": "queue_push_pop_spsc", "ops": 409600,
+ *                      "ns_per_op": 31.7, "ops_per_sec": 31545741}, ...]}
+ *
+ * Numbers are host-relative; compare a run against one from the previous
+ * commit on the same machine (scripts/bench_compare.py), not against
+ * Cortex-M cycle counts.
+ */
+
+#include "stm32_platform.h"
+#include "utils.h"
+#include "hashtable.h"
+#include "database.h"
+#include "DbSetFunctions.h"
+#include "can_trace.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ROUNDS        100
+#define BENCH_REPEATS       5
+#define BENCH_STREAM_LEN    4096
+#define BENCH_QUEUE_DEPTH   64
+#define BENCH_FULL_SIZE     64      // Open-addressed table filled to the last slot
+#define BENCH_BURST         32      // Frames per RX interrupt
+#define BENCH_MAX_RESULTS   48
+#define BENCH_TRACE_GAP_US  125     // 8000 frames/s, a saturated 1 Mbit/s bus
+
+typedef struct {
+    char     name[40];
+    uint64_t ops;
+    double   ns_per_op;
+} bench_result_t;
+
+static bench_result_t results[BENCH_MAX_RESULTS];
+static size_t result_count;
+
+// Same set the static backend is generated from
+static const uint32_t routed_ids[] = {
+#define BENCH_ROUTE_ID(msg_id, fn) (msg_id),
+    DB_CAN_ROUTE_TABLE(BENCH_ROUTE_ID)
+#undef BENCH_ROUTE_ID
+};
+static const struct {
+    const char    *name;
+    Set_Function_t fn;
+} decoders[] = {
+#define BENCH_DECODER(msg_id, fn) { #fn, fn },
+    DB_CAN_ROUTE_TABLE(BENCH_DECODER)
+#undef BENCH_DECODER
+};
+#define ROUTED_COUNT (sizeof(routed_ids) / sizeof(routed_ids[0]))
+
+static uint32_t hit_stream[BENCH_STREAM_LEN];
+static uint32_t miss_stream[BENCH_STREAM_LEN];
+static uint32_t bus_stream[BENCH_STREAM_LEN];
+static volatile uint32_t sink;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief Store one pass of a benchmark, keeping the fastest pass per name
+ */
+static void record(const char *name, uint64_t ops, double elapsed_ns)
+{
+    if (ops == 0) return;
+    double ns_per_op = elapsed_ns / (double)ops;
+
+    for (size_t i = 0; i < result_count; i++) {
+        if (strcmp(results[i].name, name) == 0) {
+            if (ns_per_op < results[i].ns_per_op) results[i].ns_per_op = ns_per_op;
+            return;
+        }
+    }
+    if (result_count >= BENCH_MAX_RESULTS) return;
+    bench_result_t *r = &results[result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->ops = ops;
+    r->ns_per_op = ns_per_op;
+}
+
+static int is_routed(uint32_t id)
+{
+    for (size_t i = 0; i < ROUTED_COUNT; i++) {
+        if (routed_ids[i] == id) return 1;
+    }
+    return 0;
+}
+
+static uint32_t next_random(uint32_t *lcg)
+{
+    *lcg = *lcg * 1664525u + 1013904223u;
+    return *lcg >> 16;
+}
+
+/**
+ * @brief Build the ID streams
+ * @note The bus mix weights the inverters (4 x 2 frames per cycle) over the
+ *       slower nodes and adds ~10 % unrouted traffic for the default handler
+ */
+static void build_streams(void)
+{
+    uint32_t lcg = 12345;
+    size_t m = 0;
+
+    for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+        hit_stream[i] = routed_ids[i % ROUTED_COUNT];
+    }
+    while (m < BENCH_STREAM_LEN) {
+        uint32_t id = next_random(&lcg) & 0x7FF;
+        if (!is_routed(id)) miss_stream[m++] = id;
+    }
+    for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+        uint32_t pick = next_random(&lcg) % 100;
+        if (pick < 60) {
+            bus_stream[i] = routed_ids[next_random(&lcg) % 8];                     // Inverter AV1/AV2
+        } else if (pick < 90) {
+            bus_stream[i] = routed_ids[8 + next_random(&lcg) % (ROUTED_COUNT - 8)];  // Other nodes
+        } else {
+            bus_stream[i] = miss_stream[i];
+        }
+    }
+}
+
+/* ==================== Queue ==================== */
+
+static void bench_queue(const char *name, QueueMode_t mode)
+{
+    static CANMessage_t storage[BENCH_QUEUE_DEPTH];
+    CANMessage_t msg = { .id = 0x100, .length = 8 };
+    Queue_t queue;
+
+    if (Queue_InitStatic(&queue, storage, sizeof(CANMessage_t), BENCH_QUEUE_DEPTH, mode) != PLT_OK) {
+        fprintf(stderr, "%s: queue init failed\n", name);
+        return;
+    }
+
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (size_t i = 0; i < BENCH_STREAM_LEN; i += BENCH_QUEUE_DEPTH) {
+            for (size_t k = 0; k < BENCH_QUEUE_DEPTH; k++) {
+                msg.id = (uint16_t)k;
+                Queue_Push(&queue, &msg);
+            }
+            for (size_t k = 0; k < BENCH_QUEUE_DEPTH; k++) {
+                Queue_Pop(&queue, &msg);
+                sink += msg.id;
+            }
+        }
+    }
+    // One push plus one pop per operation
+    record(name, (uint64_t)BENCH_ROUNDS * BENCH_STREAM_LEN, now_ns() - start);
+}
+
+/* ==================== Hash Lookup ==================== */
+
+static void bench_lookup(const char *name, const hash_table_t *table, const uint32_t *stream)
+{
+    uintptr_t acc = 0;
+    double start = now_ns();
+
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+            acc ^= (uintptr_t)hash_TableLookup(table, stream[i]);
+        }
+    }
+    sink += (uint32_t)acc;
+    record(name, (uint64_t)BENCH_ROUNDS * BENCH_STREAM_LEN, now_ns() - start);
+}
+
+static hash_member_t route_slots[64];
+static hash_member_t full_slots[BENCH_FULL_SIZE];
+static uint32_t full_hits[BENCH_STREAM_LEN];
+static uint32_t full_misses[BENCH_STREAM_LEN];
+static hash_table_t routes, full;
+
+static int setup_hash(void)
+{
+    uint32_t full_ids[BENCH_FULL_SIZE];
+    uint32_t lcg = 777;
+
+    // Routing table sized like CAN_ROUTE_TABLE_SIZE_0, holding the database set
+    hash_TableInit(&routes, route_slots, 64);
+    for (size_t i = 0; i < ROUTED_COUNT; i++) {
+        hash_member_t member = { .id = routed_ids[i], .Set_Function = decoders[i].fn };
+        if (hash_TableInsert(&routes, &member) != HASH_OK) {
+            fprintf(stderr, "hash route setup failed for 0x%03X\n", (unsigned)routed_ids[i]);
+            return 1;
+        }
+    }
+
+    // Every slot taken: hits probe long chains and misses scan the whole table
+    hash_TableInit(&full, full_slots, BENCH_FULL_SIZE);
+    for (size_t n = 0; n < BENCH_FULL_SIZE; ) {
+        hash_member_t member = { .id = next_random(&lcg) & 0x7FF, .Set_Function = decoders[0].fn };
+        if (hash_TableLookup(&full, member.id) != NULL) continue;
+        if (hash_TableInsert(&full, &member) != HASH_OK) {
+            fprintf(stderr, "full table setup stopped at %u entries\n", (unsigned)n);
+            return 1;
+        }
+        full_ids[n++] = member.id;
+    }
+    for (size_t i = 0, m = 0; i < BENCH_STREAM_LEN; i++) {
+        full_hits[i] = full_ids[i % BENCH_FULL_SIZE];
+        for (;;) {
+            uint32_t id = next_random(&lcg) & 0x7FF;
+            if (hash_TableLookup(&full, id) == NULL) {
+                full_misses[m++] = id;
+                break;
+            }
+        }
+    }
+    return 0;
+}
+
+static void bench_hash(void)
+{
+    bench_lookup("hash_lookup_hit", &routes, hit_stream);
+    bench_lookup("hash_lookup_miss", &routes, miss_stream);
+    bench_lookup("hash_lookup_full_hit", &full, full_hits);
+    bench_lookup("hash_lookup_full_miss", &full, full_misses);
+}
+
+/* ==================== CAN Dispatch ==================== */
+
+static volatile uint32_t unrouted_frames;
+
+static void on_unrouted(CANMessage_t *msg)
+{
+    unrouted_frames += msg->id;
+}
+
+static CAN_HandleTypeDef hcan = { .Instance = CAN1 };
+
+static int setup_can(void)
+{
+    void *can_handles[] = { &hcan };
+    PlatformHandles_t handles = { .hcan = can_handles, .can_count = 1 };
+
+    if (db_Init() == NULL || Platform.begin(&handles) == NULL) {
+        fprintf(stderr, "platform setup failed\n");
+        return 1;
+    }
+    Platform.onCAN(on_unrouted);
+    for (size_t i = 0; i < ROUTED_COUNT; i++) {
+        P_CAN.route(0, (uint16_t)routed_ids[i], (void (*)(CANMessage_t *))decoders[i].fn);
+    }
+    return 0;
+}
+
+static int bench_can(void)
+{
+    uint8_t payload[8] = { 0x10, 0x27, 0x05, 0x00, 0xFB, 0xFF, 0x40, 0x01 };
+    uint32_t rx_before = P_CAN.getRxCount(0);
+    double isr_ns = 0;
+    double dispatch_ns = 0;
+    uint64_t frames = 0;
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (size_t i = 0; i < BENCH_STREAM_LEN; i += BENCH_BURST) {
+            for (size_t k = 0; k < BENCH_BURST; k++) {
+                payload[0] = (uint8_t)(i + k);
+                Mock_CAN_PushRxMessage(CAN_RX_FIFO0, bus_stream[i + k], payload, 8);
+            }
+
+            double t0 = now_ns();
+            HAL_CAN_RxFifo0MsgPendingCallback(&hcan);
+            double t1 = now_ns();
+            P_CAN.handleRxMessages(0);
+            double t2 = now_ns();
+
+            isr_ns += t1 - t0;
+            dispatch_ns += t2 - t1;
+            frames += BENCH_BURST;
+        }
+    }
+
+    uint32_t received = P_CAN.getRxCount(0) - rx_before;
+    if (received != frames) {
+        fprintf(stderr, "CAN RX dropped frames: %lu of %lu\n",
+                (unsigned long)received, (unsigned long)frames);
+        return 1;
+    }
+    record("can_rx_isr", frames, isr_ns);
+    record("can_dispatch_bus_mix", frames, dispatch_ns);
+    record("can_rx_end_to_end", frames, isr_ns + dispatch_ns);
+    return 0;
+}
+
+/* ==================== CAN Replay ==================== */
+
+static uint8_t trace[CAN_TRACE_HEADER_SIZE + BENCH_STREAM_LEN * CAN_TRACE_ENTRY_MAX];
+static uint32_t trace_length;
+
+static void build_trace(void)
+{
+    trace_length = (uint32_t)CANTrace_WriteHeader(trace, sizeof(trace));
+    for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+        CANTraceFrame_t frame = { .delta_us = BENCH_TRACE_GAP_US, .id = (uint16_t)bus_stream[i], .length = 8 };
+        frame.data[0] = (uint8_t)i;
+        trace_length += (uint32_t)CANTrace_Encode(&frame, &trace[trace_length], sizeof(trace) - trace_length);
+    }
+}
+
+static int bench_replay(void)
+{
+    CANTraceStatus_t status;
+    uint64_t frames = 0;
+    double start = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS / 10; r++) {
+        if (!P_CAN.startReplay(trace, trace_length, 0)) {
+            fprintf(stderr, "replay start failed: %d\n", Platform.getLastError());
+            return 1;
+        }
+        do {
+            P_CAN.handleRxMessagesBatch(0, 0);
+            P_CAN.getTraceStatus(&status);
+        } while (status.replaying || P_CAN.availableMessages(0) > 0);
+        frames += status.replayed;
+    }
+    double elapsed = now_ns() - start;
+
+    if (frames != (uint64_t)(BENCH_ROUNDS / 10) * BENCH_STREAM_LEN) {
+        fprintf(stderr, "replay lost frames: %lu\n", (unsigned long)frames);
+        return 1;
+    }
+    record("can_replay_saturation", frames, elapsed);
+    return 0;
+}
+
+/* ==================== Decode Handlers ==================== */
+
+static void bench_decoders(void)
+{
+    uint8_t frames[16][8];
+    uint32_t lcg = 4242;
+
+    for (size_t f = 0; f < 16; f++) {
+        for (size_t b = 0; b < 8; b++) {
+            frames[f][b] = (uint8_t)next_random(&lcg);
+        }
+    }
+
+    for (size_t d = 0; d < ROUTED_COUNT; d++) {
+        char name[40];
+        double start = now_ns();
+        for (int r = 0; r < BENCH_ROUNDS; r++) {
+            for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+                decoders[d].fn(frames[i & 15]);
+            }
+        }
+        snprintf(name, sizeof(name), "decode_%s", decoders[d].name);
+        record(name, (uint64_t)BENCH_ROUNDS * BENCH_STREAM_LEN, now_ns() - start);
+    }
+}
+
+/* ==================== Report ==================== */
+
+static void write_json(FILE *out)
+{
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < result_count; i++) {
+        const bench_result_t *r = &results[i];
+        fprintf(out, "    {\"name\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+                r->name, (unsigned long long)r->ops, r->ns_per_op,
+                (r->ns_per_op > 0) ? 1e9 / r->ns_per_op : 0.0,
+                (i + 1 < result_count) ? "," : "");
+    }
+    fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+    build_streams();
+    if (setup_hash() != 0 || setup_can() != 0) return 1;
+    build_trace();
+
+    for (int pass = 0; pass < BENCH_REPEATS; pass++) {
+        bench_queue("queue_push_pop_spsc", QUEUE_MODE_SPSC);
+        bench_queue("queue_push_pop_locked", QUEUE_MODE_LOCKED);
+        bench_hash();
+        if (bench_can() != 0 || bench_replay() != 0) return 1;
+        bench_decoders();
+    }
+
+    FILE *out = stdout;
+    if (argc > 1) {
+        out = fopen(argv[1], "w");
+        if (out == NULL) {
+            fprintf(stderr, "cannot write %s\n", argv[1]);
+            return 1;
+        }
+    }
+    write_json(out);
+    if (out != stdout) fclose(out);
+    return 0;
+}
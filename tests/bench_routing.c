@@ -0,0 +1,99 @@
+/**
+ * @file bench_routing.c
+ * @brief Host benchmark: CAN routing lookup cost per backend
+ *
+ * Routes the database message set and replays a bus-like ID stream through
+ * hash_Lookup(), direct_Lookup() and static_Lookup(), reporting ns per lookup for routed
+ * (hit) and unrouted (miss) traffic. Numbers are host-relative; use them to
+ * compare backends, not to predict Cortex-M cycle counts.
+ */
+
+#include "hashtable.h"
+#include "database.h"
+#include <stdio.h>
+#include <time.h>
+
+#define BENCH_STREAM_LEN  4096
+#define BENCH_ROUNDS      2000
+
+// Same set the static backend is generated from
+static const uint32_t routed_ids[] = {
+#define BENCH_ROUTE_ID(msg_id, fn) (msg_id),
+    DB_CAN_ROUTE_TABLE(BENCH_ROUTE_ID)
+#undef BENCH_ROUTE_ID
+};
+#define ROUTED_COUNT (sizeof(routed_ids) / sizeof(routed_ids[0]))
+
+static uint32_t hit_stream[BENCH_STREAM_LEN];
+static uint32_t miss_stream[BENCH_STREAM_LEN];
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int is_routed(uint32_t id)
+{
+    for (size_t i = 0; i < ROUTED_COUNT; i++) {
+        if (routed_ids[i] == id) return 1;
+    }
+    return 0;
+}
+
+static void build_streams(void)
+{
+    uint32_t lcg = 12345;
+    size_t m = 0;
+
+    for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+        hit_stream[i] = routed_ids[i % ROUTED_COUNT];
+    }
+    while (m < BENCH_STREAM_LEN) {
+        lcg = lcg * 1664525u + 1013904223u;
+        uint32_t id = (lcg >> 16) & 0x7FF;
+        if (!is_routed(id)) miss_stream[m++] = id;
+    }
+}
+
+static double bench(Set_Function_t (*lookup)(uint32_t), const uint32_t *stream)
+{
+    volatile uintptr_t sink = 0;
+    double start = now_ns();
+
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        for (size_t i = 0; i < BENCH_STREAM_LEN; i++) {
+            sink ^= (uintptr_t)lookup(stream[i]);
+        }
+    }
+
+    (void)sink;
+    return (now_ns() - start) / ((double)BENCH_ROUNDS * BENCH_STREAM_LEN);
+}
+
+int main(void)
+{
+    hash_Init();
+    direct_Init();
+    static_Init();
+
+    if (hash_SetTable() != HASH_OK) {
+        fprintf(stderr, "hash route setup failed\n");
+        return 1;
+    }
+    for (size_t i = 0; i < ROUTED_COUNT; i++) {
+        hash_member_t member = { .id = routed_ids[i], .Set_Function = hash_Lookup(routed_ids[i]) };
+        if (direct_InsertMember(&member) != HASH_OK) {
+            fprintf(stderr, "direct route setup failed for 0x%03X\n", (unsigned)routed_ids[i]);
+            return 1;
+        }
+    }
+    build_streams();
+
+    printf("%-8s %12s %12s\n", "backend", "hit ns/op", "miss ns/op");
+    printf("%-8s %12.2f %12.2f\n", "hash", bench(hash_Lookup, hit_stream), bench(hash_Lookup, miss_stream));
+    printf("%-8s %12.2f %12.2f\n", "direct", bench(direct_Lookup, hit_stream), bench(direct_Lookup, miss_stream));
+    printf("%-8s %12.2f %12.2f\n", "static", bench(static_Lookup, hit_stream), bench(static_Lookup, miss_stream));
+    return 0;
+}
@@ -14,24 +14,38 @@
 static HAL_StatusTypeDef mock_hal_status = HAL_OK;
 static uint32_t mock_tick = 0;
 
-// Mock CAN state
-static uint8_t mock_can_rx_pending = 0;
-static CAN_RxHeaderTypeDef mock_can_rx_header;
-static uint8_t mock_can_rx_data[8];
+// Register blocks the peripheral macros point at
+uint32_t SystemCoreClock = 168000000;
+RCC_TypeDef Mock_RCC;
+CAN_TypeDef Mock_CAN1, Mock_CAN2;
+USART_TypeDef Mock_USART1, Mock_USART2, Mock_USART3;
+SPI_TypeDef Mock_SPI1, Mock_SPI2, Mock_SPI3;
+ADC_TypeDef Mock_ADC1, Mock_ADC2, Mock_ADC3;
+TIM_TypeDef Mock_TIM1, Mock_TIM2, Mock_TIM3, Mock_TIM4;
+
+// Mock CAN state: one ring of pending frames per RX FIFO
+static struct {
+    CAN_RxHeaderTypeDef header[MOCK_CAN_FIFO_DEPTH];
+    uint8_t data[MOCK_CAN_FIFO_DEPTH][8];
+    uint32_t head;
+    uint32_t count;
+} mock_can_fifo[2];
+static uint32_t mock_can_free_mailboxes = 3;
 
 // Mock UART state
 static uint8_t mock_uart_rx_data[256];
 static uint16_t mock_uart_rx_size = 0;
+static uint8_t *mock_uart_rx_dma = NULL;
 
 // ==================== Helper Functions ====================
 
 void Mock_HAL_Reset(void) {
     mock_hal_status = HAL_OK;
     mock_tick = 0;
-    mock_can_rx_pending = 0;
+    mock_can_free_mailboxes = 3;
     mock_uart_rx_size = 0;
-    memset(&mock_can_rx_header, 0, sizeof(mock_can_rx_header));
-    memset(mock_can_rx_data, 0, sizeof(mock_can_rx_data));
+    mock_uart_rx_dma = NULL;
+    memset(mock_can_fifo, 0, sizeof(mock_can_fifo));
     memset(mock_uart_rx_data, 0, sizeof(mock_uart_rx_data));
 }
 
@@ -44,10 +58,31 @@ void Mock_HAL_SetTick(uint32_t tick) {
 }
 
 void Mock_CAN_SetRxMessage(uint32_t id, uint8_t *data, uint8_t dlc) {
-    mock_can_rx_header.StdId = id;
-    mock_can_rx_header.DLC = dlc;
-    memcpy(mock_can_rx_data, data, dlc);
-    mock_can_rx_pending = 1;
+    Mock_CAN_PushRxMessage(CAN_RX_FIFO0, id, data, dlc);
+}
+
+int Mock_CAN_PushRxMessage(uint32_t fifo, uint32_t id, const uint8_t *data, uint8_t dlc) {
+    if (fifo > CAN_RX_FIFO1 || mock_can_fifo[fifo].count >= MOCK_CAN_FIFO_DEPTH || dlc > 8) {
+        return -1;
+    }
+    uint32_t slot = (mock_can_fifo[fifo].head + mock_can_fifo[fifo].count) % MOCK_CAN_FIFO_DEPTH;
+    memset(&mock_can_fifo[fifo].header[slot], 0, sizeof(CAN_RxHeaderTypeDef));
+    mock_can_fifo[fifo].header[slot].StdId = id;
+    mock_can_fifo[fifo].header[slot].DLC = dlc;
+    memset(mock_can_fifo[fifo].data[slot], 0, 8);
+    if (data != NULL) {
+        memcpy(mock_can_fifo[fifo].data[slot], data, dlc);
+    }
+    mock_can_fifo[fifo].count++;
+    return 0;
+}
+
+void Mock_CAN_SetFreeMailboxes(uint32_t count) {
+    mock_can_free_mailboxes = (count > 3) ? 3 : count;
+}
+
+uint8_t *Mock_UART_GetRxDmaBuffer(void) {
+    return mock_uart_rx_dma;
 }
 
 // ==================== HAL General ====================
@@ -61,6 +96,16 @@ uint32_t HAL_GetTick(void) {
     return mock_tick++;
 }
 
+// ==================== HAL GPIO ====================
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState) {
+    if (PinState == GPIO_PIN_SET) {
+        GPIOx->ODR |= GPIO_Pin;
+    } else {
+        GPIOx->ODR &= ~(uint32_t)GPIO_Pin;
+    }
+}
+
 // ==================== HAL CAN ====================
 
 HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan) {
@@ -73,7 +118,7 @@ HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan) {
     return mock_hal_status;
 }
 
-HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig) {
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, const CAN_FilterTypeDef *sFilterConfig) {
     (void)hcan;
     (void)sFilterConfig;
     return mock_hal_status;
@@ -93,17 +138,21 @@ HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan, uint32
 
 HAL_StatusTypeDef HAL_CAN_AddTxMessage(
     CAN_HandleTypeDef *hcan,
-    CAN_TxHeaderTypeDef *pHeader,
-    uint8_t aData[],
+    const CAN_TxHeaderTypeDef *pHeader,
+    const uint8_t aData[],
     uint32_t *pTxMailbox)
 {
     (void)hcan;
     (void)pHeader;
     (void)aData;
+    if (mock_hal_status != HAL_OK || mock_can_free_mailboxes == 0) {
+        return HAL_ERROR;
+    }
+    mock_can_free_mailboxes--;
     if (pTxMailbox != NULL) {
-        *pTxMailbox = 0; // Assume mailbox 0
+        *pTxMailbox = CAN_TX_MAILBOX0; // Assume mailbox 0
     }
-    return mock_hal_status;
+    return HAL_OK;
 }
 
 HAL_StatusTypeDef HAL_CAN_GetRxMessage(
@@ -113,26 +162,41 @@ HAL_StatusTypeDef HAL_CAN_GetRxMessage(
     uint8_t aData[])
 {
     (void)hcan;
-    (void)RxFifo;
     
-    if (mock_can_rx_pending) {
+    if (RxFifo <= CAN_RX_FIFO1 && mock_can_fifo[RxFifo].count > 0) {
+        uint32_t slot = mock_can_fifo[RxFifo].head;
         if (pHeader != NULL) {
-            memcpy(pHeader, &mock_can_rx_header, sizeof(CAN_RxHeaderTypeDef));
+            memcpy(pHeader, &mock_can_fifo[RxFifo].header[slot], sizeof(CAN_RxHeaderTypeDef));
         }
         if (aData != NULL) {
-            memcpy(aData, mock_can_rx_data, 8);
+            memcpy(aData, mock_can_fifo[RxFifo].data[slot], 8);
         }
-        mock_can_rx_pending = 0;
+        mock_can_fifo[RxFifo].head = (slot + 1) % MOCK_CAN_FIFO_DEPTH;
+        mock_can_fifo[RxFifo].count--;
         return HAL_OK;
     }
     
     return HAL_ERROR;
 }
 
-uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo) {
+uint32_t HAL_CAN_GetRxFifoFillLevel(const CAN_HandleTypeDef *hcan, uint32_t RxFifo) {
+    (void)hcan;
+    return (RxFifo <= CAN_RX_FIFO1) ? mock_can_fifo[RxFifo].count : 0;
+}
+
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(const CAN_HandleTypeDef *hcan) {
+    (void)hcan;
+    return mock_can_free_mailboxes;
+}
+
+uint32_t HAL_CAN_GetTxTimestamp(const CAN_HandleTypeDef *hcan, uint32_t TxMailbox) {
     (void)hcan;
-    (void)RxFifo;
-    return mock_can_rx_pending ? 1 : 0;
+    (void)TxMailbox;
+    return mock_tick & 0xFFFFU;
+}
+
+HAL_CAN_StateTypeDef HAL_CAN_GetState(const CAN_HandleTypeDef *hcan) {
+    return hcan->State;
 }
 
 uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan) {
@@ -147,6 +211,11 @@ HAL_StatusTypeDef HAL_CAN_ResetError(CAN_HandleTypeDef *hcan) {
 
 // ==================== HAL UART ====================
 
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart) {
+    (void)huart;
+    return mock_hal_status;
+}
+
 HAL_StatusTypeDef HAL_UART_Transmit(
     UART_HandleTypeDef *huart,
     const uint8_t *pData,
@@ -186,6 +255,13 @@ HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t
     return mock_hal_status;
 }
 
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    (void)pData;
+    (void)Size;
+    return mock_hal_status;
+}
+
 HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
     (void)huart;
     (void)pData;
@@ -193,6 +269,25 @@ HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData
     return mock_hal_status;
 }
 
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size) {
+    mock_uart_rx_dma = pData;
+    huart->RxState = HAL_UART_STATE_BUSY_RX;
+    if (huart->hdmarx != NULL) {
+        huart->hdmarx->Instance->NDTR = Size;
+    }
+    return mock_hal_status;
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart) {
+    huart->RxState = HAL_UART_STATE_READY;
+    return HAL_OK;
+}
+
+HAL_UART_StateTypeDef HAL_UART_GetState(const UART_HandleTypeDef *huart) {
+    (void)huart;
+    return HAL_UART_STATE_READY;
+}
+
 HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart) {
     (void)huart;
     return HAL_OK;
@@ -200,6 +295,11 @@ HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart) {
 
 // ==================== HAL SPI ====================
 
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi) {
+    (void)hspi;
+    return mock_hal_status;
+}
+
 HAL_StatusTypeDef HAL_SPI_Transmit(
     SPI_HandleTypeDef *hspi,
     const uint8_t *pData,
@@ -268,8 +368,40 @@ HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(
     return mock_hal_status;
 }
 
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size) {
+    (void)hspi;
+    (void)pData;
+    (void)Size;
+    return mock_hal_status;
+}
+
+HAL_StatusTypeDef HAL_SPI_Receive_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size) {
+    (void)hspi;
+    (void)pData;
+    (void)Size;
+    return mock_hal_status;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(
+    SPI_HandleTypeDef *hspi,
+    const uint8_t *pTxData,
+    uint8_t *pRxData,
+    uint16_t Size)
+{
+    (void)hspi;
+    (void)pTxData;
+    (void)pRxData;
+    (void)Size;
+    return mock_hal_status;
+}
+
 // ==================== HAL ADC ====================
 
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc) {
+    (void)hadc;
+    return mock_hal_status;
+}
+
 HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc) {
     (void)hadc;
     return mock_hal_status;
@@ -292,7 +424,19 @@ HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc) {
     return mock_hal_status;
 }
 
-uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc) {
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout) {
+    (void)hadc;
+    (void)Timeout;
+    return mock_hal_status;
+}
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, const ADC_ChannelConfTypeDef *sConfig) {
+    (void)hadc;
+    (void)sConfig;
+    return mock_hal_status;
+}
+
+uint32_t HAL_ADC_GetValue(const ADC_HandleTypeDef *hadc) {
     (void)hadc;
     return 2048; // Return mid-scale value
 }
@@ -300,12 +444,14 @@ uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc) {
 // ==================== HAL TIM ====================
 
 HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim) {
-    (void)htim;
+    if (mock_hal_status == HAL_OK) {
+        htim->Instance->CR1 |= TIM_CR1_CEN;
+    }
     return mock_hal_status;
 }
 
 HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim) {
-    (void)htim;
+    htim->Instance->CR1 &= ~TIM_CR1_CEN;
     return mock_hal_status;
 }
 
@@ -321,6 +467,35 @@ HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel) {
     return mock_hal_status;
 }
 
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef *htim, uint32_t EventSource) {
+    (void)htim;
+    (void)EventSource;
+    return mock_hal_status;
+}
+
+HAL_StatusTypeDef HAL_TIM_DMABurst_MultiWriteStart(
+    TIM_HandleTypeDef *htim,
+    uint32_t BurstBaseAddress,
+    uint32_t BurstRequestSrc,
+    const uint32_t *BurstBuffer,
+    uint32_t BurstLength,
+    uint32_t DataLength)
+{
+    (void)htim;
+    (void)BurstBaseAddress;
+    (void)BurstRequestSrc;
+    (void)BurstBuffer;
+    (void)BurstLength;
+    (void)DataLength;
+    return mock_hal_status;
+}
+
+HAL_StatusTypeDef HAL_TIM_DMABurst_WriteStop(TIM_HandleTypeDef *htim, uint32_t BurstRequestSrc) {
+    (void)htim;
+    (void)BurstRequestSrc;
+    return mock_hal_status;
+}
+
 // ==================== HAL RCC ====================
 
 uint32_t HAL_RCC_GetPCLK1Freq(void) {
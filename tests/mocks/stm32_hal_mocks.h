@@ -1,8 +1,10 @@
 /**
  * @file stm32_hal_mocks.h
  * @brief Mock header for STM32 HAL functions
- * 
- * Provides minimal HAL type definitions and function declarations for testing
+ *
+ * Provides minimal HAL type definitions and function declarations for testing.
+ * Peripheral handles point at RAM register blocks (Mock_CAN1, Mock_TIM2, ...)
+ * so the register-level code in stm32_platform.c runs on the host as well.
  */
 
 #ifndef STM32_HAL_MOCKS_H
@@ -11,6 +13,8 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#define __IO volatile
+
 // ==================== HAL Status ====================
 
 typedef enum {
@@ -20,6 +24,11 @@ typedef enum {
     HAL_TIMEOUT  = 0x03U
 } HAL_StatusTypeDef;
 
+typedef enum {
+    DISABLE = 0U,
+    ENABLE  = 1U
+} FunctionalState;
+
 // ==================== HAL Peripheral States ====================
 
 typedef enum {
@@ -53,13 +62,93 @@ typedef enum {
     HAL_SPI_STATE_ABORT      = 0x07U
 } HAL_SPI_StateTypeDef;
 
+// ==================== Core Definitions ====================
+
+extern uint32_t SystemCoreClock;
+
+// ==================== RCC Definitions ====================
+
+typedef struct {
+    __IO uint32_t CFGR;
+} RCC_TypeDef;
+
+extern RCC_TypeDef Mock_RCC;
+#define RCC (&Mock_RCC)
+
+#define RCC_CFGR_PPRE1_Pos          10U
+#define RCC_CFGR_PPRE2_Pos          13U
+
+// ==================== GPIO Definitions ====================
+
+typedef struct {
+    __IO uint32_t ODR;
+    __IO uint32_t BSRR;
+} GPIO_TypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+// ==================== DMA Definitions ====================
+
+typedef struct {
+    __IO uint32_t CR;
+    __IO uint32_t NDTR;
+} DMA_Stream_TypeDef;
+
+#define DMA_NORMAL                      0x00000000U
+#define DMA_CIRCULAR                    0x00000100U
+
+typedef struct {
+    uint32_t Mode;
+} DMA_InitTypeDef;
+
+typedef struct {
+    DMA_Stream_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+} DMA_HandleTypeDef;
+
+#define __HAL_DMA_GET_COUNTER(hdma) ((hdma)->Instance->NDTR)
+
 // ==================== CAN Definitions ====================
 
-#define CAN_IT_RX_FIFO0_MSG_PENDING     0x00000001U
+typedef struct {
+    __IO uint32_t FR1;
+    __IO uint32_t FR2;
+} CAN_FilterRegister_TypeDef;
+
+typedef struct {
+    __IO uint32_t MCR;
+    __IO uint32_t MSR;
+    __IO uint32_t TSR;
+    __IO uint32_t RF0R;
+    __IO uint32_t RF1R;
+    __IO uint32_t IER;
+    __IO uint32_t ESR;
+    __IO uint32_t BTR;
+    __IO uint32_t FMR;
+    __IO uint32_t FM1R;
+    __IO uint32_t FS1R;
+    __IO uint32_t FFA1R;
+    __IO uint32_t FA1R;
+    CAN_FilterRegister_TypeDef sFilterRegister[28];
+} CAN_TypeDef;
+
+#define CAN_IT_TX_MAILBOX_EMPTY         0x00000001U
+#define CAN_IT_RX_FIFO0_MSG_PENDING     0x00000002U
 #define CAN_IT_RX_FIFO1_MSG_PENDING     0x00000010U
 #define CAN_RX_FIFO0                    0x00000000U
 #define CAN_RX_FIFO1                    0x00000001U
 
+#define CAN_ID_STD                      0x00000000U
+#define CAN_ID_EXT                      0x00000004U
+#define CAN_RTR_DATA                    0x00000000U
+
+#define CAN_TX_MAILBOX0                 0x00000001U
+#define CAN_TX_MAILBOX1                 0x00000002U
+#define CAN_TX_MAILBOX2                 0x00000004U
+
 // CAN Filter Mode
 #define CAN_FILTERMODE_IDMASK       0x00000000U
 #define CAN_FILTERMODE_IDLIST       0x00000001U
@@ -72,6 +161,15 @@ typedef enum {
 #define CAN_FILTER_FIFO0           0x00000000U
 #define CAN_FILTER_FIFO1           0x00000001U
 
+// CAN Bit Timing
+#define CAN_BTR_BRP_Pos             0U
+#define CAN_BTR_BRP                 0x000003FFU
+#define CAN_BTR_TS1_Pos             16U
+#define CAN_BTR_TS2_Pos             20U
+#define CAN_BTR_LBKM                0x40000000U
+#define CAN_BTR_SILM                0x80000000U
+#define CAN_SJW_1TQ                 0x00000000U
+
 // CAN Error Codes
 #define HAL_CAN_ERROR_NONE            0x00000000U
 #define HAL_CAN_ERROR_EWG             0x00000001U
@@ -104,7 +202,7 @@ typedef struct {
     uint32_t IDE;
     uint32_t RTR;
     uint32_t DLC;
-    uint32_t TransmitGlobalTime;
+    FunctionalState TransmitGlobalTime;
 } CAN_TxHeaderTypeDef;
 
 typedef struct {
@@ -121,79 +219,228 @@ typedef struct {
 } CAN_FilterTypeDef;
 
 typedef struct {
-    void *Instance;
+    uint32_t Prescaler;
+    uint32_t Mode;
+    uint32_t SyncJumpWidth;
+    uint32_t TimeSeg1;
+    uint32_t TimeSeg2;
+    FunctionalState TimeTriggeredMode;
+} CAN_InitTypeDef;
+
+typedef struct {
+    CAN_TypeDef *Instance;
+    CAN_InitTypeDef Init;
     HAL_CAN_StateTypeDef State;
     uint32_t ErrorCode;
 } CAN_HandleTypeDef;
 
 // CAN Instances
-#define CAN1 ((void*)0x40006400U)
-#define CAN2 ((void*)0x40006800U)
+extern CAN_TypeDef Mock_CAN1, Mock_CAN2;
+#define CAN1 (&Mock_CAN1)
+#define CAN2 (&Mock_CAN2)
 
 // ==================== UART Definitions ====================
 
 typedef struct {
-    void *Instance;
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+    __IO uint32_t BRR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t CR3;
+} USART_TypeDef;
+
+#define UART_OVERSAMPLING_16            0x00000000U
+#define UART_OVERSAMPLING_8             0x00008000U
+
+#define HAL_UART_ERROR_NONE             0x00000000U
+#define HAL_UART_ERROR_PE               0x00000001U
+#define HAL_UART_ERROR_NE               0x00000002U
+#define HAL_UART_ERROR_FE               0x00000004U
+#define HAL_UART_ERROR_ORE              0x00000008U
+#define HAL_UART_ERROR_DMA              0x00000010U
+
+#define UART_BRR_SAMPLING16(_PCLK_, _BAUD_) ((uint32_t)(((_PCLK_) + ((_BAUD_) / 2U)) / (_BAUD_)))
+#define UART_BRR_SAMPLING8(_PCLK_, _BAUD_)  ((uint32_t)(((2U * (_PCLK_)) + ((_BAUD_) / 2U)) / (_BAUD_)))
+
+typedef struct {
+    uint32_t BaudRate;
+    uint32_t WordLength;
+    uint32_t StopBits;
+    uint32_t Parity;
+    uint32_t Mode;
+    uint32_t HwFlowCtl;
+    uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef struct {
+    USART_TypeDef *Instance;
+    UART_InitTypeDef Init;
+    DMA_HandleTypeDef *hdmarx;
+    DMA_HandleTypeDef *hdmatx;
     HAL_UART_StateTypeDef State;
+    HAL_UART_StateTypeDef gState;
+    HAL_UART_StateTypeDef RxState;
+    uint32_t ErrorCode;
 } UART_HandleTypeDef;
 
-#define USART1 ((void*)0x40011000U)
-#define USART2 ((void*)0x40004400U)
-#define USART3 ((void*)0x40004800U)
+extern USART_TypeDef Mock_USART1, Mock_USART2, Mock_USART3;
+#define USART1 (&Mock_USART1)
+#define USART2 (&Mock_USART2)
+#define USART3 (&Mock_USART3)
 
 // ==================== SPI Definitions ====================
 
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SR;
+    __IO uint32_t DR;
+} SPI_TypeDef;
+
 #define SPI_MODE_MASTER                 0x00000104U
 #define SPI_MODE_SLAVE                  0x00000000U
 
+#define SPI_CR1_CPHA                    0x00000001U
+#define SPI_CR1_CPOL                    0x00000002U
+#define SPI_CR1_BR_Pos                  3U
+#define SPI_CR1_BR                      (0x7U << SPI_CR1_BR_Pos)
+#define SPI_CR1_SPE                     0x00000040U
+
 typedef struct {
     uint32_t Mode;
+    uint32_t CLKPolarity;
+    uint32_t CLKPhase;
+    uint32_t BaudRatePrescaler;
 } SPI_InitTypeDef;
 
 // Forward declaration for self-referencing struct
 struct __SPI_HandleTypeDef;
 
 typedef struct __SPI_HandleTypeDef {
-    void *Instance;
+    SPI_TypeDef *Instance;
     SPI_InitTypeDef Init;
+    DMA_HandleTypeDef *hdmarx;
+    DMA_HandleTypeDef *hdmatx;
     HAL_SPI_StateTypeDef State;
     void (*RxCpltCallback)(struct __SPI_HandleTypeDef *hspi);
 } SPI_HandleTypeDef;
 
-#define SPI1 ((void*)0x40013000U)
-#define SPI2 ((void*)0x40003800U)
-#define SPI3 ((void*)0x40003C00U)
+extern SPI_TypeDef Mock_SPI1, Mock_SPI2, Mock_SPI3;
+#define SPI1 (&Mock_SPI1)
+#define SPI2 (&Mock_SPI2)
+#define SPI3 (&Mock_SPI3)
 
 // ==================== ADC Definitions ====================
 
 typedef struct {
-    void *Instance;
+    __IO uint32_t SR;
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t DR;
+} ADC_TypeDef;
+
+#define ADC_RESOLUTION_12B              0x00000000U
+#define ADC_RESOLUTION_10B              0x01000000U
+#define ADC_RESOLUTION_8B               0x02000000U
+#define ADC_RESOLUTION_6B               0x03000000U
+#define ADC_SOFTWARE_START              0x0F000001U
+#define ADC_EXTERNALTRIGCONVEDGE_NONE   0x00000000U
+#define ADC_EXTERNALTRIGCONVEDGE_RISING 0x10000000U
+
+typedef struct {
+    uint32_t Resolution;
+    uint32_t ScanConvMode;
+    uint32_t ContinuousConvMode;
+    uint32_t NbrOfConversion;
+    uint32_t ExternalTrigConv;
+    uint32_t ExternalTrigConvEdge;
+    FunctionalState DMAContinuousRequests;
+} ADC_InitTypeDef;
+
+typedef struct {
+    uint32_t Channel;
+    uint32_t Rank;
+    uint32_t SamplingTime;
+} ADC_ChannelConfTypeDef;
+
+typedef struct {
+    ADC_TypeDef *Instance;
+    ADC_InitTypeDef Init;
 } ADC_HandleTypeDef;
 
-#define ADC1 ((void*)0x40012000U)
-#define ADC2 ((void*)0x40012100U)
-#define ADC3 ((void*)0x40012200U)
+extern ADC_TypeDef Mock_ADC1, Mock_ADC2, Mock_ADC3;
+#define ADC1 (&Mock_ADC1)
+#define ADC2 (&Mock_ADC2)
+#define ADC3 (&Mock_ADC3)
 
 // ==================== TIM Definitions ====================
 
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t CR2;
+    __IO uint32_t SMCR;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CCMR1;
+    __IO uint32_t CCMR2;
+    __IO uint32_t CCER;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t RCR;
+    __IO uint32_t CCR1;
+    __IO uint32_t CCR2;
+    __IO uint32_t CCR3;
+    __IO uint32_t CCR4;
+    __IO uint32_t BDTR;
+    __IO uint32_t DCR;
+    __IO uint32_t DMAR;
+} TIM_TypeDef;
+
 #define TIM_CHANNEL_1                   0x00000000U
 #define TIM_CHANNEL_2                   0x00000004U
 #define TIM_CHANNEL_3                   0x00000008U
 #define TIM_CHANNEL_4                   0x0000000CU
 
+#define TIM_EVENTSOURCE_UPDATE          0x00000001U
+#define TIM_CR1_CEN                     0x00000001U
+#define TIM_CR1_UDIS                    0x00000002U
+#define TIM_CR2_MMS                     0x00000070U
+#define TIM_TRGO_UPDATE                 0x00000020U
+#define TIM_CCMR1_OC1PE                 0x00000008U
+#define TIM_CCMR1_OC2PE                 0x00000800U
+#define TIM_CCMR2_OC3PE                 0x00000008U
+#define TIM_CCMR2_OC4PE                 0x00000800U
+
+#define TIM_DMABASE_CCR1                0x0000000DU
+#define TIM_DMA_UPDATE                  0x00000100U
+#define TIM_DMA_ID_UPDATE               0U
+#define TIM_DMABURSTLENGTH_1TRANSFER    0x00000000U
+#define TIM_DMABURSTLENGTH_2TRANSFERS   0x00000100U
+#define TIM_DMABURSTLENGTH_3TRANSFERS   0x00000200U
+#define TIM_DMABURSTLENGTH_4TRANSFERS   0x00000300U
+
 typedef struct {
     uint32_t Prescaler;
+    uint32_t CounterMode;
     uint32_t Period;
 } TIM_Base_InitTypeDef;
 
 typedef struct {
-    void *Instance;
+    TIM_TypeDef *Instance;
     TIM_Base_InitTypeDef Init;
+    DMA_HandleTypeDef *hdma[7];
 } TIM_HandleTypeDef;
 
-#define TIM2 ((void*)0x40000000U)
-#define TIM3 ((void*)0x40000400U)
-#define TIM4 ((void*)0x40000800U)
+extern TIM_TypeDef Mock_TIM1, Mock_TIM2, Mock_TIM3, Mock_TIM4;
+#define TIM1 (&Mock_TIM1)
+#define TIM2 (&Mock_TIM2)
+#define TIM3 (&Mock_TIM3)
+#define TIM4 (&Mock_TIM4)
+
+#define IS_TIM_32B_COUNTER_INSTANCE(instance) ((instance) == TIM2)
 
 // ==================== DMA Definitions ====================
 
@@ -201,9 +448,11 @@ typedef struct {
 
 // ==================== Macro Helpers ====================
 
-#define __HAL_TIM_SET_PRESCALER(htim, prescaler) do { (htim)->Init.Prescaler = (prescaler); } while(0)
-#define __HAL_TIM_SET_AUTORELOAD(htim, period) do { (htim)->Init.Period = (period); } while(0)
-#define __HAL_TIM_SET_COMPARE(htim, channel, value) ((void)(htim), (void)(channel), (void)(value))
+#define __HAL_TIM_SET_PRESCALER(htim, prescaler) ((htim)->Instance->PSC = (prescaler))
+#define __HAL_TIM_SET_AUTORELOAD(htim, period) ((htim)->Instance->ARR = (period))
+#define __HAL_TIM_GET_AUTORELOAD(htim) ((htim)->Instance->ARR)
+#define __HAL_TIM_GET_COUNTER(htim) ((htim)->Instance->CNT)
+#define __HAL_TIM_SET_COMPARE(htim, channel, value) (*(&(htim)->Instance->CCR1 + ((channel) >> 2)) = (value))
 
 // ==================== Module Enable Defines ====================
 
@@ -212,13 +461,19 @@ typedef struct {
 #define HAL_SPI_MODULE_ENABLED
 #define HAL_ADC_MODULE_ENABLED
 #define HAL_TIM_MODULE_ENABLED
+#define HAL_DMA_MODULE_ENABLED
 
 // ==================== Mock Control Functions ====================
 
+#define MOCK_CAN_FIFO_DEPTH     64  ///< Frames a mock RX FIFO holds (the real bxCAN has 3)
+
 void Mock_HAL_Reset(void);
 void Mock_HAL_SetStatus(HAL_StatusTypeDef status);
 void Mock_HAL_SetTick(uint32_t tick);
 void Mock_CAN_SetRxMessage(uint32_t id, uint8_t *data, uint8_t dlc);
+int Mock_CAN_PushRxMessage(uint32_t fifo, uint32_t id, const uint8_t *data, uint8_t dlc);
+void Mock_CAN_SetFreeMailboxes(uint32_t count);
+uint8_t *Mock_UART_GetRxDmaBuffer(void);    ///< Ring of the last HAL_UARTEx_ReceiveToIdle_DMA call
 
 // ==================== HAL Function Declarations ====================
 
@@ -226,45 +481,86 @@ void Mock_CAN_SetRxMessage(uint32_t id, uint8_t *data, uint8_t dlc);
 void Error_Handler(void);
 uint32_t HAL_GetTick(void);
 
+// GPIO
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
 // CAN
 HAL_StatusTypeDef HAL_CAN_Start(CAN_HandleTypeDef *hcan);
 HAL_StatusTypeDef HAL_CAN_Stop(CAN_HandleTypeDef *hcan);
-HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, CAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_CAN_ConfigFilter(CAN_HandleTypeDef *hcan, const CAN_FilterTypeDef *sFilterConfig);
 HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan, uint32_t ActiveITs);
 HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan, uint32_t InactiveITs);
-HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, CAN_TxHeaderTypeDef *pHeader, uint8_t aData[], uint32_t *pTxMailbox);
+HAL_StatusTypeDef HAL_CAN_AddTxMessage(CAN_HandleTypeDef *hcan, const CAN_TxHeaderTypeDef *pHeader, const uint8_t aData[], uint32_t *pTxMailbox);
 HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t RxFifo, CAN_RxHeaderTypeDef *pHeader, uint8_t aData[]);
-uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t RxFifo);
+uint32_t HAL_CAN_GetRxFifoFillLevel(const CAN_HandleTypeDef *hcan, uint32_t RxFifo);
+uint32_t HAL_CAN_GetTxMailboxesFreeLevel(const CAN_HandleTypeDef *hcan);
+uint32_t HAL_CAN_GetTxTimestamp(const CAN_HandleTypeDef *hcan, uint32_t TxMailbox);
+HAL_CAN_StateTypeDef HAL_CAN_GetState(const CAN_HandleTypeDef *hcan);
 uint32_t HAL_CAN_GetError(CAN_HandleTypeDef *hcan);
 HAL_StatusTypeDef HAL_CAN_ResetError(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef *hcan);
 
 // UART
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
 HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
 HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size, uint32_t Timeout);
 HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
 HAL_StatusTypeDef HAL_UART_Receive_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
 HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+HAL_UART_StateTypeDef HAL_UART_GetState(const UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
 
 // SPI
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
 HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size, uint32_t Timeout);
 HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
 HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout);
 HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size);
 HAL_StatusTypeDef HAL_SPI_Receive_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
 HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Receive_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_IT(SPI_HandleTypeDef *hspi, const uint8_t *pTxData, uint8_t *pRxData, uint16_t Size);
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
 
 // ADC
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc);
 HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc);
 HAL_StatusTypeDef HAL_ADC_Stop(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Timeout);
 HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length);
 HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc);
-uint32_t HAL_ADC_GetValue(ADC_HandleTypeDef *hadc);
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, const ADC_ChannelConfTypeDef *sConfig);
+uint32_t HAL_ADC_GetValue(const ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc);
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc);
 
 // TIM
 HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
 HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim);
 HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel);
 HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_TIM_GenerateEvent(TIM_HandleTypeDef *htim, uint32_t EventSource);
+HAL_StatusTypeDef HAL_TIM_DMABurst_MultiWriteStart(TIM_HandleTypeDef *htim, uint32_t BurstBaseAddress,
+                                                   uint32_t BurstRequestSrc, const uint32_t *BurstBuffer,
+                                                   uint32_t BurstLength, uint32_t DataLength);
+HAL_StatusTypeDef HAL_TIM_DMABurst_WriteStop(TIM_HandleTypeDef *htim, uint32_t BurstRequestSrc);
 
 // RCC
 uint32_t HAL_RCC_GetPCLK1Freq(void);
@@ -0,0 +1,14 @@
+/**
+ * @file stm32f4xx_hal.h
+ * @brief Host stand-in for the F4 HAL header
+ *
+ * stm32_platform.h picks its HAL header from the device define; building
+ * with -DSTM32F407xx and tests/mocks on the include path lands here.
+ */
+
+#ifndef STM32F4XX_HAL_H
+#define STM32F4XX_HAL_H
+
+#include "stm32_hal_mocks.h"
+
+#endif // STM32F4XX_HAL_H
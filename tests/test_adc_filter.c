@@ -0,0 +1,132 @@
+#include "unity.h"
+#include "adc_filter.h"
+#include <string.h>
+
+static ADCFilter_t filter;
+static uint16_t samples[256];
+
+void setUp(void) {
+    memset(&filter, 0, sizeof(filter));
+    memset(samples, 0, sizeof(samples));
+}
+
+void tearDown(void) {
+    // Nothing to clean up
+}
+
+// ==================== Parameter Tests ====================
+
+void test_ADCFilterInit_BadArguments_AreRejected(void) {
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, ADCFilter_Init(NULL, ADCFILTER_IIR, 2, 0));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, ADCFilter_Init(&filter, ADCFILTER_MOVING_AVERAGE, 0, 0));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, ADCFilter_Init(&filter, ADCFILTER_MOVING_AVERAGE, ADCFILTER_MAX_WINDOW_SHIFT + 1, 0));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, ADCFilter_Init(&filter, ADCFILTER_CIC, 4, 0));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, ADCFilter_Init(&filter, ADCFILTER_CIC, 6, 3));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, ADCFilter_Init(&filter, ADCFILTER_IIR, ADCFILTER_MAX_IIR_SHIFT + 1, 0));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, ADCFilter_Init(&filter, (ADCFilterType_t)9, 1, 1));
+}
+
+// ==================== Kernel Tests ====================
+
+void test_ADCFilterNone_ReturnsNewestSample(void) {
+    const uint16_t block[] = {10, 20, 30};
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_NONE, 0, 0));
+    TEST_ASSERT_EQUAL(30, ADCFilter_Process(&filter, block, 3, 1));
+}
+
+void test_ADCFilterMovingAverage_MatchesWindowMean(void) {
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_MOVING_AVERAGE, 2, 0));
+
+    // Starts at the first sample instead of ramping from zero
+    const uint16_t first[] = {1000};
+    TEST_ASSERT_EQUAL(1000, ADCFilter_Process(&filter, first, 1, 1));
+
+    // Window of 4: after {100, 200, 300, 400} the mean is 250
+    const uint16_t block[] = {100, 200, 300, 400};
+    TEST_ASSERT_EQUAL(250, ADCFilter_Process(&filter, block, 4, 1));
+}
+
+void test_ADCFilterMovingAverage_StridedBlock_FiltersOneChannel(void) {
+    // Three interleaved channels; channel 1 carries the signal
+    for (uint16_t i = 0; i < 8; i++) {
+        samples[i * 3 + 0] = 4095;
+        samples[i * 3 + 1] = (uint16_t)(i * 10);
+        samples[i * 3 + 2] = 0;
+    }
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_MOVING_AVERAGE, 3, 0));
+
+    // Mean of 0, 10, ... 70 is 35
+    TEST_ASSERT_EQUAL(35, ADCFilter_Process(&filter, &samples[1], 8, 3));
+}
+
+void test_ADCFilterCic_FirstOrder_OutputsBlockMeans(void) {
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_CIC, 2, 1));
+
+    const uint16_t block[] = {1, 2, 3, 6, 10, 10, 10, 10};
+    TEST_ASSERT_EQUAL(3, ADCFilter_Process(&filter, block, 4, 1));
+    TEST_ASSERT_EQUAL(10, ADCFilter_Process(&filter, &block[4], 4, 1));
+}
+
+void test_ADCFilterCic_ThirdOrder_SettlesToConstantInput(void) {
+    for (size_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++) {
+        samples[i] = 4095;
+    }
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_CIC, 4, 3));
+
+    // Three outputs fill the comb stages, after that the gain is exactly 1
+    ADCFilter_Process(&filter, samples, 3 * 16, 1);
+    TEST_ASSERT_EQUAL(4095, ADCFilter_Process(&filter, samples, 16, 1));
+}
+
+void test_ADCFilterIir_StepResponse_ApproachesInput(void) {
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_IIR, 3, 0));
+    const uint16_t zero[] = {0};
+    ADCFilter_Process(&filter, zero, 1, 1);
+
+    for (size_t i = 0; i < 64; i++) {
+        samples[i] = 4000;
+    }
+    // One step of alpha = 1/8 moves an eighth of the way
+    TEST_ASSERT_EQUAL(500, ADCFilter_Process(&filter, samples, 1, 1));
+    uint16_t settled = ADCFilter_Process(&filter, samples, 64, 1);
+    TEST_ASSERT_TRUE(settled >= 3999 && settled <= 4000);
+}
+
+void test_ADCFilterIir_FullScaleInput_DoesNotOverflow(void) {
+    for (size_t i = 0; i < 64; i++) {
+        samples[i] = 0xFFFF;
+    }
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_IIR, 4, 0));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, ADCFilter_Process(&filter, samples, 64, 1));
+}
+
+void test_ADCFilterReset_ClearsHistory(void) {
+    const uint16_t high[] = {3000, 3000, 3000, 3000};
+    const uint16_t low[] = {200};
+    TEST_ASSERT_EQUAL(PLT_OK, ADCFilter_Init(&filter, ADCFILTER_MOVING_AVERAGE, 2, 0));
+    ADCFilter_Process(&filter, high, 4, 1);
+
+    ADCFilter_Reset(&filter);
+    TEST_ASSERT_EQUAL(200, ADCFilter_Process(&filter, low, 1, 1));
+}
+
+// ==================== Main ====================
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Parameter tests
+    RUN_TEST(test_ADCFilterInit_BadArguments_AreRejected);
+
+    // Kernel tests
+    RUN_TEST(test_ADCFilterNone_ReturnsNewestSample);
+    RUN_TEST(test_ADCFilterMovingAverage_MatchesWindowMean);
+    RUN_TEST(test_ADCFilterMovingAverage_StridedBlock_FiltersOneChannel);
+    RUN_TEST(test_ADCFilterCic_FirstOrder_OutputsBlockMeans);
+    RUN_TEST(test_ADCFilterCic_ThirdOrder_SettlesToConstantInput);
+    RUN_TEST(test_ADCFilterIir_StepResponse_ApproachesInput);
+    RUN_TEST(test_ADCFilterIir_FullScaleInput_DoesNotOverflow);
+    RUN_TEST(test_ADCFilterReset_ClearsHistory);
+
+    return UNITY_END();
+}
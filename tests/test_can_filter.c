@@ -0,0 +1,186 @@
+#include "unity.h"
+#include "can_filter.h"
+#include <string.h>
+
+static uint8_t routes[CANFILTER_BITMAP_BYTES];
+static CANFilterPlan_t plan;
+
+void setUp(void) {
+    memset(routes, 0, sizeof(routes));
+    memset(&plan, 0, sizeof(plan));
+}
+
+void tearDown(void) {
+    // Nothing to clean up
+}
+
+// Every routed ID must pass, and the plan must never exceed its banks
+static void assert_plan_covers_routes(uint8_t max_banks) {
+    TEST_ASSERT_TRUE(plan.bank_count <= max_banks);
+    for (uint16_t id = 0; id < CANFILTER_ID_SPACE; id++) {
+        if (CANFilter_BitmapTest(routes, id)) {
+            TEST_ASSERT_TRUE(CANFilter_Accepts(&plan, id));
+        }
+    }
+}
+
+// ==================== Parameter Tests ====================
+
+void test_CANFilterPlan_NullArguments_ReturnNullPointer(void) {
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, CANFilter_Plan(NULL, 14, &plan));
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, CANFilter_Plan(routes, 14, NULL));
+}
+
+void test_CANFilterPlan_BadBankCountOrNoRoutes_ReturnsInvalidParam(void) {
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANFilter_Plan(routes, 14, &plan));
+
+    CANFilter_BitmapSet(routes, 0x100);
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANFilter_Plan(routes, 0, &plan));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANFilter_Plan(routes, CANFILTER_MAX_BANKS + 1, &plan));
+}
+
+// ==================== Packing Tests ====================
+
+void test_CANFilterPlan_FewScatteredIDs_UseExactListBanks(void) {
+    const uint16_t ids[] = {0x010, 0x283, 0x555, 0x7FF, 0x123};
+    for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]); i++) {
+        CANFilter_BitmapSet(routes, ids[i]);
+    }
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_Plan(routes, 14, &plan));
+    TEST_ASSERT_EQUAL(2, plan.bank_count);
+    TEST_ASSERT_EQUAL(CANFILTER_LIST16, plan.banks[0].mode);
+    TEST_ASSERT_EQUAL(5, plan.routed_ids);
+    TEST_ASSERT_EQUAL(0, plan.extra_ids);
+    assert_plan_covers_routes(14);
+    TEST_ASSERT_FALSE(CANFilter_Accepts(&plan, 0x284));
+}
+
+void test_CANFilterPlan_AlignedRange_CollapsesToOneMask(void) {
+    for (uint16_t id = 0x180; id <= 0x19F; id++) {
+        CANFilter_BitmapSet(routes, id);
+    }
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_Plan(routes, 14, &plan));
+    TEST_ASSERT_EQUAL(1, plan.bank_count);
+    TEST_ASSERT_EQUAL(CANFILTER_MASK16, plan.banks[0].mode);
+    TEST_ASSERT_EQUAL_HEX16(0x180, plan.banks[0].id[0]);
+    TEST_ASSERT_EQUAL_HEX16(0x7E0, plan.banks[0].mask[0]);
+    TEST_ASSERT_EQUAL(0, plan.extra_ids);
+}
+
+void test_CANFilterPlan_DatabaseIDs_FitWithoutFalseAccepts(void) {
+    // 16 routed database IDs, 4 per list bank with room to spare
+    const uint16_t ids[] = {0x283, 0x285, 0x284, 0x286, 0x287, 0x289, 0x288, 0x290,
+                            0x180, 0x181, 0x182, 0x183, 0x191, 0x192, 0x193, 0x194};
+    for (size_t i = 0; i < sizeof(ids) / sizeof(ids[0]); i++) {
+        CANFilter_BitmapSet(routes, ids[i]);
+    }
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_Plan(routes, 14, &plan));
+    TEST_ASSERT_EQUAL(0, plan.extra_ids);
+    assert_plan_covers_routes(14);
+}
+
+void test_CANFilterPlan_TooManyIDs_MergesIntoAvailableBanks(void) {
+    // 100 scattered IDs cannot be listed exactly in 4 banks
+    for (uint16_t i = 0; i < 100; i++) {
+        CANFilter_BitmapSet(routes, (uint16_t)(i * 19 + 7));
+    }
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_Plan(routes, 4, &plan));
+    TEST_ASSERT_EQUAL(100, plan.routed_ids);
+    TEST_ASSERT_TRUE(plan.extra_ids > 0);
+    assert_plan_covers_routes(4);
+}
+
+void test_CANFilterPlan_OneBank_StillCoversEverything(void) {
+    CANFilter_BitmapSet(routes, 0x001);
+    CANFilter_BitmapSet(routes, 0x400);
+    CANFilter_BitmapSet(routes, 0x7FE);
+    CANFilter_BitmapSet(routes, 0x333);
+    CANFilter_BitmapSet(routes, 0x0F0);
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_Plan(routes, 1, &plan));
+    TEST_ASSERT_EQUAL(1, plan.bank_count);
+    assert_plan_covers_routes(1);
+}
+
+void test_CANFilterPlan_OddMaskBank_TakesExactIDInSpareSlot(void) {
+    for (uint16_t id = 0x200; id <= 0x20F; id++) {
+        CANFilter_BitmapSet(routes, id);
+    }
+    CANFilter_BitmapSet(routes, 0x555);
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_Plan(routes, 14, &plan));
+    TEST_ASSERT_EQUAL(1, plan.bank_count);
+    TEST_ASSERT_EQUAL(CANFILTER_MASK16, plan.banks[0].mode);
+    TEST_ASSERT_EQUAL_HEX16(0x555, plan.banks[0].id[1]);
+    TEST_ASSERT_EQUAL_HEX16(CANFILTER_EXACT_MASK, plan.banks[0].mask[1]);
+    TEST_ASSERT_EQUAL(0, plan.extra_ids);
+}
+
+// ==================== FIFO Tests ====================
+
+void test_CANFilterPlanFifo_FastIDs_GetTheirOwnFifo1Banks(void) {
+    uint8_t fast[CANFILTER_BITMAP_BYTES] = {0};
+    for (uint16_t id = 0x300; id <= 0x3FF; id++) {
+        CANFilter_BitmapSet(routes, id);
+    }
+    CANFilter_BitmapSet(routes, 0x010);
+    CANFilter_BitmapSet(routes, 0x020);
+    CANFilter_BitmapSet(fast, 0x010);
+    CANFilter_BitmapSet(fast, 0x020);
+    CANFilter_BitmapSet(fast, 0x030);   // Not routed: must not be planned
+
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_PlanFifo(routes, fast, 14, &plan));
+    TEST_ASSERT_EQUAL(2, plan.bank_count);
+    TEST_ASSERT_EQUAL(1, plan.banks[0].fifo);
+    TEST_ASSERT_EQUAL(CANFILTER_LIST16, plan.banks[0].mode);
+    TEST_ASSERT_EQUAL(0, plan.banks[1].fifo);
+    TEST_ASSERT_EQUAL(0, plan.extra_ids);
+    assert_plan_covers_routes(14);
+
+    // The FIFO1 bank accepts the fast IDs and nothing else
+    CANFilterPlan_t fifo1 = plan;
+    fifo1.bank_count = 1;
+    TEST_ASSERT_TRUE(CANFilter_Accepts(&fifo1, 0x010));
+    TEST_ASSERT_TRUE(CANFilter_Accepts(&fifo1, 0x020));
+    TEST_ASSERT_FALSE(CANFilter_Accepts(&fifo1, 0x030));
+    TEST_ASSERT_FALSE(CANFilter_Accepts(&fifo1, 0x300));
+}
+
+void test_CANFilterPlanFifo_OneBankForBothFifos_ReturnsInvalidParam(void) {
+    uint8_t fast[CANFILTER_BITMAP_BYTES] = {0};
+    CANFilter_BitmapSet(routes, 0x010);
+    CANFilter_BitmapSet(routes, 0x100);
+    CANFilter_BitmapSet(fast, 0x010);
+
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANFilter_PlanFifo(routes, fast, 1, &plan));
+    TEST_ASSERT_EQUAL(PLT_OK, CANFilter_PlanFifo(routes, fast, 2, &plan));
+    assert_plan_covers_routes(2);
+}
+
+// ==================== Main ====================
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Parameter tests
+    RUN_TEST(test_CANFilterPlan_NullArguments_ReturnNullPointer);
+    RUN_TEST(test_CANFilterPlan_BadBankCountOrNoRoutes_ReturnsInvalidParam);
+
+    // Packing tests
+    RUN_TEST(test_CANFilterPlan_FewScatteredIDs_UseExactListBanks);
+    RUN_TEST(test_CANFilterPlan_AlignedRange_CollapsesToOneMask);
+    RUN_TEST(test_CANFilterPlan_DatabaseIDs_FitWithoutFalseAccepts);
+    RUN_TEST(test_CANFilterPlan_TooManyIDs_MergesIntoAvailableBanks);
+    RUN_TEST(test_CANFilterPlan_OneBank_StillCoversEverything);
+    RUN_TEST(test_CANFilterPlan_OddMaskBank_TakesExactIDInSpareSlot);
+
+    // FIFO tests
+    RUN_TEST(test_CANFilterPlanFifo_FastIDs_GetTheirOwnFifo1Banks);
+    RUN_TEST(test_CANFilterPlanFifo_OneBankForBothFifos_ReturnsInvalidParam);
+
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+#include "unity.h"
+#include "can_trace.h"
+#include <string.h>
+
+static uint8_t buffer[64];
+static CANTraceFrame_t frame;
+
+void setUp(void) {
+    memset(buffer, 0xAA, sizeof(buffer));
+    memset(&frame, 0, sizeof(frame));
+}
+
+void tearDown(void) {
+    // Nothing to clean up
+}
+
+static CANTraceFrame_t make_frame(uint32_t delta_us, uint16_t id, uint8_t instance, uint8_t length) {
+    CANTraceFrame_t f = {.delta_us = delta_us, .id = id, .instance = instance, .length = length};
+    for (uint8_t i = 0; i < length; i++) {
+        f.data[i] = (uint8_t)(0x10 + i);
+    }
+    return f;
+}
+
+// ==================== Header Tests ====================
+
+void test_CANTraceHeader_WrittenHeader_Checks(void) {
+    TEST_ASSERT_EQUAL(CAN_TRACE_HEADER_SIZE, CANTrace_WriteHeader(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(PLT_OK, CANTrace_CheckHeader(buffer, CAN_TRACE_HEADER_SIZE));
+}
+
+void test_CANTraceHeader_BadInput_Rejected(void) {
+    TEST_ASSERT_EQUAL(0, CANTrace_WriteHeader(buffer, CAN_TRACE_HEADER_SIZE - 1));
+    CANTrace_WriteHeader(buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, CANTrace_CheckHeader(NULL, 8));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANTrace_CheckHeader(buffer, CAN_TRACE_HEADER_SIZE - 1));
+
+    buffer[4] = CAN_TRACE_VERSION + 1;
+    TEST_ASSERT_EQUAL(PLT_NOT_SUPPORTED, CANTrace_CheckHeader(buffer, CAN_TRACE_HEADER_SIZE));
+
+    buffer[0] = 'X';
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANTrace_CheckHeader(buffer, CAN_TRACE_HEADER_SIZE));
+}
+
+// ==================== Round-Trip Tests ====================
+
+void test_CANTraceEncode_FullFrame_RoundTrips(void) {
+    CANTraceFrame_t in = make_frame(1000, 0x7FF, 3, 8);
+
+    size_t n = CANTrace_Encode(&in, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(13, n);   // 3 + 2-byte delta + 8
+
+    size_t used = 0;
+    TEST_ASSERT_EQUAL(PLT_OK, CANTrace_Decode(buffer, n, &frame, &used));
+    TEST_ASSERT_EQUAL(n, used);
+    TEST_ASSERT_EQUAL_UINT32(1000, frame.delta_us);
+    TEST_ASSERT_EQUAL_HEX16(0x7FF, frame.id);
+    TEST_ASSERT_EQUAL(3, frame.instance);
+    TEST_ASSERT_EQUAL(8, frame.length);
+    TEST_ASSERT_EQUAL_MEMORY(in.data, frame.data, 8);
+}
+
+void test_CANTraceEncode_DeltaVarintBoundaries_RoundTrip(void) {
+    const uint32_t deltas[] = {0, 127, 128, 16383, 16384, 0xFFFFFFFFu};
+    const size_t sizes[] = {4, 4, 5, 5, 6, 8};
+
+    for (size_t i = 0; i < sizeof(deltas) / sizeof(deltas[0]); i++) {
+        CANTraceFrame_t in = make_frame(deltas[i], 0x123, 0, 0);
+        size_t n = CANTrace_Encode(&in, buffer, sizeof(buffer));
+        TEST_ASSERT_EQUAL(sizes[i], n);
+
+        size_t used = 0;
+        TEST_ASSERT_EQUAL(PLT_OK, CANTrace_Decode(buffer, n, &frame, &used));
+        TEST_ASSERT_EQUAL_UINT32(deltas[i], frame.delta_us);
+    }
+}
+
+void test_CANTraceDecode_Sequence_ConsumesEntriesInOrder(void) {
+    size_t pos = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        CANTraceFrame_t in = make_frame(i * 200u, (uint16_t)(0x100 + i), i, i);
+        pos += CANTrace_Encode(&in, &buffer[pos], sizeof(buffer) - pos);
+    }
+
+    size_t at = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        size_t used = 0;
+        TEST_ASSERT_EQUAL(PLT_OK, CANTrace_Decode(&buffer[at], pos - at, &frame, &used));
+        TEST_ASSERT_EQUAL_HEX16(0x100 + i, frame.id);
+        TEST_ASSERT_EQUAL(i, frame.instance);
+        TEST_ASSERT_EQUAL(i, frame.length);
+        at += used;
+    }
+    TEST_ASSERT_EQUAL(pos, at);
+}
+
+// ==================== Error Tests ====================
+
+void test_CANTraceEncode_InvalidFrameOrShortBuffer_ReturnsZero(void) {
+    CANTraceFrame_t in = make_frame(0, 0x800, 0, 0);
+    TEST_ASSERT_EQUAL(0, CANTrace_Encode(&in, buffer, sizeof(buffer)));
+
+    in = make_frame(0, 0x100, 0, 9);
+    TEST_ASSERT_EQUAL(0, CANTrace_Encode(&in, buffer, sizeof(buffer)));
+
+    in = make_frame(0, 0x100, CAN_TRACE_MAX_INSTANCE + 1, 0);
+    TEST_ASSERT_EQUAL(0, CANTrace_Encode(&in, buffer, sizeof(buffer)));
+
+    // Too small: nothing written
+    in = make_frame(0, 0x100, 0, 8);
+    TEST_ASSERT_EQUAL(0, CANTrace_Encode(&in, buffer, 11));
+    TEST_ASSERT_EQUAL_HEX8(0xAA, buffer[0]);
+}
+
+void test_CANTraceDecode_TruncatedEntry_ReturnsUnderflow(void) {
+    CANTraceFrame_t in = make_frame(300, 0x100, 0, 8);
+    size_t n = CANTrace_Encode(&in, buffer, sizeof(buffer));
+    size_t used = 0;
+
+    for (size_t cut = 0; cut < n; cut++) {
+        TEST_ASSERT_EQUAL(PLT_UNDERFLOW, CANTrace_Decode(buffer, cut, &frame, &used));
+    }
+}
+
+void test_CANTraceDecode_MalformedEntry_ReturnsInvalidParam(void) {
+    size_t used = 0;
+
+    const uint8_t reserved[] = {0x40, 0x00, 0x01, 0x00};
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANTrace_Decode(reserved, sizeof(reserved), &frame, &used));
+
+    const uint8_t dlc[] = {0x09, 0x00, 0x01, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANTrace_Decode(dlc, sizeof(dlc), &frame, &used));
+
+    const uint8_t id[] = {0x00, 0x00, 0x08, 0x00};
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANTrace_Decode(id, sizeof(id), &frame, &used));
+
+    const uint8_t varint[] = {0x00, 0x00, 0x01, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01};
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, CANTrace_Decode(varint, sizeof(varint), &frame, &used));
+
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, CANTrace_Decode(NULL, 4, &frame, &used));
+}
+
+// ==================== Main ====================
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Header tests
+    RUN_TEST(test_CANTraceHeader_WrittenHeader_Checks);
+    RUN_TEST(test_CANTraceHeader_BadInput_Rejected);
+
+    // Round-trip tests
+    RUN_TEST(test_CANTraceEncode_FullFrame_RoundTrips);
+    RUN_TEST(test_CANTraceEncode_DeltaVarintBoundaries_RoundTrip);
+    RUN_TEST(test_CANTraceDecode_Sequence_ConsumesEntriesInOrder);
+
+    // Error tests
+    RUN_TEST(test_CANTraceEncode_InvalidFrameOrShortBuffer_ReturnsZero);
+    RUN_TEST(test_CANTraceDecode_TruncatedEntry_ReturnsUnderflow);
+    RUN_TEST(test_CANTraceDecode_MalformedEntry_ReturnsInvalidParam);
+
+    return UNITY_END();
+}
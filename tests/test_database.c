@@ -1,5 +1,6 @@
 #include "unity.h"
 #include "database.h"
+#include "DbSetFunctions.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -31,8 +32,13 @@ void test_dbAllocateMemory_AllocatesAllNodes(void) {
     TEST_ASSERT_NOT_NULL(test_db->dashboard_node);
 }
 
+void test_dbAllocateMemory_AlignsBlock(void) {
+    TEST_ASSERT_EQUAL(0, (uintptr_t)test_db % _Alignof(database_block_t));
+    TEST_ASSERT_EQUAL(0, (uintptr_t)test_db % DB_ALIGN);
+}
+
 void test_dbAllocateMemory_InitializesToZero(void) {
-    // Check that all fields are zero-initialized (calloc behavior)
+    // Check that all fields are zero-initialized (db_Layout clears the block)
     TEST_ASSERT_EQUAL(0, test_db->pedal_node->gas_value);
     TEST_ASSERT_EQUAL(0, test_db->pedal_node->brake_value);
     TEST_ASSERT_EQUAL(0, test_db->vcu_node->SDC_state);
@@ -149,6 +155,211 @@ void test_Database_DashboardNode_CanStoreData(void) {
     TEST_ASSERT_EQUAL(1, test_db->dashboard_node->R2D);
 }
 
+// ==================== Layout Tests ====================
+
+void test_dbInitInRegion_PlacesAllNodesInRegion(void) {
+    static database_block_t region;
+    uint8_t *start = (uint8_t *)&region;
+    uint8_t *end = start + sizeof(region);
+
+    TEST_ASSERT_NULL(db_InitInRegion(&region, DB_REGION_SIZE - 1));
+    TEST_ASSERT_NULL(db_InitInRegion(start + 1, DB_REGION_SIZE));
+
+    memset(&region, 0xA5, sizeof(region));
+    database_t *db = db_InitInRegion(&region, sizeof(region));
+    TEST_ASSERT_EQUAL_PTR(&region, db);
+    TEST_ASSERT_EQUAL_PTR(db, db_GetDBPointer());
+    TEST_ASSERT_TRUE((uint8_t *)db->vcu_node >= start && (uint8_t *)(db->vcu_node + 1) <= end);
+    TEST_ASSERT_TRUE((uint8_t *)db->sub_node >= start && (uint8_t *)(db->sub_node + 1) <= end);
+    TEST_ASSERT_EQUAL(0, db->vcu_node->inverters[3].actual_speed);   // Region cleared
+
+    db_FreeMemory(db);  // Not heap: must be a no-op
+    TEST_ASSERT_EQUAL(0, db->pedal_node->gas_value);
+}
+
+void test_AMKStatus_BitPacked_MatchesMessageByte(void) {
+    AMK_Status_t status = {0};
+    status.AMK_bits = 0x81;
+
+    TEST_ASSERT_EQUAL(2, sizeof(AMK_Status_t));
+    TEST_ASSERT_EQUAL(1, status.AMK_bSystemReady);
+    TEST_ASSERT_EQUAL(1, status.AMK_bDerating);
+    TEST_ASSERT_EQUAL(0, status.AMK_bWarn);
+}
+
+// ==================== Snapshot Tests ====================
+
+void test_dbReadInverter_NoWriter_CopiesNode(void) {
+    inverter_t copy;
+    test_db->vcu_node->inverters[2].actual_speed = 4200;
+    test_db->vcu_node->inverters[2].igbt_temperature = 410;
+
+    TEST_ASSERT_TRUE(db_ReadInverter(test_db, 2, &copy));
+    TEST_ASSERT_EQUAL(4200, copy.actual_speed);
+    TEST_ASSERT_EQUAL(410, copy.igbt_temperature);
+    TEST_ASSERT_FALSE(db_ReadInverter(test_db, 4, &copy));
+}
+
+void test_dbReadPedal_WriterInside_FailsUntilPublished(void) {
+    pedal_node_t copy;
+
+    db_WriteBegin(test_db, DB_NODE_PEDAL);
+    test_db->pedal_node->gas_value = 80;
+    TEST_ASSERT_FALSE(db_ReadPedal(test_db, &copy));
+
+    // Other nodes stay readable during the update
+    sub_node_t sub;
+    TEST_ASSERT_TRUE(db_ReadSub(test_db, &sub));
+
+    db_WriteEnd(test_db, DB_NODE_PEDAL);
+    TEST_ASSERT_TRUE(db_ReadPedal(test_db, &copy));
+    TEST_ASSERT_EQUAL(80, copy.gas_value);
+    TEST_ASSERT_EQUAL(0, test_db->seq[DB_NODE_PEDAL] & 1u);
+}
+
+void test_setInvAv1Parameters_PublishesCompleteUpdate(void) {
+    database_t *db = db_Init();
+    uint8_t data[8] = {0, 0x51, 0x10, 0x27, 0x05, 0x00, 0xFB, 0xFF};
+    inverter_t copy;
+
+    setInv2Av1Parameters(data);
+
+    TEST_ASSERT_TRUE(db_ReadInverter(db, 1, &copy));
+    TEST_ASSERT_EQUAL(1, copy.AMK_Status.AMK_bSystemReady);
+    TEST_ASSERT_EQUAL(1, copy.AMK_Status.AMK_bDcOn);
+    TEST_ASSERT_EQUAL(1, copy.AMK_Status.AMK_bInverterOn);
+    TEST_ASSERT_EQUAL(0, copy.AMK_Status.AMK_bError);
+    TEST_ASSERT_EQUAL(10000, copy.actual_speed);
+    TEST_ASSERT_EQUAL(5, copy.torque_current);
+    TEST_ASSERT_EQUAL(-5, copy.magnetizing_current);
+    TEST_ASSERT_EQUAL(2, db->seq[DB_NODE_INV2]);
+
+    db_FreeMemory(db);
+}
+
+// ==================== Decoder Tests ====================
+
+void test_setPedalParameters_OutOfRange_ClampsAndSignExtends(void) {
+    database_t *db = db_Init();
+    uint8_t data[8] = {0x2C, 0x01, 0x32, 0x00, 0x38, 0xFF, 0x00, 0x00};
+
+    setPedalParameters(data);
+
+    TEST_ASSERT_EQUAL(100, db->pedal_node->gas_value);
+    TEST_ASSERT_EQUAL(50, db->pedal_node->brake_value);
+    TEST_ASSERT_EQUAL(-100, db->pedal_node->steering_wheel_angle);
+    TEST_ASSERT_EQUAL(0, db->pedal_node->BIOPS);
+    TEST_ASSERT_EQUAL(1, db->vcu_node->keep_alive[PEDALNODE]);
+
+    db_FreeMemory(db);
+}
+
+void test_setInvAv2Parameters_WritesInverterAndErrorGroup(void) {
+    database_t *db = db_Init();
+    uint8_t data[8] = {0x5A, 0x00, 0xF6, 0xFF, 0x34, 0x12, 0, 0};
+
+    setInv3Av2Parameters(data);
+
+    TEST_ASSERT_EQUAL(90, db->vcu_node->inverters[2].motor_temperature);
+    TEST_ASSERT_EQUAL(-10, db->vcu_node->inverters[2].plate_temperature);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, db->vcu_node->error_group.inv3_error);
+    TEST_ASSERT_EQUAL(2, db->seq[DB_NODE_INV3]);
+    TEST_ASSERT_EQUAL(2, db->seq[DB_NODE_VCU]);
+
+    db_FreeMemory(db);
+}
+
+void test_setDBParameters_R2D_LatchesOnceSet(void) {
+    database_t *db = db_Init();
+    uint8_t on[8] = {0, 0, 1, 0, 0, 0, 0, 0};
+    uint8_t off[8] = {0};
+
+    setDBParameters(off);
+    TEST_ASSERT_EQUAL(0, db->dashboard_node->R2D);
+    setDBParameters(on);
+    setDBParameters(off);
+    TEST_ASSERT_EQUAL(1, db->dashboard_node->R2D);
+
+    db_FreeMemory(db);
+}
+
+void test_dbDecodeFrame_UnalignedSignedSignal_Decodes(void) {
+    static const db_signal_t rows[] = {
+        DB_SIG(pedal_node_t, steering_wheel_angle, 4, 12, DB_SIG_SIGNED, DB_UNIT_MESSAGE, 0, 0),
+        DB_SIG(pedal_node_t, gas_value, 16, 4, 0, DB_UNIT_MESSAGE, 0, 0),
+    };
+    static const db_message_t msg = {rows, 2, DB_NODE_PEDAL, DB_NO_ALIVE};
+    uint8_t data[8] = {0x30, 0xFE, 0xA7, 0, 0, 0, 0, 0};
+
+    db_DecodeFrame(test_db, &msg, data);
+
+    TEST_ASSERT_EQUAL(-29, test_db->pedal_node->steering_wheel_angle);
+    TEST_ASSERT_EQUAL(7, test_db->pedal_node->gas_value);
+    TEST_ASSERT_EQUAL(2, test_db->seq[DB_NODE_PEDAL]);
+}
+
+// ==================== Change Detection Tests ====================
+
+static uint32_t notified_bits;
+static int notify_count;
+
+static void on_inverters(database_t *db, uint32_t changed) {
+    (void)db;
+    notified_bits |= changed;
+    notify_count++;
+}
+
+void test_dbTakeDirty_RepeatedFrame_OnlyFirstMarksChange(void) {
+    database_t *db = db_Init();
+    uint8_t data[8] = {0, 0x51, 0x10, 0x27, 0x05, 0x00, 0xFB, 0xFF};
+
+    setInv1Av1Parameters(data);
+    TEST_ASSERT_EQUAL_HEX32(DB_DIRTY(DB_NODE_INV1) | DB_DIRTY_ALIVE, db_TakeDirty(db, DB_DIRTY_ALL));
+    TEST_ASSERT_EQUAL_HEX32(0, db_TakeDirty(db, DB_DIRTY_ALL));
+
+    setInv1Av1Parameters(data);
+    TEST_ASSERT_EQUAL_HEX32(0, db_TakeDirty(db, DB_DIRTY_ALL));
+
+    data[2] = 0x11;
+    setInv1Av1Parameters(data);
+    TEST_ASSERT_EQUAL_HEX32(0, db_TakeDirty(db, DB_DIRTY(DB_NODE_PEDAL)));
+    TEST_ASSERT_EQUAL_HEX32(DB_DIRTY(DB_NODE_INV1), db_TakeDirty(db, DB_DIRTY_INVERTERS));
+
+    db_FreeMemory(db);
+}
+
+void test_dbSubscribe_GroupCallback_RunsOnlyForItsGroup(void) {
+    database_t *db = db_Init();
+    uint8_t pedal[8] = {10, 0, 0, 0, 0, 0, 0, 0};
+    uint8_t av2[8] = {0x5A, 0x00, 0, 0, 0x01, 0x00, 0, 0};
+    notified_bits = 0;
+    notify_count = 0;
+
+    TEST_ASSERT_TRUE(db_Subscribe(db, DB_DIRTY_INVERTERS, on_inverters));
+    TEST_ASSERT_FALSE(db_Subscribe(db, 0, on_inverters));
+
+    setPedalParameters(pedal);
+    TEST_ASSERT_EQUAL(0, notify_count);
+
+    setInv4Av2Parameters(av2);
+    TEST_ASSERT_EQUAL(1, notify_count);
+    TEST_ASSERT_EQUAL_HEX32(DB_DIRTY(DB_NODE_INV4), notified_bits);
+
+    // Callbacks leave the flags for the polling consumer
+    TEST_ASSERT_EQUAL_HEX32(DB_DIRTY(DB_NODE_PEDAL) | DB_DIRTY(DB_NODE_INV4) | DB_DIRTY(DB_NODE_VCU) | DB_DIRTY_ALIVE,
+                            db_TakeDirty(db, DB_DIRTY_ALL));
+
+    db_FreeMemory(db);
+}
+
+void test_dbWriteEnd_DirectUpdate_MarksNodeDirty(void) {
+    db_WriteBegin(test_db, DB_NODE_SUB);
+    test_db->sub_node->water_temp = 60;
+    db_WriteEnd(test_db, DB_NODE_SUB);
+
+    TEST_ASSERT_EQUAL_HEX32(DB_DIRTY(DB_NODE_SUB), db_TakeDirty(test_db, DB_DIRTY_ALL));
+}
+
 // ==================== Main ====================
 
 int main(void) {
@@ -156,6 +367,7 @@ int main(void) {
     
     // Allocation tests
     RUN_TEST(test_dbAllocateMemory_Success_ReturnsValidPointer);
+    RUN_TEST(test_dbAllocateMemory_AlignsBlock);
     RUN_TEST(test_dbAllocateMemory_AllocatesAllNodes);
     RUN_TEST(test_dbAllocateMemory_InitializesToZero);
     
@@ -175,5 +387,25 @@ int main(void) {
     RUN_TEST(test_Database_SubNode_CanStoreData);
     RUN_TEST(test_Database_DashboardNode_CanStoreData);
     
+    // Layout tests
+    RUN_TEST(test_dbInitInRegion_PlacesAllNodesInRegion);
+    RUN_TEST(test_AMKStatus_BitPacked_MatchesMessageByte);
+    
+    // Snapshot tests
+    RUN_TEST(test_dbReadInverter_NoWriter_CopiesNode);
+    RUN_TEST(test_dbReadPedal_WriterInside_FailsUntilPublished);
+    RUN_TEST(test_setInvAv1Parameters_PublishesCompleteUpdate);
+    
+    // Decoder tests
+    RUN_TEST(test_setPedalParameters_OutOfRange_ClampsAndSignExtends);
+    RUN_TEST(test_setInvAv2Parameters_WritesInverterAndErrorGroup);
+    RUN_TEST(test_setDBParameters_R2D_LatchesOnceSet);
+    RUN_TEST(test_dbDecodeFrame_UnalignedSignedSignal_Decodes);
+    
+    // Change detection tests
+    RUN_TEST(test_dbTakeDirty_RepeatedFrame_OnlyFirstMarksChange);
+    RUN_TEST(test_dbSubscribe_GroupCallback_RunsOnlyForItsGroup);
+    RUN_TEST(test_dbWriteEnd_DirectUpdate_MarksNodeDirty);
+    
     return UNITY_END();
 }
@@ -1,5 +1,6 @@
 #include "unity.h"
 #include "hashtable.h"
+#include "database.h"
 #include <string.h>
 
 // Mock set functions for testing
@@ -19,6 +20,7 @@ void mock_set_function_2(uint8_t *data) {
 void setUp(void) {
     // Initialize hash table before each test
     hash_Init();
+    direct_Init();
     mock_function_called = 0;
     memset(mock_function_data, 0, sizeof(mock_function_data));
 }
@@ -232,6 +234,221 @@ void test_HashTable_FullTable_ReturnsHashFull(void) {
     TEST_ASSERT_GREATER_THAN(100, inserted_count);
 }
 
+// ==================== Direct-Indexed Backend Tests ====================
+
+void test_directLookup_RoutedAndUnroutedIDs(void) {
+    hash_member_t member = {
+        .id = 0x283,
+        .Set_Function = mock_set_function_1
+    };
+    TEST_ASSERT_EQUAL(HASH_OK, direct_InsertMember(&member));
+    
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, direct_Lookup(0x283));
+    TEST_ASSERT_NULL(direct_Lookup(0x284));
+    TEST_ASSERT_NULL(direct_Lookup(0x7FF));
+    TEST_ASSERT_NULL(direct_Lookup(HASH_EMPTY_ID));
+}
+
+void test_directInsertMember_RejectsDuplicateAndExtendedIDs(void) {
+    hash_member_t member = {
+        .id = 0x100,
+        .Set_Function = mock_set_function_1
+    };
+    TEST_ASSERT_EQUAL(HASH_OK, direct_InsertMember(&member));
+    TEST_ASSERT_EQUAL(HASH_ERROR, direct_InsertMember(&member));
+    
+    member.id = DIRECT_ID_SPACE;
+    TEST_ASSERT_EQUAL(HASH_ERROR, direct_InsertMember(&member));
+}
+
+void test_directInsertMember_WholeIDSpaceWithSharedHandler(void) {
+    // routeRange over the full 11-bit space needs only one handler slot
+    for (uint32_t id = 0; id < DIRECT_ID_SPACE; id++) {
+        hash_member_t member = {
+            .id = id,
+            .Set_Function = (id & 1) ? mock_set_function_2 : mock_set_function_1
+        };
+        TEST_ASSERT_EQUAL(HASH_OK, direct_InsertMember(&member));
+    }
+    
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, direct_Lookup(0x000));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_2, direct_Lookup(0x7FF));
+}
+
+void test_directDeleteMember_ThenReinsertWithOtherHandler(void) {
+    hash_member_t member = {
+        .id = 0x321,
+        .Set_Function = mock_set_function_1
+    };
+    direct_InsertMember(&member);
+    direct_DeleteMember(0x321);
+    TEST_ASSERT_NULL(direct_Lookup(0x321));
+    
+    member.Set_Function = mock_set_function_2;
+    TEST_ASSERT_EQUAL(HASH_OK, direct_InsertMember(&member));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_2, direct_Lookup(0x321));
+}
+
+// ==================== Generated Table Tests ====================
+
+void test_hashSetTable_InsertsEveryDatabaseRoute(void) {
+    TEST_ASSERT_EQUAL(HASH_OK, hash_SetTable());
+    
+    TEST_ASSERT_EQUAL_PTR(setInv1Av1Parameters, hash_Lookup(INV1_AV1_ID));
+    TEST_ASSERT_EQUAL_PTR(setStage3Parameters, hash_Lookup(STAGE_3_ID));
+    TEST_ASSERT_EQUAL_PTR(setDBParameters, hash_Lookup(DB_ID));
+}
+
+void test_staticLookup_MatchesRouteTable(void) {
+#define CHECK_ROUTE(msg_id, fn) TEST_ASSERT_EQUAL_PTR(fn, static_Lookup(msg_id));
+    DB_CAN_ROUTE_TABLE(CHECK_ROUTE)
+#undef CHECK_ROUTE
+    
+    TEST_ASSERT_NULL(static_Lookup(SUB_ID));       // Listed in database.h but not routed
+    TEST_ASSERT_NULL(static_Lookup(0x7FF));
+    TEST_ASSERT_NULL(static_Lookup(HASH_EMPTY_ID));
+}
+
+void test_staticInsertMember_OnlyAcceptsExistingRoutes(void) {
+    hash_member_t member = {
+        .id = BMS_ID,
+        .Set_Function = setBmsParameters
+    };
+    TEST_ASSERT_EQUAL(HASH_OK, static_InsertMember(&member));
+    
+    member.Set_Function = mock_set_function_1;
+    TEST_ASSERT_EQUAL(HASH_ERROR, static_InsertMember(&member));
+    TEST_ASSERT_EQUAL_PTR(setBmsParameters, static_Lookup(BMS_ID));
+}
+
+// ==================== Table Object Tests ====================
+
+void test_hashTableInit_NonPowerOfTwo_ReturnsError(void) {
+    hash_table_t table;
+    hash_member_t storage[24];
+    
+    TEST_ASSERT_EQUAL(HASH_ERROR, hash_TableInit(&table, storage, 24));
+    TEST_ASSERT_EQUAL(HASH_ERROR, hash_TableInit(&table, storage, 0));
+    TEST_ASSERT_EQUAL(HASH_OK, hash_TableInit(&table, storage, 16));
+}
+
+void test_hashTable_SameIDInTwoTables_KeepsSeparateHandlers(void) {
+    hash_table_t bus1, bus2;
+    hash_member_t storage1[16], storage2[8];
+    hash_TableInit(&bus1, storage1, 16);
+    hash_TableInit(&bus2, storage2, 8);
+    
+    hash_member_t member = { .id = 0x283, .Set_Function = mock_set_function_1 };
+    TEST_ASSERT_EQUAL(HASH_OK, hash_TableInsert(&bus1, &member));
+    member.Set_Function = mock_set_function_2;
+    TEST_ASSERT_EQUAL(HASH_OK, hash_TableInsert(&bus2, &member));
+    
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, hash_TableLookup(&bus1, 0x283));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_2, hash_TableLookup(&bus2, 0x283));
+    TEST_ASSERT_NULL(hash_Lookup(0x283));          // Default table untouched
+}
+
+void test_hashTable_SmallTable_FullAtItsOwnSize(void) {
+    hash_table_t table;
+    hash_member_t storage[8];
+    hash_TableInit(&table, storage, 8);
+    
+    for (uint32_t i = 0; i < 8; i++) {
+        hash_member_t member = { .id = 0x400 + i, .Set_Function = mock_set_function_1 };
+        TEST_ASSERT_EQUAL(HASH_OK, hash_TableInsert(&table, &member));
+    }
+    
+    hash_member_t extra = { .id = 0x500, .Set_Function = mock_set_function_1 };
+    TEST_ASSERT_EQUAL(HASH_FULL, hash_TableInsert(&table, &extra));
+    TEST_ASSERT_NOT_NULL(hash_TableLookup(&table, 0x407));
+}
+
+void test_directTable_SameIDInTwoTables_KeepsSeparateHandlers(void) {
+    static direct_table_t bus1, bus2;
+    direct_TableInit(&bus1);
+    direct_TableInit(&bus2);
+    
+    hash_member_t member = { .id = 0x123, .Set_Function = mock_set_function_1 };
+    direct_TableInsert(&bus1, &member);
+    member.Set_Function = mock_set_function_2;
+    direct_TableInsert(&bus2, &member);
+    
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, direct_TableLookup(&bus1, 0x123));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_2, direct_TableLookup(&bus2, 0x123));
+}
+
+// ==================== Range Route Tests ====================
+
+void test_rangeTable_LookupHonoursInclusiveBounds(void) {
+    range_table_t table;
+    hash_range_t storage[4];
+    range_TableInit(&table, storage, 4);
+    
+    // A 256-ID block costs one entry
+    TEST_ASSERT_EQUAL(HASH_OK, range_TableInsert(&table, 0x200, 0x2FF, mock_set_function_1));
+    TEST_ASSERT_EQUAL(1, table.count);
+    
+    TEST_ASSERT_NULL(range_TableLookup(&table, 0x1FF));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, range_TableLookup(&table, 0x200));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, range_TableLookup(&table, 0x2FF));
+    TEST_ASSERT_NULL(range_TableLookup(&table, 0x300));
+}
+
+void test_rangeTable_OverlapAndInvertedRange_ReturnError(void) {
+    range_table_t table;
+    hash_range_t storage[4];
+    range_TableInit(&table, storage, 4);
+    
+    range_TableInsert(&table, 0x100, 0x1FF, mock_set_function_1);
+    TEST_ASSERT_EQUAL(HASH_ERROR, range_TableInsert(&table, 0x1FF, 0x210, mock_set_function_2));
+    TEST_ASSERT_EQUAL(HASH_ERROR, range_TableInsert(&table, 0x080, 0x100, mock_set_function_2));
+    TEST_ASSERT_EQUAL(HASH_ERROR, range_TableInsert(&table, 0x300, 0x2FF, mock_set_function_2));
+    TEST_ASSERT_EQUAL(HASH_OK, range_TableInsert(&table, 0x200, 0x210, mock_set_function_2));
+}
+
+void test_rangeTable_Full_ReturnsHashFull(void) {
+    range_table_t table;
+    hash_range_t storage[2];
+    range_TableInit(&table, storage, 2);
+    
+    range_TableInsert(&table, 0x000, 0x0FF, mock_set_function_1);
+    range_TableInsert(&table, 0x100, 0x1FF, mock_set_function_1);
+    TEST_ASSERT_EQUAL(HASH_FULL, range_TableInsert(&table, 0x200, 0x2FF, mock_set_function_1));
+}
+
+void test_rangeTable_OutOfOrderInserts_StaySortedForSearch(void) {
+    range_table_t table;
+    hash_range_t storage[8];
+    range_TableInit(&table, storage, 8);
+    
+    const uint16_t starts[] = {0x600, 0x100, 0x400, 0x000, 0x700, 0x300};
+    for (int i = 0; i < 6; i++) {
+        Set_Function_t fn = (starts[i] & 0x100) ? mock_set_function_2 : mock_set_function_1;
+        TEST_ASSERT_EQUAL(HASH_OK, range_TableInsert(&table, starts[i], starts[i] + 0x7F, fn));
+    }
+    
+    for (int i = 1; i < table.count; i++) {
+        TEST_ASSERT_TRUE(storage[i - 1].start < storage[i].start);
+    }
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_2, range_TableLookup(&table, 0x37F));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_1, range_TableLookup(&table, 0x612));
+    TEST_ASSERT_NULL(range_TableLookup(&table, 0x680));
+}
+
+void test_rangeTable_Delete_RemovesOnlyThatRange(void) {
+    range_table_t table;
+    hash_range_t storage[4];
+    range_TableInit(&table, storage, 4);
+    
+    range_TableInsert(&table, 0x100, 0x1FF, mock_set_function_1);
+    range_TableInsert(&table, 0x200, 0x2FF, mock_set_function_2);
+    range_TableDelete(&table, 0x100);
+    range_TableDelete(&table, 0x250);              // Not a range start - ignored
+    
+    TEST_ASSERT_NULL(range_TableLookup(&table, 0x150));
+    TEST_ASSERT_EQUAL_PTR(mock_set_function_2, range_TableLookup(&table, 0x250));
+}
+
 // ==================== Main ====================
 
 int main(void) {
@@ -263,5 +480,29 @@ int main(void) {
     RUN_TEST(test_HashTable_CollisionHandling_LinearProbing);
     RUN_TEST(test_HashTable_FullTable_ReturnsHashFull);
     
+    // Direct-indexed backend tests
+    RUN_TEST(test_directLookup_RoutedAndUnroutedIDs);
+    RUN_TEST(test_directInsertMember_RejectsDuplicateAndExtendedIDs);
+    RUN_TEST(test_directInsertMember_WholeIDSpaceWithSharedHandler);
+    RUN_TEST(test_directDeleteMember_ThenReinsertWithOtherHandler);
+    
+    // Generated table tests
+    RUN_TEST(test_hashSetTable_InsertsEveryDatabaseRoute);
+    RUN_TEST(test_staticLookup_MatchesRouteTable);
+    RUN_TEST(test_staticInsertMember_OnlyAcceptsExistingRoutes);
+    
+    // Table object tests
+    RUN_TEST(test_hashTableInit_NonPowerOfTwo_ReturnsError);
+    RUN_TEST(test_hashTable_SameIDInTwoTables_KeepsSeparateHandlers);
+    RUN_TEST(test_hashTable_SmallTable_FullAtItsOwnSize);
+    RUN_TEST(test_directTable_SameIDInTwoTables_KeepsSeparateHandlers);
+    
+    // Range route tests
+    RUN_TEST(test_rangeTable_LookupHonoursInclusiveBounds);
+    RUN_TEST(test_rangeTable_OverlapAndInvertedRange_ReturnError);
+    RUN_TEST(test_rangeTable_Full_ReturnsHashFull);
+    RUN_TEST(test_rangeTable_OutOfOrderInserts_StaySortedForSearch);
+    RUN_TEST(test_rangeTable_Delete_RemovesOnlyThatRange);
+    
     return UNITY_END();
 }
@@ -0,0 +1,101 @@
+#include "unity.h"
+#include "stats.h"
+#include "utils.h"
+#include <string.h>
+
+// Built with PLT_ENABLE_STATS=1 (see tests/CMakeLists.txt)
+
+static StatsTimings_t timings;
+
+void setUp(void) {
+    Stats_Reset(&timings);
+    Stats_Reset(&Stats_timings);
+}
+
+void tearDown(void) {
+    // Nothing to clean up
+}
+
+// ==================== Counter Tests ====================
+
+void test_StatsRecord_TracksMinMaxAverage(void) {
+    StatsCounter_t* c = &timings.point[STATS_CAN_DISPATCH];
+
+    TEST_ASSERT_EQUAL(0, Stats_Average(c));
+    Stats_Record(c, 120);
+    Stats_Record(c, 80);
+    Stats_Record(c, 160);
+
+    TEST_ASSERT_EQUAL(3, c->count);
+    TEST_ASSERT_EQUAL(80, c->min);
+    TEST_ASSERT_EQUAL(160, c->max);
+    TEST_ASSERT_EQUAL(120, Stats_Average(c));
+}
+
+void test_StatsRecordRoute_TableFull_CountsOverflow(void) {
+    for (uint16_t id = 0; id < STATS_MAX_ROUTES; id++) {
+        Stats_RecordRoute(&timings, (uint16_t)(0x100 + id), id);
+    }
+    Stats_RecordRoute(&timings, 0x100, 50);
+    Stats_RecordRoute(&timings, 0x7FF, 10);
+
+    TEST_ASSERT_EQUAL(STATS_MAX_ROUTES, timings.route_count);
+    TEST_ASSERT_EQUAL_HEX16(0x100, timings.route[0].id);
+    TEST_ASSERT_EQUAL(2, timings.route[0].cycles.count);
+    TEST_ASSERT_EQUAL(50, timings.route[0].cycles.max);
+    TEST_ASSERT_EQUAL(1, timings.route_overflow);
+}
+
+// ==================== Queue Tests ====================
+
+void test_QueueStats_HighWaterAndDrops(void) {
+    uint32_t storage[4];
+    uint32_t value = 7;
+    Queue_t queue;
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_InitStatic(&queue, storage, sizeof(uint32_t), 4, QUEUE_MODE_SPSC));
+
+    for (int i = 0; i < 6; i++) {
+        Queue_Push(&queue, &value);
+    }
+    Queue_Pop(&queue, &value);
+    Queue_Pop(&queue, &value);
+    Queue_Push(&queue, &value);
+
+    TEST_ASSERT_EQUAL(4, queue.high_water);
+    TEST_ASSERT_EQUAL(2, queue.drops);
+    TEST_ASSERT_EQUAL(7, Stats_timings.point[STATS_QUEUE_PUSH].count);
+    TEST_ASSERT_EQUAL(2, Stats_timings.point[STATS_QUEUE_POP].count);
+}
+
+void test_QueueStats_ReserveOnFullQueue_CountsDrop(void) {
+    uint8_t storage[2];
+    Queue_t queue;
+    Queue_InitStatic(&queue, storage, sizeof(uint8_t), 2, QUEUE_MODE_LOCKED);
+
+    for (int i = 0; i < 3; i++) {
+        uint8_t* slot = (uint8_t*)Queue_Reserve(&queue);
+        if (slot != NULL) {
+            *slot = (uint8_t)i;
+            Queue_Commit(&queue);
+        }
+    }
+
+    TEST_ASSERT_EQUAL(2, queue.high_water);
+    TEST_ASSERT_EQUAL(1, queue.drops);
+}
+
+// ==================== Main ====================
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // Counter tests
+    RUN_TEST(test_StatsRecord_TracksMinMaxAverage);
+    RUN_TEST(test_StatsRecordRoute_TableFull_CountsOverflow);
+
+    // Queue tests
+    RUN_TEST(test_QueueStats_HighWaterAndDrops);
+    RUN_TEST(test_QueueStats_ReserveOnFullQueue_CountsDrop);
+
+    return UNITY_END();
+}
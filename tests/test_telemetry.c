@@ -0,0 +1,123 @@
+#include "unity.h"
+#include "telemetry.h"
+#include <string.h>
+
+static uint8_t frame[TELEMETRY_FRAME_SIZE(TELEMETRY_MAX_PAYLOAD)];
+static TelemetryRecord_t record;
+
+void setUp(void) {
+    memset(frame, 0xAA, sizeof(frame));
+    memset(&record, 0, sizeof(record));
+}
+
+void tearDown(void) {
+    // Nothing to clean up
+}
+
+// The delimiter may only appear as the last byte
+static void assert_single_delimiter(size_t length) {
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRY_DELIMITER, frame[length - 1]);
+    for (size_t i = 0; i + 1 < length; i++) {
+        TEST_ASSERT_NOT_EQUAL(0, frame[i]);
+    }
+}
+
+// ==================== CRC Tests ====================
+
+void test_TelemetryCrc16_CheckValue_MatchesCcittFalse(void) {
+    const uint8_t check[] = "123456789";
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, Telemetry_Crc16(check, 9, 0xFFFF));
+}
+
+// ==================== Round-Trip Tests ====================
+
+void test_TelemetryEncode_RecordWithZeros_RoundTrips(void) {
+    const uint8_t payload[] = {0x00, 0x11, 0x00, 0x00, 0x22, 0x33, 0x00};
+
+    size_t length = Telemetry_Encode(TELEMETRY_TYPE_PEDAL_NODE, 7, payload, sizeof(payload), frame, sizeof(frame));
+    TEST_ASSERT_TRUE(length <= TELEMETRY_FRAME_SIZE(sizeof(payload)));
+    assert_single_delimiter(length);
+
+    TEST_ASSERT_EQUAL(PLT_OK, Telemetry_Decode(frame, length, &record));
+    TEST_ASSERT_EQUAL(TELEMETRY_TYPE_PEDAL_NODE, record.type);
+    TEST_ASSERT_EQUAL(7, record.seq);
+    TEST_ASSERT_EQUAL(sizeof(payload), record.length);
+    TEST_ASSERT_EQUAL_MEMORY(payload, record.data, sizeof(payload));
+}
+
+void test_TelemetryEncode_EmptyPayload_RoundTrips(void) {
+    size_t length = Telemetry_Encode(TELEMETRY_TYPE_USER, 0, NULL, 0, frame, sizeof(frame));
+    assert_single_delimiter(length);
+
+    TEST_ASSERT_EQUAL(PLT_OK, Telemetry_Decode(frame, length, &record));
+    TEST_ASSERT_EQUAL(TELEMETRY_TYPE_USER, record.type);
+    TEST_ASSERT_EQUAL(0, record.length);
+}
+
+void test_TelemetryEncode_LongNonZeroRuns_RoundTrip(void) {
+    // Lengths around the 254-byte COBS block boundary
+    static uint8_t payload[TELEMETRY_MAX_PAYLOAD];
+    for (size_t i = 0; i < sizeof(payload); i++) {
+        payload[i] = (uint8_t)(i % 255 + 1);
+    }
+
+    for (size_t n = 240; n <= TELEMETRY_MAX_PAYLOAD; n++) {
+        size_t length = Telemetry_Encode(0x42, (uint8_t)n, payload, n, frame, sizeof(frame));
+        TEST_ASSERT_TRUE(length <= TELEMETRY_FRAME_SIZE(n));
+        assert_single_delimiter(length);
+        TEST_ASSERT_EQUAL(PLT_OK, Telemetry_Decode(frame, length, &record));
+        TEST_ASSERT_EQUAL(n, record.length);
+        TEST_ASSERT_EQUAL_MEMORY(payload, record.data, n);
+    }
+}
+
+// ==================== Error Tests ====================
+
+void test_TelemetryEncode_BadArguments_ReturnZero(void) {
+    uint8_t payload[4] = {1, 2, 3, 4};
+    TEST_ASSERT_EQUAL(0, Telemetry_Encode(1, 0, payload, sizeof(payload), NULL, sizeof(frame)));
+    TEST_ASSERT_EQUAL(0, Telemetry_Encode(1, 0, NULL, 4, frame, sizeof(frame)));
+    TEST_ASSERT_EQUAL(0, Telemetry_Encode(1, 0, payload, TELEMETRY_MAX_PAYLOAD + 1, frame, sizeof(frame)));
+    TEST_ASSERT_EQUAL(0, Telemetry_Encode(1, 0, payload, sizeof(payload), frame, 6));
+}
+
+void test_TelemetryDecode_CorruptedByte_ReturnsCrcError(void) {
+    const uint8_t payload[] = {10, 20, 30, 40, 50};
+    size_t length = Telemetry_Encode(1, 1, payload, sizeof(payload), frame, sizeof(frame));
+
+    frame[3] ^= 0x01;
+    TEST_ASSERT_EQUAL(PLT_CRC_ERROR, Telemetry_Decode(frame, length, &record));
+}
+
+void test_TelemetryDecode_MalformedFrames_ReturnInvalidParam(void) {
+    const uint8_t truncated[] = {0x05, 0x01, 0x02};
+    const uint8_t embedded_zero[] = {0x04, 0x01, 0x00, 0x02, 0x00};
+    const uint8_t too_short[] = {0x02, 0x01, 0x00};
+
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, Telemetry_Decode(truncated, sizeof(truncated), &record));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, Telemetry_Decode(embedded_zero, sizeof(embedded_zero), &record));
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, Telemetry_Decode(too_short, sizeof(too_short), &record));
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, Telemetry_Decode(NULL, 4, &record));
+}
+
+// ==================== Main ====================
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // CRC tests
+    RUN_TEST(test_TelemetryCrc16_CheckValue_MatchesCcittFalse);
+
+    // Round-trip tests
+    RUN_TEST(test_TelemetryEncode_RecordWithZeros_RoundTrips);
+    RUN_TEST(test_TelemetryEncode_EmptyPayload_RoundTrips);
+    RUN_TEST(test_TelemetryEncode_LongNonZeroRuns_RoundTrip);
+
+    // Error tests
+    RUN_TEST(test_TelemetryEncode_BadArguments_ReturnZero);
+    RUN_TEST(test_TelemetryDecode_CorruptedByte_ReturnsCrcError);
+    RUN_TEST(test_TelemetryDecode_MalformedFrames_ReturnInvalidParam);
+
+    return UNITY_END();
+}
@@ -0,0 +1,187 @@
+#include "unity.h"
+#include "stm32_platform.h"
+#include <string.h>
+
+// Built with the whole library and PLT_ENABLE_STATS=1 (see tests/CMakeLists.txt)
+
+static DMA_Stream_TypeDef rx_stream;
+static DMA_HandleTypeDef hdma_rx = { .Instance = &rx_stream, .Init = { .Mode = DMA_CIRCULAR } };
+static UART_HandleTypeDef huart = { .Instance = USART1, .hdmarx = &hdma_rx };
+static uint8_t* ring;
+
+void setUp(void) {
+    void* uart_handles[] = { &huart };
+    PlatformHandles_t handles = { .huart = uart_handles, .uart_count = 1 };
+
+    Mock_HAL_Reset();
+    huart.ErrorCode = HAL_UART_ERROR_NONE;
+    Platform.begin(&handles);
+    ring = Mock_UART_GetRxDmaBuffer();
+}
+
+void tearDown(void) {
+    // Nothing to clean up
+}
+
+static void dma_write(uint16_t pos, const char* bytes) {
+    memcpy(&ring[pos], bytes, strlen(bytes));
+}
+
+// The HAL stops reception (RxState READY) on blocking errors before the callback
+static void uart_error(uint32_t code, bool rx_stopped) {
+    huart.ErrorCode = code;
+    if (rx_stopped) {
+        huart.RxState = HAL_UART_STATE_READY;
+    }
+    HAL_UART_ErrorCallback(&huart);
+}
+
+static uint32_t rx_overruns(void) {
+    PlatformStats_t stats;
+    TEST_ASSERT_TRUE(Platform.getStats(&stats));
+    return stats.uart[0].rx.drops;
+}
+
+// ==================== DMA Ring Tests ====================
+
+void test_UARTDmaRx_StartsCircularReception(void) {
+    TEST_ASSERT_NOT_NULL(ring);
+    TEST_ASSERT_EQUAL(0, P_UART.availableBytes(0));
+}
+
+void test_UARTDmaRx_RxEvents_ReadInOrderAcrossWrap(void) {
+    uint8_t buffer[16];
+
+    // Leave the ring 4 bytes short of its end, then wrap
+    dma_write(0, "abc");
+    HAL_UARTEx_RxEventCallback(&huart, 3);
+    TEST_ASSERT_EQUAL(3, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    memset(ring, '-', 252);
+    HAL_UARTEx_RxEventCallback(&huart, 252);
+    TEST_ASSERT_EQUAL(249, P_UART.availableBytes(0));
+    for (int i = 0; i < 249; i++) {
+        P_UART.read(0);
+    }
+
+    dma_write(252, "wxyz");
+    dma_write(0, "12");
+    HAL_UARTEx_RxEventCallback(&huart, 2);
+    TEST_ASSERT_EQUAL(6, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("wxyz12", buffer, 6);
+}
+
+void test_UARTDmaRx_NoiseError_KeepsRingRunning(void) {
+    uint8_t buffer[16];
+    uint8_t* armed = ring;
+
+    dma_write(0, "hello");
+    HAL_UARTEx_RxEventCallback(&huart, 5);
+    TEST_ASSERT_EQUAL('h', P_UART.read(0));
+
+    // Framing/noise errors leave circular DMA running: nothing is dropped or re-armed
+    uart_error(HAL_UART_ERROR_FE | HAL_UART_ERROR_NE, false);
+    TEST_ASSERT_EQUAL(4, P_UART.availableBytes(0));
+    TEST_ASSERT_EQUAL(0, rx_overruns());
+
+    dma_write(5, "!");
+    HAL_UARTEx_RxEventCallback(&huart, 6);
+    TEST_ASSERT_EQUAL(5, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("ello!", buffer, 5);
+    TEST_ASSERT_EQUAL_PTR(armed, ring);
+    TEST_ASSERT_EQUAL(PLT_OK, Platform.getLastError());
+}
+
+void test_UARTDmaRx_ErrorRestart_ReadsRestartedRing(void) {
+    uint8_t buffer[16];
+
+    dma_write(0, "hello");
+    HAL_UARTEx_RxEventCallback(&huart, 5);
+    TEST_ASSERT_EQUAL('h', P_UART.read(0));
+    TEST_ASSERT_EQUAL('e', P_UART.read(0));
+
+    // Overrun stops reception, which restarts at ring position 0; "llo" is abandoned
+    uart_error(HAL_UART_ERROR_ORE, true);
+    TEST_ASSERT_EQUAL(0, P_UART.availableBytes(0));
+    TEST_ASSERT_EQUAL(3, rx_overruns());
+
+    dma_write(0, "new");
+    HAL_UARTEx_RxEventCallback(&huart, 3);
+    TEST_ASSERT_EQUAL(3, P_UART.availableBytes(0));
+    TEST_ASSERT_EQUAL(3, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("new", buffer, 3);
+    TEST_ASSERT_EQUAL(0, P_UART.availableBytes(0));
+}
+
+void test_UARTDmaRx_ErrorOnRingBoundary_KeepsAlignment(void) {
+    uint8_t buffer[16];
+
+    // Error with nothing pending: counters are already on a boundary
+    uart_error(HAL_UART_ERROR_DMA, false);
+    TEST_ASSERT_EQUAL(0, rx_overruns());
+
+    dma_write(0, "ok");
+    HAL_UARTEx_RxEventCallback(&huart, 2);
+    TEST_ASSERT_EQUAL(2, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("ok", buffer, 2);
+
+    // A second error mid-ring resyncs again
+    uart_error(HAL_UART_ERROR_FE, true);
+    dma_write(0, "again");
+    HAL_UARTEx_RxEventCallback(&huart, 5);
+    TEST_ASSERT_EQUAL(5, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("again", buffer, 5);
+    TEST_ASSERT_EQUAL(0, rx_overruns());
+}
+
+void test_UARTDmaRx_ErrorBetweenPendingAndRead_ReadsNewDataOnly(void) {
+    uint8_t buffer[16];
+
+    dma_write(0, "stale");
+    HAL_UARTEx_RxEventCallback(&huart, 5);
+    TEST_ASSERT_EQUAL(5, P_UART.availableBytes(0));
+
+    // Restart lands after the reader saw the old count, then new data arrives
+    uart_error(HAL_UART_ERROR_ORE, true);
+    dma_write(0, "new");
+    HAL_UARTEx_RxEventCallback(&huart, 3);
+
+    TEST_ASSERT_EQUAL(3, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("new", buffer, 3);
+    TEST_ASSERT_EQUAL(0, P_UART.availableBytes(0));
+    TEST_ASSERT_EQUAL(5, rx_overruns());
+}
+
+void test_UARTDmaRx_RepeatedRestartsBeforeRead_CountOnlyReceivedBytes(void) {
+    uint8_t buffer[16];
+
+    dma_write(0, "abcd");
+    HAL_UARTEx_RxEventCallback(&huart, 4);
+    uart_error(HAL_UART_ERROR_ORE, true);
+    dma_write(0, "ef");
+    HAL_UARTEx_RxEventCallback(&huart, 2);
+    uart_error(HAL_UART_ERROR_ORE, true);
+    dma_write(0, "xyz");
+    HAL_UARTEx_RxEventCallback(&huart, 3);
+
+    // Skipped ring slots are not bytes: only "abcd" and "ef" were lost
+    TEST_ASSERT_EQUAL(3, P_UART.readBytes(0, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_MEMORY("xyz", buffer, 3);
+    TEST_ASSERT_EQUAL(6, rx_overruns());
+}
+
+// ==================== Main ====================
+
+int main(void) {
+    UNITY_BEGIN();
+
+    // DMA ring tests
+    RUN_TEST(test_UARTDmaRx_StartsCircularReception);
+    RUN_TEST(test_UARTDmaRx_RxEvents_ReadInOrderAcrossWrap);
+    RUN_TEST(test_UARTDmaRx_NoiseError_KeepsRingRunning);
+    RUN_TEST(test_UARTDmaRx_ErrorRestart_ReadsRestartedRing);
+    RUN_TEST(test_UARTDmaRx_ErrorOnRingBoundary_KeepsAlignment);
+    RUN_TEST(test_UARTDmaRx_ErrorBetweenPendingAndRead_ReadsNewDataOnly);
+    RUN_TEST(test_UARTDmaRx_RepeatedRestartsBeforeRead_CountOnlyReceivedBytes);
+
+    return UNITY_END();
+}
@@ -2,6 +2,7 @@
 #include "utils.h"
 #include <string.h>
 #include <stdlib.h>
+#include <stdio.h>
 
 // Test data structure
 typedef struct {
@@ -242,6 +243,374 @@ void test_QueueIntegration_PushPopCycle_WorksCorrectly(void) {
     TEST_ASSERT_EQUAL(10, data.value);
 }
 
+// ==================== SPSC Mode Tests ====================
+
+void test_QueueInitSPSC_PowerOfTwo_InitializesCorrectly(void) {
+    plt_status_t status = Queue_InitSPSC(&test_queue, sizeof(test_data_t), 8);
+    
+    TEST_ASSERT_EQUAL(PLT_OK, status);
+    TEST_ASSERT_NOT_NULL(test_queue.buffer);
+    TEST_ASSERT_EQUAL(QUEUE_MODE_SPSC, test_queue.mode);
+    TEST_ASSERT_EQUAL(8, test_queue.capacity);
+    TEST_ASSERT_EQUAL(7, test_queue.mask);
+}
+
+void test_QueueInitSPSC_NotPowerOfTwo_ReturnsInvalidParam(void) {
+    plt_status_t status = Queue_InitSPSC(&test_queue, sizeof(test_data_t), 6);
+    
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, status);
+    TEST_ASSERT_NULL(test_queue.buffer);
+}
+
+void test_QueueSPSC_FillToCapacity_ThenFull(void) {
+    Queue_InitSPSC(&test_queue, sizeof(test_data_t), 4);
+    
+    for (uint32_t i = 0; i < 4; i++) {
+        test_data_t data = {.value = i};
+        TEST_ASSERT_EQUAL(PLT_OK, Queue_Push(&test_queue, &data));
+    }
+    
+    test_data_t extra = {.value = 99};
+    TEST_ASSERT_EQUAL(PLT_QUEUE_FULL, Queue_Push(&test_queue, &extra));
+    TEST_ASSERT_TRUE(Queue_IsFull(&test_queue));
+    TEST_ASSERT_EQUAL(4, Queue_Count(&test_queue));
+}
+
+void test_QueueSPSC_FIFO_OrderAcrossWrap(void) {
+    Queue_InitSPSC(&test_queue, sizeof(test_data_t), 4);
+    
+    // Run several laps so head/tail wrap the mask many times
+    uint32_t next_push = 0;
+    uint32_t next_pop = 0;
+    for (int lap = 0; lap < 10; lap++) {
+        for (int i = 0; i < 3; i++) {
+            test_data_t data = {.value = next_push++};
+            TEST_ASSERT_EQUAL(PLT_OK, Queue_Push(&test_queue, &data));
+        }
+        for (int i = 0; i < 3; i++) {
+            test_data_t data;
+            TEST_ASSERT_EQUAL(PLT_OK, Queue_Pop(&test_queue, &data));
+            TEST_ASSERT_EQUAL(next_pop++, data.value);
+        }
+    }
+    
+    TEST_ASSERT_TRUE(Queue_IsEmpty(&test_queue));
+    TEST_ASSERT_EQUAL(PLT_QUEUE_EMPTY, Queue_Pop(&test_queue, NULL));
+}
+
+void test_QueueSPSC_PeekDoesNotConsume(void) {
+    Queue_InitSPSC(&test_queue, sizeof(test_data_t), 2);
+    
+    test_data_t data = {.value = 7};
+    Queue_Push(&test_queue, &data);
+    
+    test_data_t peeked;
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_Peek(&test_queue, &peeked));
+    TEST_ASSERT_EQUAL(7, peeked.value);
+    TEST_ASSERT_EQUAL(1, Queue_Count(&test_queue));
+}
+
+// ==================== Static Storage Tests ====================
+
+QUEUE_DEFINE(defined_queue, test_data_t, 4);
+QUEUE_DEFINE_SPSC(defined_spsc_queue, test_data_t, 8);
+
+void test_QueueInitStatic_UsesProvidedBuffer(void) {
+    static test_data_t storage[4];
+    plt_status_t status = Queue_InitStatic(&test_queue, storage, sizeof(test_data_t), 4, QUEUE_MODE_LOCKED);
+    
+    TEST_ASSERT_EQUAL(PLT_OK, status);
+    TEST_ASSERT_EQUAL_PTR(storage, test_queue.buffer);
+    TEST_ASSERT_FALSE(test_queue.owns_buffer);
+    
+    test_data_t data = {.value = 5};
+    Queue_Push(&test_queue, &data);
+    TEST_ASSERT_EQUAL(5, storage[0].value);
+}
+
+void test_QueueInitStatic_NullBuffer_ReturnsNullPointer(void) {
+    plt_status_t status = Queue_InitStatic(&test_queue, NULL, sizeof(test_data_t), 4, QUEUE_MODE_LOCKED);
+    
+    TEST_ASSERT_EQUAL(PLT_NULL_POINTER, status);
+}
+
+void test_QueueInitStatic_SPSCNotPowerOfTwo_ReturnsInvalidParam(void) {
+    static test_data_t storage[6];
+    plt_status_t status = Queue_InitStatic(&test_queue, storage, sizeof(test_data_t), 6, QUEUE_MODE_SPSC);
+    
+    TEST_ASSERT_EQUAL(PLT_INVALID_PARAM, status);
+}
+
+void test_QueueFree_StaticBuffer_DetachesWithoutFree(void) {
+    static test_data_t storage[2];
+    Queue_InitStatic(&test_queue, storage, sizeof(test_data_t), 2, QUEUE_MODE_LOCKED);
+    
+    Queue_Free(&test_queue); // Must not call free() on .bss storage
+    
+    TEST_ASSERT_NULL(test_queue.buffer);
+}
+
+void test_QueueDefine_UsableWithoutInit(void) {
+    test_data_t data = {.value = 11};
+    test_data_t popped;
+    
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_Push(&defined_queue, &data));
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_Pop(&defined_queue, &popped));
+    TEST_ASSERT_EQUAL(11, popped.value);
+    
+    TEST_ASSERT_EQUAL(QUEUE_MODE_SPSC, defined_spsc_queue.mode);
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_Push(&defined_spsc_queue, &data));
+    TEST_ASSERT_EQUAL(1, Queue_Count(&defined_spsc_queue));
+}
+
+// ==================== Batch Tests ====================
+
+static void fill_sequence(test_data_t* items, size_t n, uint32_t first) {
+    for (size_t i = 0; i < n; i++) {
+        items[i].value = first + (uint32_t)i;
+    }
+}
+
+void test_QueuePushBatch_PartialWhenFull(void) {
+    Queue_Init(&test_queue, sizeof(test_data_t), 4);
+    
+    test_data_t items[6];
+    fill_sequence(items, 6, 0);
+    
+    TEST_ASSERT_EQUAL(4, Queue_PushBatch(&test_queue, items, 6));
+    TEST_ASSERT_TRUE(Queue_IsFull(&test_queue));
+    TEST_ASSERT_EQUAL(0, Queue_PushBatch(&test_queue, items, 1));
+}
+
+void test_QueuePopBatch_AcrossWrap_PreservesOrder(void) {
+    const QueueMode_t modes[2] = {QUEUE_MODE_LOCKED, QUEUE_MODE_SPSC};
+    
+    for (int m = 0; m < 2; m++) {
+        static test_data_t storage[4];
+        Queue_InitStatic(&test_queue, storage, sizeof(test_data_t), 4, modes[m]);
+        
+        test_data_t items[4];
+        fill_sequence(items, 3, 0);
+        Queue_PushBatch(&test_queue, items, 3);
+        TEST_ASSERT_EQUAL(2, Queue_PopBatch(&test_queue, items, 2));
+        
+        // Head is now at slot 3, so this batch wraps
+        fill_sequence(items, 3, 3);
+        TEST_ASSERT_EQUAL(3, Queue_PushBatch(&test_queue, items, 3));
+        
+        test_data_t out[4];
+        TEST_ASSERT_EQUAL(4, Queue_PopBatch(&test_queue, out, 4));
+        for (uint32_t i = 0; i < 4; i++) {
+            TEST_ASSERT_EQUAL(2 + i, out[i].value);
+        }
+        TEST_ASSERT_TRUE(Queue_IsEmpty(&test_queue));
+    }
+}
+
+void test_QueuePeekBatch_WrappedRun_ReturnsTwoSpans(void) {
+    Queue_InitSPSC(&test_queue, sizeof(test_data_t), 4);
+    
+    test_data_t items[4];
+    fill_sequence(items, 3, 0);
+    Queue_PushBatch(&test_queue, items, 3);
+    Queue_PopBatch(&test_queue, items, 3);
+    fill_sequence(items, 3, 10);
+    Queue_PushBatch(&test_queue, items, 3);
+    
+    Queue_Span_t spans[2];
+    size_t n = Queue_PeekBatch(&test_queue, spans, 0);
+    
+    TEST_ASSERT_EQUAL(3, n);
+    TEST_ASSERT_EQUAL(1, spans[0].count);
+    TEST_ASSERT_EQUAL(2, spans[1].count);
+    TEST_ASSERT_EQUAL(10, ((test_data_t*)spans[0].data)[0].value);
+    TEST_ASSERT_EQUAL(11, ((test_data_t*)spans[1].data)[0].value);
+    TEST_ASSERT_EQUAL(12, ((test_data_t*)spans[1].data)[1].value);
+    
+    // Peek does not consume
+    TEST_ASSERT_EQUAL(3, Queue_Count(&test_queue));
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_Release(&test_queue, n));
+    TEST_ASSERT_TRUE(Queue_IsEmpty(&test_queue));
+}
+
+void test_QueuePeekBatch_RespectsMax(void) {
+    Queue_Init(&test_queue, sizeof(test_data_t), 8);
+    
+    test_data_t items[5];
+    fill_sequence(items, 5, 0);
+    Queue_PushBatch(&test_queue, items, 5);
+    
+    Queue_Span_t spans[2];
+    TEST_ASSERT_EQUAL(2, Queue_PeekBatch(&test_queue, spans, 2));
+    TEST_ASSERT_EQUAL(2, spans[0].count);
+    TEST_ASSERT_EQUAL(0, spans[1].count);
+}
+
+void test_QueueRelease_MoreThanPending_ReturnsUnderflow(void) {
+    Queue_Init(&test_queue, sizeof(test_data_t), 4);
+    
+    test_data_t data = {.value = 1};
+    Queue_Push(&test_queue, &data);
+    
+    TEST_ASSERT_EQUAL(PLT_UNDERFLOW, Queue_Release(&test_queue, 2));
+    TEST_ASSERT_EQUAL(1, Queue_Count(&test_queue));
+}
+
+// ==================== Zero-Copy Slot Tests ====================
+
+void test_QueueReserveCommit_WritesInPlace(void) {
+    Queue_InitSPSC(&test_queue, sizeof(test_data_t), 2);
+    
+    test_data_t* slot = (test_data_t*)Queue_Reserve(&test_queue);
+    TEST_ASSERT_NOT_NULL(slot);
+    slot->value = 123;
+    
+    // Not visible until committed
+    TEST_ASSERT_EQUAL(0, Queue_Count(&test_queue));
+    TEST_ASSERT_EQUAL(PLT_OK, Queue_Commit(&test_queue));
+    TEST_ASSERT_EQUAL(1, Queue_Count(&test_queue));
+    
+    test_data_t popped;
+    Queue_Pop(&test_queue, &popped);
+    TEST_ASSERT_EQUAL(123, popped.value);
+}
+
+void test_QueueReserve_WhenFull_ReturnsNull(void) {
+    Queue_Init(&test_queue, sizeof(test_data_t), 1);
+    
+    test_data_t data = {.value = 1};
+    Queue_Push(&test_queue, &data);
+    
+    TEST_ASSERT_NULL(Queue_Reserve(&test_queue));
+    TEST_ASSERT_EQUAL(PLT_QUEUE_FULL, Queue_Commit(&test_queue));
+}
+
+void test_QueuePeekSlot_ReadsInPlaceUntilReleased(void) {
+    const QueueMode_t modes[2] = {QUEUE_MODE_LOCKED, QUEUE_MODE_SPSC};
+    
+    for (int m = 0; m < 2; m++) {
+        static test_data_t storage[2];
+        Queue_InitStatic(&test_queue, storage, sizeof(test_data_t), 2, modes[m]);
+        TEST_ASSERT_NULL(Queue_PeekSlot(&test_queue));
+        
+        test_data_t data = {.value = 40};
+        Queue_Push(&test_queue, &data);
+        data.value = 41;
+        Queue_Push(&test_queue, &data);
+        
+        test_data_t* slot = (test_data_t*)Queue_PeekSlot(&test_queue);
+        TEST_ASSERT_EQUAL_PTR(&storage[0], slot);
+        TEST_ASSERT_EQUAL(40, slot->value);
+        
+        Queue_Release(&test_queue, 1);
+        slot = (test_data_t*)Queue_PeekSlot(&test_queue);
+        TEST_ASSERT_EQUAL(41, slot->value);
+        Queue_Release(&test_queue, 1);
+        TEST_ASSERT_NULL(Queue_PeekSlot(&test_queue));
+    }
+}
+
+// ==================== Formatter Tests ====================
+
+typedef struct {
+    char text[512];
+    size_t length;
+    int calls;
+} format_capture_t;
+
+static void capture_sink(void* context, const char* data, size_t length) {
+    format_capture_t* cap = (format_capture_t*)context;
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_TRUE(cap->length + length < sizeof(cap->text));
+    memcpy(&cap->text[cap->length], data, length);
+    cap->length += length;
+    cap->text[cap->length] = '\0';
+    cap->calls++;
+}
+
+// Format with both plt_format and snprintf and require identical output
+#define ASSERT_FORMAT_MATCHES(...) do {                                    \
+        format_capture_t cap = {{0}, 0, 0};                                \
+        char expected[512];                                                \
+        int expected_len = snprintf(expected, sizeof(expected), __VA_ARGS__); \
+        TEST_ASSERT_EQUAL(expected_len, plt_format(capture_sink, &cap, __VA_ARGS__)); \
+        TEST_ASSERT_EQUAL_STRING(expected, cap.text);                      \
+    } while (0)
+
+void test_PltFormat_Integers_MatchSnprintf(void) {
+    ASSERT_FORMAT_MATCHES("%d %i %u", -42, 0, 4000000000u);
+    ASSERT_FORMAT_MATCHES("[%5d|%-5d|%05d|%+d|% d]", 42, 42, -42, 7, 7);
+    ASSERT_FORMAT_MATCHES("[%.3d|%8.3d|%.0d]", 5, -5, 0);
+    ASSERT_FORMAT_MATCHES("%x %X %#x %#o %o", 0xBEEFu, 0xBEEFu, 255u, 8u, 0u);
+    ASSERT_FORMAT_MATCHES("%ld %lu %lld %llx", -123456789L, 123456789UL, -9000000000LL, 0x123456789ABCULL);
+    ASSERT_FORMAT_MATCHES("%hd %hhu %zu", (short)-2, (unsigned char)200, (size_t)77);
+    ASSERT_FORMAT_MATCHES("%lld", (long long)INT64_MIN);
+    ASSERT_FORMAT_MATCHES("[%*d|%-*d|%.*d]", 6, 1, 4, 2, 3, 3);
+}
+
+void test_PltFormat_StringsAndChars_MatchSnprintf(void) {
+    ASSERT_FORMAT_MATCHES("%s|%10s|%-10s|%.3s", "abc", "right", "left", "truncate");
+    ASSERT_FORMAT_MATCHES("%c%c%3c %%", 'o', 'k', '!');
+    ASSERT_FORMAT_MATCHES("no conversions at all");
+}
+
+void test_PltFormat_Floats_MatchSnprintf(void) {
+    ASSERT_FORMAT_MATCHES("%f %f %f", 3.14159, -2.5, 0.0);
+    ASSERT_FORMAT_MATCHES("%.2f %.0f %.9f", 1.005, 3.7, 0.123456789);
+    ASSERT_FORMAT_MATCHES("[%8.3f|%-8.1f|%08.2f|%+.1f]", 3.14159, 2.0, -1.5, 9.95);
+    ASSERT_FORMAT_MATCHES("%.3f", 0.9996);
+    ASSERT_FORMAT_MATCHES("%.1f", 123456789012.27);
+}
+
+void test_PltFormat_Exponent_MatchSnprintf(void) {
+    ASSERT_FORMAT_MATCHES("%e %E %e", 1234.5678, -0.000123, 0.0);
+    ASSERT_FORMAT_MATCHES("[%.3e|%12.2e|%-12.1E|%+e|%#.0e]", 6.02214e23, 1.6e-19, 9.96, 1.0, 5.0);
+    ASSERT_FORMAT_MATCHES("%e %e", 9.9999999, 1e-300);
+    ASSERT_FORMAT_MATCHES("%g %g %g %g %g", 100000.0, 1000000.0, 0.0001, 0.00001, 0.0);
+    ASSERT_FORMAT_MATCHES("[%G|%.3g|%10.4g|%#g|%g]", 1.5e-10, 3.14159, 2.5, 1.0, 123.456);
+    ASSERT_FORMAT_MATCHES("%g %F", 9.9999996, 2.25);
+}
+
+void test_PltFormat_FloatBeforeInteger_KeepsArgumentsAligned(void) {
+    ASSERT_FORMAT_MATCHES("%e %d", 2.5, 42);
+    ASSERT_FORMAT_MATCHES("%g|%s|%d", 0.5, "ok", -7);
+    ASSERT_FORMAT_MATCHES("%jd %tu %d", (intmax_t)-5, (ptrdiff_t)6, 7);
+}
+
+void test_PltFormat_UnknownConversion_StopsOutput(void) {
+    format_capture_t cap = {{0}, 0, 0};
+    int written = 0;
+    TEST_ASSERT_EQUAL(6, plt_format(capture_sink, &cap, "a=%d %n b=%d", 1, &written, 2));
+    TEST_ASSERT_EQUAL_STRING("a=1 %n", cap.text);
+    TEST_ASSERT_EQUAL(0, written);
+}
+
+void test_PltFormat_LongOutput_NotTruncated(void) {
+    char long_text[300];
+    memset(long_text, 'x', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+
+    format_capture_t cap = {{0}, 0, 0};
+    TEST_ASSERT_EQUAL(309, plt_format(capture_sink, &cap, "<%s>%08d", long_text, 1));
+    TEST_ASSERT_EQUAL(309, cap.length);
+    TEST_ASSERT_EQUAL('x', cap.text[299]);
+    TEST_ASSERT_EQUAL('>', cap.text[300]);
+}
+
+void test_PltFormat_LiteralRuns_EmittedInOneCall(void) {
+    format_capture_t cap = {{0}, 0, 0};
+    plt_format(capture_sink, &cap, "speed=%d rpm", 1200);
+    TEST_ASSERT_EQUAL_STRING("speed=1200 rpm", cap.text);
+    TEST_ASSERT_EQUAL(3, cap.calls);
+}
+
+void test_PltFormat_NullArguments_ReturnError(void) {
+    format_capture_t cap = {{0}, 0, 0};
+    TEST_ASSERT_EQUAL(-1, plt_format(NULL, &cap, "x"));
+    TEST_ASSERT_EQUAL(-1, plt_format(capture_sink, &cap, NULL));
+    TEST_ASSERT_EQUAL(0, cap.calls);
+}
+
 // ==================== Main ====================
 
 int main(void) {
@@ -273,5 +642,42 @@ int main(void) {
     // Integration tests
     RUN_TEST(test_QueueIntegration_PushPopCycle_WorksCorrectly);
     
+    // SPSC mode tests
+    RUN_TEST(test_QueueInitSPSC_PowerOfTwo_InitializesCorrectly);
+    RUN_TEST(test_QueueInitSPSC_NotPowerOfTwo_ReturnsInvalidParam);
+    RUN_TEST(test_QueueSPSC_FillToCapacity_ThenFull);
+    RUN_TEST(test_QueueSPSC_FIFO_OrderAcrossWrap);
+    RUN_TEST(test_QueueSPSC_PeekDoesNotConsume);
+    
+    // Static storage tests
+    RUN_TEST(test_QueueInitStatic_UsesProvidedBuffer);
+    RUN_TEST(test_QueueInitStatic_NullBuffer_ReturnsNullPointer);
+    RUN_TEST(test_QueueInitStatic_SPSCNotPowerOfTwo_ReturnsInvalidParam);
+    RUN_TEST(test_QueueFree_StaticBuffer_DetachesWithoutFree);
+    RUN_TEST(test_QueueDefine_UsableWithoutInit);
+    
+    // Batch tests
+    RUN_TEST(test_QueuePushBatch_PartialWhenFull);
+    RUN_TEST(test_QueuePopBatch_AcrossWrap_PreservesOrder);
+    RUN_TEST(test_QueuePeekBatch_WrappedRun_ReturnsTwoSpans);
+    RUN_TEST(test_QueuePeekBatch_RespectsMax);
+    RUN_TEST(test_QueueRelease_MoreThanPending_ReturnsUnderflow);
+    
+    // Zero-copy slot tests
+    RUN_TEST(test_QueueReserveCommit_WritesInPlace);
+    RUN_TEST(test_QueueReserve_WhenFull_ReturnsNull);
+    RUN_TEST(test_QueuePeekSlot_ReadsInPlaceUntilReleased);
+    
+    // Formatter tests
+    RUN_TEST(test_PltFormat_Integers_MatchSnprintf);
+    RUN_TEST(test_PltFormat_StringsAndChars_MatchSnprintf);
+    RUN_TEST(test_PltFormat_Floats_MatchSnprintf);
+    RUN_TEST(test_PltFormat_Exponent_MatchSnprintf);
+    RUN_TEST(test_PltFormat_FloatBeforeInteger_KeepsArgumentsAligned);
+    RUN_TEST(test_PltFormat_UnknownConversion_StopsOutput);
+    RUN_TEST(test_PltFormat_LongOutput_NotTruncated);
+    RUN_TEST(test_PltFormat_LiteralRuns_EmittedInOneCall);
+    RUN_TEST(test_PltFormat_NullArguments_ReturnError);
+    
     return UNITY_END();
 }
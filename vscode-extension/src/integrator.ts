@@ -57,8 +57,14 @@ export async function integratePlatform(
       "platform_status.h",
       "utils.h",
       "hashtable.h",
+      "can_filter.h",
+      "telemetry.h",
+      "adc_filter.h",
+      "stats.h",
+      "can_trace.h",
       "database.h",
       "DbSetFunctions.h",
+      "DbSignals.h",
     ];
 
     const coreSrcFiles = [
@@ -66,6 +72,11 @@ export async function integratePlatform(
       "platform_status.c",
       "utils.c",
       "hashtable.c",
+      "can_filter.c",
+      "telemetry.c",
+      "adc_filter.c",
+      "stats.c",
+      "can_trace.c",
       "database.c",
       "DbSetFunctions.c",
     ];